@@ -0,0 +1,498 @@
+﻿#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <memory_resource>
+#include <new>
+#include <stdexcept>
+
+#include "Memory.h"
+
+#if defined(__SANITIZE_ADDRESS__)
+#define SIMPLESTL_ASAN
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer)
+#define SIMPLESTL_ASAN
+#endif
+#endif
+
+#ifdef SIMPLESTL_ASAN
+#include <sanitizer/asan_interface.h>
+#endif
+
+// Memory resources for the allocator parameter of every growing container, from TVector and the node containers to the heaps, TSmallVector and the flat, B-tree and concurrent tables
+// TArray and TStaticVector never allocate, TConcurrentQueue and TRingBuffer allocate their slots once on construction, and TWorkStealingDeque only grows a few times for the life of a pool, so they have no allocator parameter
+// Bind a container to one by giving it a std::pmr::polymorphic_allocator at construction, for example TList<int, std::pmr::polymorphic_allocator<int>> list(&pool)
+// sstl::object_pool backs TUnique::createIn with a free list of slots for a single type
+// None of these are thread safe, use one per thread or guard it like any other container
+namespace sstl {
+
+	// Hands out fixed size blocks from a free list per size class, carving new blocks out of chunks taken from upstream
+	// A freed block goes back on its free list instead of to upstream, so insert and erase churn on a node container never reaches malloc
+	// Blocks larger than maxBlockSize, such as the bucket arrays of hash tables, go straight to upstream
+	struct pool_resource : std::pmr::memory_resource {
+
+		constexpr static size_t granularity = alignof(std::max_align_t);
+		constexpr static size_t maxBlockSize = 512;
+
+		explicit pool_resource(const size_t blocksPerChunk = 64, std::pmr::memory_resource* upstream = std::pmr::get_default_resource())
+		: m_BlocksPerChunk(std::max<size_t>(1, blocksPerChunk)),
+		  m_Upstream(upstream) {}
+
+		// Blocks point into the chunks, so a pool cannot be copied or moved
+		pool_resource(const pool_resource&) = delete;
+		pool_resource& operator=(const pool_resource&) = delete;
+
+		~pool_resource() override {
+			release();
+		}
+
+		// Gives every chunk back to upstream, every block handed out is invalid after this
+		void release() {
+			while (m_Chunks) {
+				chunk* next = m_Chunks->next;
+				m_Upstream->deallocate(m_Chunks, m_Chunks->size, granularity);
+				m_Chunks = next;
+			}
+			m_Free.fill(nullptr);
+		}
+
+		[[nodiscard]] size_t getChunkCount() const {
+			size_t amt = 0;
+			for (const chunk* itr = m_Chunks; itr; itr = itr->next) {
+				++amt;
+			}
+			return amt;
+		}
+
+		[[nodiscard]] std::pmr::memory_resource* getUpstream() const {
+			return m_Upstream;
+		}
+
+	protected:
+
+		struct block {
+			block* next;
+		};
+
+		// Sits at the start of every chunk, the blocks follow it
+		struct chunk {
+			chunk* next;
+			size_t size;
+		};
+
+		static_assert(sizeof(chunk) <= granularity, "Chunk header must fit before the first block!");
+
+		void* do_allocate(const size_t bytes, const size_t alignment) override {
+			if (bytes > maxBlockSize || alignment > granularity) {
+				return m_Upstream->allocate(bytes, alignment);
+			}
+			const size_t index = sizeClass(bytes);
+			if (!m_Free[index]) {
+				refill(index);
+			}
+			block* obj = m_Free[index];
+			m_Free[index] = obj->next;
+			return obj;
+		}
+
+		void do_deallocate(void* ptr, const size_t bytes, const size_t alignment) override {
+			if (bytes > maxBlockSize || alignment > granularity) {
+				m_Upstream->deallocate(ptr, bytes, alignment);
+				return;
+			}
+			const size_t index = sizeClass(bytes);
+			block* obj = static_cast<block*>(ptr);
+			obj->next = m_Free[index];
+			m_Free[index] = obj;
+		}
+
+		bool do_is_equal(const std::pmr::memory_resource& otr) const noexcept override {
+			return this == &otr;
+		}
+
+		static size_t sizeClass(const size_t bytes) {
+			return (std::max<size_t>(bytes, 1) + granularity - 1) / granularity - 1;
+		}
+
+		// Carves a new chunk into blocks of the size class and links them in address order, so a container filled in one go walks memory forwards
+		void refill(const size_t index) {
+			const size_t blockSize = (index + 1) * granularity;
+			const size_t size = granularity + blockSize * m_BlocksPerChunk;
+			chunk* added = static_cast<chunk*>(m_Upstream->allocate(size, granularity));
+			added->next = m_Chunks;
+			added->size = size;
+			m_Chunks = added;
+
+			std::byte* first = reinterpret_cast<std::byte*>(added) + granularity;
+			for (size_t i = m_BlocksPerChunk; i > 0; --i) {
+				block* obj = reinterpret_cast<block*>(first + (i - 1) * blockSize);
+				obj->next = m_Free[index];
+				m_Free[index] = obj;
+			}
+		}
+
+		std::array<block*, maxBlockSize / granularity> m_Free{};
+
+		chunk* m_Chunks = nullptr;
+
+		size_t m_BlocksPerChunk;
+
+		std::pmr::memory_resource* m_Upstream;
+	};
+
+	// Bumps a pointer through chunks taken from upstream, deallocate does nothing and memory only comes back on reset, release or destruction
+	// Each chunk is twice the size of the last, so an arena that grows to n bytes only asks upstream about log(n) times
+	// Best for containers that are filled, read and then thrown away together, such as everything built during one frame or tick
+	struct arena_resource : std::pmr::memory_resource {
+
+		explicit arena_resource(const size_t initialSize = 4096, std::pmr::memory_resource* upstream = std::pmr::get_default_resource())
+		: m_InitialSize(std::max<size_t>(initialSize, sizeof(chunk) * 2)),
+		  m_NextSize(m_InitialSize),
+		  m_Upstream(upstream) {}
+
+		// Hands out buffer first and only asks upstream once it runs out, buffer is never freed by the arena
+		arena_resource(void* buffer, const size_t size, std::pmr::memory_resource* upstream = std::pmr::get_default_resource())
+		: m_Buffer(static_cast<std::byte*>(buffer)),
+		  m_BufferSize(size),
+		  m_Cur(m_Buffer),
+		  m_End(m_Buffer + size),
+		  m_InitialSize(std::max<size_t>(size * 2, sizeof(chunk) * 2)),
+		  m_NextSize(m_InitialSize),
+		  m_Upstream(upstream) {}
+
+		// Memory handed out points into the arena, so it cannot be copied or moved
+		arena_resource(const arena_resource&) = delete;
+		arena_resource& operator=(const arena_resource&) = delete;
+
+		~arena_resource() override {
+			release();
+		}
+
+		// Starts handing out memory from the beginning again without giving anything back to upstream, everything handed out is invalid after this
+		// Nothing is destroyed or freed one by one, so containers bound to the arena must be destroyed or forgotten before this
+		// If the last round needed more than one chunk they are merged into one as large as all of them, so a steady load settles into one chunk and a reset is O(1)
+		// Builds without NDEBUG fill the old memory with 0xDD, and address sanitizer builds poison it so any use after the reset is reported
+		void reset() {
+			poison(m_Buffer, m_BufferSize);
+			if (m_Chunks && (m_Chunks->next || m_Spare)) {
+				size_t size = 0;
+				for (chunk* itr : {m_Chunks, m_Spare}) {
+					while (itr) {
+						chunk* next = itr->next;
+						size += itr->size;
+						freeChunk(itr);
+						itr = next;
+					}
+				}
+				m_Chunks = nullptr;
+				m_Spare = allocateChunk(size);
+				m_NextSize = size * 2;
+			} else if (m_Chunks) {
+				m_Spare = m_Chunks;
+				m_Chunks = nullptr;
+			}
+			if (m_Spare) {
+				poison(payload(m_Spare), m_Spare->size - sizeof(chunk));
+			}
+			m_Cur = m_Buffer;
+			m_End = m_Buffer + m_BufferSize;
+		}
+
+		// Gives every chunk back to upstream and starts again from the buffer, everything handed out is invalid after this
+		void release() {
+			for (chunk* itr : {m_Chunks, m_Spare}) {
+				while (itr) {
+					chunk* next = itr->next;
+					freeChunk(itr);
+					itr = next;
+				}
+			}
+			m_Chunks = nullptr;
+			m_Spare = nullptr;
+			unpoison(m_Buffer, m_BufferSize);
+			m_Cur = m_Buffer;
+			m_End = m_Buffer + m_BufferSize;
+			m_NextSize = m_InitialSize;
+		}
+
+		// Chunks in use since the last reset, a spare chunk kept by reset is not counted until it is used
+		[[nodiscard]] size_t getChunkCount() const {
+			size_t amt = 0;
+			for (const chunk* itr = m_Chunks; itr; itr = itr->next) {
+				++amt;
+			}
+			return amt;
+		}
+
+		// Bytes the arena holds, including the buffer and any spare chunk
+		[[nodiscard]] size_t getCapacity() const {
+			size_t size = m_BufferSize;
+			for (const chunk* itr : {m_Chunks, m_Spare}) {
+				for (; itr; itr = itr->next) {
+					size += itr->size - sizeof(chunk);
+				}
+			}
+			return size;
+		}
+
+		[[nodiscard]] std::pmr::memory_resource* getUpstream() const {
+			return m_Upstream;
+		}
+
+	protected:
+
+		// Sits at the start of every chunk, memory is handed out after it
+		struct chunk {
+			chunk* next;
+			size_t size;
+		};
+
+		void* do_allocate(const size_t bytes, const size_t alignment) override {
+			std::byte* obj = align(m_Cur, alignment);
+			if (!obj || obj + bytes > m_End) {
+				grow(bytes, alignment);
+				obj = align(m_Cur, alignment);
+			}
+			m_Cur = obj + bytes;
+			unpoison(obj, bytes);
+			return obj;
+		}
+
+		void do_deallocate(void*, size_t, size_t) override {}
+
+		bool do_is_equal(const std::pmr::memory_resource& otr) const noexcept override {
+			return this == &otr;
+		}
+
+		static std::byte* align(std::byte* ptr, const size_t alignment) {
+			if (!ptr) return nullptr;
+			const uintptr_t address = reinterpret_cast<uintptr_t>(ptr);
+			return ptr + ((alignment - address % alignment) % alignment);
+		}
+
+		static std::byte* payload(chunk* obj) {
+			return reinterpret_cast<std::byte*>(obj) + sizeof(chunk);
+		}
+
+		// Parts left over from the last reset are still poisoned, so everything is unpoisoned before it is filled
+		static void poison(std::byte* ptr, const size_t size) {
+			if (!ptr) return;
+			unpoison(ptr, size);
+#ifndef NDEBUG
+			std::memset(ptr, 0xDD, size);
+#endif
+#ifdef SIMPLESTL_ASAN
+			ASAN_POISON_MEMORY_REGION(ptr, size);
+#endif
+		}
+
+		static void unpoison(std::byte* ptr, const size_t size) {
+			if (!ptr) return;
+#ifdef SIMPLESTL_ASAN
+			ASAN_UNPOISON_MEMORY_REGION(ptr, size);
+#endif
+		}
+
+		chunk* allocateChunk(const size_t size) {
+			chunk* added = static_cast<chunk*>(m_Upstream->allocate(size, alignof(std::max_align_t)));
+			added->next = nullptr;
+			added->size = size;
+			return added;
+		}
+
+		void freeChunk(chunk* obj) {
+			unpoison(payload(obj), obj->size - sizeof(chunk));
+			m_Upstream->deallocate(obj, obj->size, alignof(std::max_align_t));
+		}
+
+		// Moves on to the spare chunk kept by reset if the allocation fits in it, otherwise takes a new one from upstream
+		void grow(const size_t bytes, const size_t alignment) {
+			chunk* added;
+			if (m_Spare && sizeof(chunk) + bytes + alignment <= m_Spare->size) {
+				added = m_Spare;
+				m_Spare = nullptr;
+			} else {
+				added = allocateChunk(std::max(m_NextSize, sizeof(chunk) + bytes + alignment));
+				m_NextSize = added->size * 2;
+			}
+			added->next = m_Chunks;
+			m_Chunks = added;
+			m_Cur = payload(added);
+			m_End = reinterpret_cast<std::byte*>(added) + added->size;
+		}
+
+		std::byte* m_Buffer = nullptr;
+		size_t m_BufferSize = 0;
+
+		std::byte* m_Cur = nullptr;
+		std::byte* m_End = nullptr;
+
+		chunk* m_Chunks = nullptr;
+
+		// Kept by reset to be used before asking upstream for more
+		chunk* m_Spare = nullptr;
+
+		size_t m_InitialSize;
+		size_t m_NextSize;
+
+		std::pmr::memory_resource* m_Upstream;
+	};
+
+	// Slots for objects of a single type, carved out of chunks taken from upstream and kept on a free list once their object is gone
+	// Each slot starts with a pointer back to its pool, so a TUnique from TUnique<TType>::createIn only carries the same function pointer as one made with new
+	// The pool must outlive every object made from it, and is not thread safe
+	template <typename TType>
+	struct object_pool {
+
+		// Counters since the pool was made, only creates that found the free list empty had to go to upstream for a new chunk
+		// Capacity and chunks go back to 0 on release
+		struct statistics {
+			size_t live = 0;
+			size_t peak = 0;
+			size_t created = 0;
+			size_t destroyed = 0;
+			size_t capacity = 0;
+			size_t chunks = 0;
+		};
+
+		explicit object_pool(const size_t objectsPerChunk = 64, std::pmr::memory_resource* upstream = std::pmr::get_default_resource())
+		: m_ObjectsPerChunk(std::max<size_t>(1, objectsPerChunk)),
+		  m_Upstream(upstream) {}
+
+		// Objects point into the chunks, so a pool cannot be copied or moved
+		object_pool(const object_pool&) = delete;
+		object_pool& operator=(const object_pool&) = delete;
+
+		~object_pool() {
+			freeChunks();
+		}
+
+		// Constructs an object in a free slot, taking a new chunk from upstream if there are none left
+		// Unlike TUnique this does not call init(), createIn does that once the object is owned
+		template <typename... TArgs>
+		TType* create(TArgs&&... args) {
+			static_assert(!sstl::is_releasable_v<TType>, "Objects that release themselves cannot live in a pool!");
+			if (!m_Free) {
+				refill();
+			}
+			slot* obj = m_Free;
+			m_Free = obj->next;
+			TType* ptr;
+			try {
+				ptr = ::new (static_cast<void*>(obj->storage)) TType(std::forward<TArgs>(args)...);
+			} catch (...) {
+				obj->next = m_Free;
+				m_Free = obj;
+				throw;
+			}
+			++m_Stats.created;
+			m_Stats.peak = std::max(m_Stats.peak, ++m_Stats.live);
+			return ptr;
+		}
+
+		// Calls destroy() if the type has one, then the destructor, and puts the slot back on the free list
+		void destroy(TType* ptr) noexcept {
+			if (!ptr) return;
+			if constexpr (sstl::is_destroyable_v<TType>) {
+				ptr->destroy();
+			}
+			ptr->~TType();
+			slot* obj = toSlot(ptr);
+			obj->next = m_Free;
+			m_Free = obj;
+			--m_Stats.live;
+			++m_Stats.destroyed;
+		}
+
+		// Gives every chunk back to upstream, only allowed once every object has been destroyed
+		void release() {
+			if (m_Stats.live != 0) {
+				throw std::runtime_error("Object pool still has live objects, cannot release it.");
+			}
+			freeChunks();
+		}
+
+		[[nodiscard]] const statistics& getStats() const {
+			return m_Stats;
+		}
+
+		[[nodiscard]] std::pmr::memory_resource* getUpstream() const {
+			return m_Upstream;
+		}
+
+		// The deleter TUnique stores for objects made by createIn, finds the pool through the slot the object lives in
+		static void delete_impl(void* ptr) noexcept {
+			TType* obj = static_cast<TType*>(ptr);
+			toSlot(obj)->owner->destroy(obj);
+		}
+
+	private:
+
+		struct slot {
+			object_pool* owner;
+			union {
+				slot* next;
+				alignas(TType) unsigned char storage[sizeof(TType)];
+			};
+		};
+
+		// Sits at the start of every chunk, the slots follow it
+		struct chunk {
+			chunk* next;
+		};
+
+		constexpr static size_t chunkAlignment = std::max(alignof(slot), alignof(std::max_align_t));
+		constexpr static size_t headerSize = (sizeof(chunk) + alignof(slot) - 1) / alignof(slot) * alignof(slot);
+
+		static slot* toSlot(TType* ptr) {
+			return reinterpret_cast<slot*>(reinterpret_cast<unsigned char*>(ptr) - offsetof(slot, storage));
+		}
+
+		[[nodiscard]] size_t chunkSize() const {
+			return headerSize + sizeof(slot) * m_ObjectsPerChunk;
+		}
+
+		void freeChunks() {
+			while (m_Chunks) {
+				chunk* next = m_Chunks->next;
+				m_Upstream->deallocate(m_Chunks, chunkSize(), chunkAlignment);
+				m_Chunks = next;
+			}
+			m_Free = nullptr;
+			m_Stats.capacity = 0;
+			m_Stats.chunks = 0;
+		}
+
+		// Links the slots of a new chunk in address order, so objects made in one go sit next to each other
+		void refill() {
+			chunk* added = static_cast<chunk*>(m_Upstream->allocate(chunkSize(), chunkAlignment));
+			added->next = m_Chunks;
+			m_Chunks = added;
+
+			slot* first = reinterpret_cast<slot*>(reinterpret_cast<unsigned char*>(added) + headerSize);
+			for (size_t i = m_ObjectsPerChunk; i > 0; --i) {
+				slot* obj = first + (i - 1);
+				obj->owner = this;
+				obj->next = m_Free;
+				m_Free = obj;
+			}
+			m_Stats.capacity += m_ObjectsPerChunk;
+			++m_Stats.chunks;
+		}
+
+		slot* m_Free = nullptr;
+
+		chunk* m_Chunks = nullptr;
+
+		size_t m_ObjectsPerChunk;
+
+		std::pmr::memory_resource* m_Upstream;
+
+		statistics m_Stats;
+	};
+}
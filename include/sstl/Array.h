@@ -1,12 +1,68 @@
 ﻿#pragma once
 
 #include <array>
+#include <cstdint>
+#include "Bits.h"
 #include "Container.h"
 #include "InitializerList.h"
+#include "Sort.h"
 
-template <typename TType, size_t TSize>
+namespace sstl {
+
+	// Stack of the free slots of a TArray in slot map mode, with the position of every slot in the stack so any one can be taken out in O(1)
+	template <size_t TSize>
+	struct free_slots {
+
+		using TIndex = std::conditional_t<(TSize <= UINT32_MAX), uint32_t, size_t>;
+
+		[[nodiscard]] size_t getSize() const {
+			return m_Size;
+		}
+
+		[[nodiscard]] size_t top() const {
+			return m_Slots[m_Size - 1];
+		}
+
+		// Frees every slot from start on, with the lowest on top
+		void reset(const size_t start) {
+			m_Size = 0;
+			for (size_t slot = TSize; slot > start; --slot) {
+				give(slot - 1);
+			}
+		}
+
+		// Takes slot off the stack by swapping the top into its place
+		void take(const size_t slot) {
+			const TIndex moved = m_Slots[--m_Size];
+			m_Slots[m_Position[slot]] = moved;
+			m_Position[moved] = m_Position[slot];
+		}
+
+		void give(const size_t slot) {
+			m_Position[slot] = static_cast<TIndex>(m_Size);
+			m_Slots[m_Size++] = static_cast<TIndex>(slot);
+		}
+
+	private:
+
+		std::array<TIndex, TSize> m_Slots{};
+		std::array<TIndex, TSize> m_Position{};
+		size_t m_Size = 0;
+	};
+}
+
+// Fixed array of TSize slots that are each populated or free, push fills the first free slot it finds
+// Which slots are populated is packed 64 to a word, so searching and counting look at 64 slots per step
+// By default push fills the lowest free slot, found by scanning up from the lowest slot that might be free
+// With TSlotMap every popped slot is kept on a stack instead, so push reuses the most recently freed slot in O(1) no matter how the array was popped
+template <typename TType, size_t TSize, bool TSlotMap = false>
 struct TArray : TSequenceContainer<TType> {
 
+	using iterator = typename std::array<TType, TSize>::iterator;
+	using const_iterator = typename std::array<TType, TSize>::const_iterator;
+	using reverse_iterator = typename std::array<TType, TSize>::reverse_iterator;
+	using const_reverse_iterator = typename std::array<TType, TSize>::const_reverse_iterator;
+
 	TArray() {
 		TArray::clear();
 	}
@@ -14,12 +70,19 @@ struct TArray : TSequenceContainer<TType> {
 	template <typename... TArgs,
 		std::enable_if_t<std::conjunction_v<std::is_constructible<TType, TArgs>...>, int> = 0
 	>
-	explicit TArray(TArgs&&... args): m_Container{std::forward<TArgs>(args)...} {}
+	explicit TArray(TArgs&&... args): m_Container{std::forward<TArgs>(args)...} {
+		setPopulated(sizeof...(TArgs));
+	}
 
 	[[nodiscard]] virtual size_t getSize() const override {
 		return m_Container.size();
 	}
 
+	// How many slots are populated, getSize is always TSize
+	[[nodiscard]] size_t count() const {
+		return m_IsPopulated.count();
+	}
+
 	TType* data() { return m_Container.data(); }
 
 	const TType* data() const { return m_Container.data(); }
@@ -91,7 +154,7 @@ struct TArray : TSequenceContainer<TType> {
 			for (size_t i = 0; i < amt; ++i) {
 				if (!m_IsPopulated[i]) {
 					m_Container[i] = {};
-					m_IsPopulated[i] = true;
+					markPopulated(i);
 				}
 			}
 		} else {
@@ -103,7 +166,7 @@ struct TArray : TSequenceContainer<TType> {
 		for (size_t i = 0; i < amt; ++i) {
 			if (!m_IsPopulated[i]) {
 				get(i) = std::forward<TType>(func(i));
-				m_IsPopulated[i] = true;
+				markPopulated(i);
 			}
 		}
 	}
@@ -126,14 +189,10 @@ struct TArray : TSequenceContainer<TType> {
 
 	virtual size_t push(const TType& obj) override {
 		if constexpr (std::is_copy_constructible_v<TType>) {
-			for (size_t i = 0; i < getSize(); ++i) {
-				if (!m_IsPopulated[i]) { //is not populated
-					m_IsPopulated[i] = true;
-					m_Container[i] = obj;
-					return i;
-				}
-			}
-			throw std::runtime_error("Array is full, cannot add any more elements.");
+			const size_t i = nextFree();
+			m_Container[i] = obj;
+			markPopulated(i);
+			return i;
 		} else {
 			throw std::runtime_error("Type is not copyable!");
 		}
@@ -141,14 +200,10 @@ struct TArray : TSequenceContainer<TType> {
 
 	virtual size_t push(TType&& obj) override {
 		if constexpr (std::is_move_constructible_v<TType>) {
-			for (size_t i = 0; i < getSize(); ++i) {
-				if (!m_IsPopulated[i]) { //is not populated
-					m_IsPopulated[i] = true;
-					m_Container[i] = std::move(obj);
-					return i;
-				}
-			}
-			throw std::runtime_error("Array is full, cannot add any more elements.");
+			const size_t i = nextFree();
+			m_Container[i] = std::move(obj);
+			markPopulated(i);
+			return i;
 		} else {
 			throw std::runtime_error("Type is not moveable!");
 		}
@@ -162,6 +217,39 @@ struct TArray : TSequenceContainer<TType> {
 		replace(index, std::move(obj));
 	}
 
+	// Adds every element in [first, last) to the first free slots
+	template <typename TIterator>
+	void pushRange(TIterator first, TIterator last) {
+		for (; first != last; ++first) {
+			push(*first);
+		}
+	}
+
+	// Adds every element of another container or range, elements are moved out if it is an rvalue
+	template <typename TRange>
+	void pushRange(TRange&& range) {
+		if constexpr (std::is_rvalue_reference_v<TRange&&>) {
+			pushRange(std::make_move_iterator(range.begin()), std::make_move_iterator(range.end()));
+		} else {
+			pushRange(range.begin(), range.end());
+		}
+	}
+
+	// Constructs an element from args into the first free slot
+	// The slots of a std::array always hold a live object, so the new element is move assigned in
+	template <typename... TArgs>
+	TType& emplace(TArgs&&... args) {
+		return emplaceAt(nextFree(), std::forward<TArgs>(args)...);
+	}
+
+	// Constructs an element from args at index, replacing whatever was there
+	template <typename... TArgs>
+	TType& emplaceAt(const size_t index, TArgs&&... args) {
+		m_Container[index] = TType(std::forward<TArgs>(args)...);
+		markPopulated(index);
+		return m_Container[index];
+	}
+
 	virtual void replace(const size_t index, const TType& obj) override {
 		if constexpr (std::is_copy_constructible_v<TType>) {
 			m_Container[index] = obj;
@@ -180,22 +268,20 @@ struct TArray : TSequenceContainer<TType> {
 
 	// Array is on stack, it is destroyed when out of scope
 	virtual void clear() override {
-		m_IsPopulated.fill(false);
+		setPopulated(0);
 	}
 
 	virtual void pop() override {
-		for (size_t i = getSize(); i > 0; --i) {
-			if (m_IsPopulated[i - 1]) { //is populated
-				m_IsPopulated[i - 1] = false;
-				return;
-			}
+		const size_t last = m_IsPopulated.findLastSet();
+		if (last == TSize) {
+			throw std::runtime_error("No element to be popped!");
 		}
-		throw std::runtime_error("No element to be popped!");
+		markFree(last);
 	}
 
 	virtual void pop(const size_t index) override {
 		if (m_IsPopulated[index]) { //is populated
-			m_IsPopulated[index] = false;
+			markFree(index);
 			return;
 		}
 		throw std::runtime_error("No element at index to be popped!");
@@ -203,9 +289,9 @@ struct TArray : TSequenceContainer<TType> {
 
 	virtual void pop(const TType& obj) override {
 		if constexpr (sstl::is_equality_comparable_v<TType>) {
-			forEach([&](size_t index, TType& otr) {
+			forEachPopulated([&](size_t index, TType& otr) {
 				if (otr == obj) {
-					m_IsPopulated[index] = false;
+					markFree(index);
 				}
 			});
 		} else {
@@ -215,10 +301,10 @@ struct TArray : TSequenceContainer<TType> {
 
 	virtual void pop(typename TUnfurled<TType>::Type* obj) override {
 		if constexpr (sstl::is_managed_v<TType>) {
-			forEach([&](size_t index, TType& otr) {
+			forEachPopulated([&](size_t index, TType& otr) {
 				// Will compare pointers, is always comparable
 				if (otr.get() == obj) {
-					m_IsPopulated[index] = false;
+					markFree(index);
 				}
 			});
 		} else {
@@ -226,6 +312,50 @@ struct TArray : TSequenceContainer<TType> {
 		}
 	}
 
+	virtual void popRange(const size_t start, const size_t end) override {
+		for (size_t i = start; i < end; ++i) {
+			markFree(i);
+		}
+	}
+
+	// Moves every populated element into the front slots, keeping their order, then sorts them by comp, every free slot ends up after them
+	template <typename TCompare = std::less<TType>>
+	void sort(TCompare comp = {}) {
+		sstl::sort(m_Container.begin(), m_Container.begin() + compact(), comp);
+	}
+
+	// Splits large containers across pool, ParallelSort.h has to be included to use it
+	template <typename TCompare>
+	void sort(TCompare comp, TThreadPool& pool) {
+		sstl::sort(m_Container.begin(), m_Container.begin() + compact(), comp, pool);
+	}
+
+	// Like sort, but equal elements keep their order
+	template <typename TCompare = std::less<TType>>
+	void stableSort(TCompare comp = {}) {
+		sstl::stableSort(m_Container.begin(), m_Container.begin() + compact(), comp);
+	}
+
+	template <typename TCompare>
+	void stableSort(TCompare comp, TThreadPool& pool) {
+		sstl::stableSort(m_Container.begin(), m_Container.begin() + compact(), comp, pool);
+	}
+
+	// Moves every populated element into the front slots, then sorts only the amt smallest of them into the front
+	template <typename TCompare = std::less<TType>>
+	void partialSort(const size_t amt, TCompare comp = {}) {
+		const size_t populated = compact();
+		std::partial_sort(m_Container.begin(), m_Container.begin() + std::min(amt, populated), m_Container.begin() + populated, comp);
+	}
+
+	// Moves every populated element into the front slots, then puts the one that belongs at index after sorting there
+	// Does nothing if index is past the populated elements, the same way partialSort clamps amt
+	template <typename TCompare = std::less<TType>>
+	void nthElement(const size_t index, TCompare comp = {}) {
+		const size_t populated = compact();
+		std::nth_element(m_Container.begin(), m_Container.begin() + std::min(index, populated), m_Container.begin() + populated, comp);
+	}
+
 	virtual void forEach(const std::function<void(size_t, TType&)>& func) override {
 		size_t i = 0;
 		for (auto itr = m_Container.begin(); itr != m_Container.end(); ++itr, ++i) {
@@ -254,10 +384,166 @@ struct TArray : TSequenceContainer<TType> {
 		}
 	}
 
+	// Iterates through each element, accepts any callable so the loop can be inlined
+	template <typename TFunc>
+	void forEach(TFunc&& func) {
+		size_t i = 0;
+		for (auto itr = m_Container.begin(); itr != m_Container.end(); ++itr, ++i) {
+			func(i, *itr);
+		}
+	}
+
+	// Iterates through each element, const version
+	template <typename TFunc>
+	void forEach(TFunc&& func) const {
+		size_t i = 0;
+		for (auto itr = m_Container.begin(); itr != m_Container.end(); ++itr, ++i) {
+			func(i, *itr);
+		}
+	}
+
+	// Iterates through each element in reverse, accepts any callable so the loop can be inlined
+	template <typename TFunc>
+	void forEachReverse(TFunc&& func) {
+		size_t i = m_Container.size() - 1;
+		for (auto itr = m_Container.rbegin(); itr != m_Container.rend(); ++itr, --i) {
+			func(i, *itr);
+		}
+	}
+
+	// Iterates through each element in reverse, const version
+	template <typename TFunc>
+	void forEachReverse(TFunc&& func) const {
+		size_t i = m_Container.size() - 1;
+		for (auto itr = m_Container.rbegin(); itr != m_Container.rend(); ++itr, --i) {
+			func(i, *itr);
+		}
+	}
+
+	// Iterates through only the populated slots, skipping 64 free slots at a time
+	template <typename TFunc>
+	void forEachPopulated(TFunc&& func) {
+		m_IsPopulated.forEachSet([&](const size_t index) {
+			func(index, m_Container[index]);
+		});
+	}
+
+	// Iterates through only the populated slots, const version
+	template <typename TFunc>
+	void forEachPopulated(TFunc&& func) const {
+		m_IsPopulated.forEachSet([&](const size_t index) {
+			func(index, m_Container[index]);
+		});
+	}
+
+	template <typename TFunc>
+	void doFor(const size_t index, TFunc&& func) {
+		func(m_Container[index]);
+	}
+
+	template <typename TFunc>
+	void doFor(const size_t index, TFunc&& func) const {
+		func(m_Container[index]);
+	}
+
+	template <typename TFunc>
+	void doFor(const size_t start, const size_t end, TFunc&& func) {
+		for (size_t i = start; i < end; ++i) {
+			func(i, m_Container[i]);
+		}
+	}
+
+	template <typename TFunc>
+	void doFor(const size_t start, const size_t end, TFunc&& func) const {
+		for (size_t i = start; i < end; ++i) {
+			func(i, m_Container[i]);
+		}
+	}
+
+	iterator begin() { return m_Container.begin(); }
+
+	const_iterator begin() const { return m_Container.begin(); }
+
+	iterator end() { return m_Container.end(); }
+
+	const_iterator end() const { return m_Container.end(); }
+
+	const_iterator cbegin() const { return m_Container.cbegin(); }
+
+	const_iterator cend() const { return m_Container.cend(); }
+
+	reverse_iterator rbegin() { return m_Container.rbegin(); }
+
+	const_reverse_iterator rbegin() const { return m_Container.rbegin(); }
+
+	reverse_iterator rend() { return m_Container.rend(); }
+
+	const_reverse_iterator rend() const { return m_Container.rend(); }
+
+	const_reverse_iterator crbegin() const { return m_Container.crbegin(); }
+
+	const_reverse_iterator crend() const { return m_Container.crend(); }
+
 protected:
 
-	std::array<bool, TSize> m_IsPopulated;
+	// Moves every populated element down into the free slots before it, keeping their order, returns how many are populated
+	size_t compact() {
+		size_t populated = 0;
+		m_IsPopulated.forEachSet([&](const size_t index) {
+			if (index != populated) {
+				m_Container[populated] = std::move(m_Container[index]);
+			}
+			++populated;
+		});
+		setPopulated(populated);
+		return populated;
+	}
+
+	// Finds the slot push fills next, throws if there is none
+	size_t nextFree() {
+		if constexpr (TSlotMap) {
+			if (m_Free.getSize() > 0) return m_Free.top();
+		} else {
+			// Every slot before m_Free is populated, so filling the array only passes over each word once
+			m_Free = m_IsPopulated.findClear(m_Free);
+			if (m_Free < TSize) return m_Free;
+		}
+		throw std::runtime_error("Array is full, cannot add any more elements.");
+	}
+
+	void markPopulated(const size_t index) {
+		if (m_IsPopulated[index]) return;
+		m_IsPopulated.set(index);
+		if constexpr (TSlotMap) {
+			m_Free.take(index);
+		}
+	}
+
+	void markFree(const size_t index) {
+		if (!m_IsPopulated[index]) return;
+		m_IsPopulated.reset(index);
+		if constexpr (TSlotMap) {
+			m_Free.give(index);
+		} else {
+			m_Free = std::min(m_Free, index);
+		}
+	}
+
+	// Populates the first amt slots and frees every other one
+	void setPopulated(const size_t amt) {
+		m_IsPopulated.assign(amt);
+		if constexpr (TSlotMap) {
+			m_Free.reset(amt);
+		} else {
+			m_Free = amt;
+		}
+	}
+
+	sstl::bit_array<TSize> m_IsPopulated;
 	std::array<TType, TSize> m_Container;
+
+	// The stack of free slots in slot map mode, otherwise the lowest slot that might be free
+	std::conditional_t<TSlotMap, sstl::free_slots<TSize>, size_t> m_Free;
 };
 
 template <typename TType, typename... TArgs>
@@ -0,0 +1,671 @@
+﻿#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <new>
+#include <utility>
+#include "Container.h"
+
+namespace sstl {
+
+	// Ordered tree with many elements per node, a lookup touches a few nodes instead of one per level of a red-black tree
+	// Elements are stored in inner nodes as well, so keys are never copied into separators and move only elements still work
+	// Maps store std::pair<const TKey, TValue>, so their keys are copied whenever a pair is moved between slots
+	// TKeyOf gets the key out of a stored TValue, so the same tree backs both sets and maps
+	// Leaves and inner nodes come from TAllocator, rebound to each node type
+	template <typename TKey, typename TValue, typename TKeyOf, typename TAllocator = std::allocator<TValue>>
+	struct btree {
+
+		// Nodes hold about 256 bytes of elements, but at least 3, so a full node can always be split around its median
+		constexpr static size_t capacity = std::max<size_t>(3, 256 / sizeof(TValue));
+
+		// Every node other than the root keeps at least this many elements, both halves of a split node do
+		constexpr static size_t minimum = (capacity - 1) / 2;
+
+	protected:
+
+		struct node {
+
+			explicit node(const bool isLeaf): leaf(isLeaf) {}
+
+			TValue* values() { return std::launder(reinterpret_cast<TValue*>(storage)); }
+
+			const TValue* values() const { return std::launder(reinterpret_cast<const TValue*>(storage)); }
+
+			node* parent = nullptr;
+
+			// Index of this node in its parent's children
+			uint16_t position = 0;
+			uint16_t count = 0;
+			bool leaf;
+
+			// Elements are constructed in place, so TValue does not need to be default constructible
+			alignas(TValue) unsigned char storage[capacity * sizeof(TValue)];
+		};
+
+		struct inner : node {
+
+			inner(): node(false) {}
+
+			// One more child than elements, child i holds everything between element i - 1 and element i
+			node* children[capacity + 1];
+		};
+
+	public:
+
+		template <bool TConst>
+		struct basic_iterator {
+
+			using iterator_category = std::bidirectional_iterator_tag;
+			using value_type = TValue;
+			using difference_type = std::ptrdiff_t;
+			using pointer = std::conditional_t<TConst, const TValue*, TValue*>;
+			using reference = std::conditional_t<TConst, const TValue&, TValue&>;
+			using node_type = std::conditional_t<TConst, const node, node>;
+			using inner_type = std::conditional_t<TConst, const inner, inner>;
+
+			basic_iterator() = default;
+
+			basic_iterator(node_type* inNode, const size_t index): m_Node(inNode), m_Index(index) {}
+
+			template <bool TOtherConst = TConst,
+				std::enable_if_t<!TOtherConst, int> = 0
+			>
+			operator basic_iterator<true>() const {
+				return basic_iterator<true>(m_Node, m_Index);
+			}
+
+			reference operator*() const { return m_Node->values()[m_Index]; }
+
+			pointer operator->() const { return m_Node->values() + m_Index; }
+
+			basic_iterator& operator++() {
+				if (!m_Node->leaf) {
+					// The next element is the leftmost one in the subtree right of this element
+					m_Node = static_cast<inner_type*>(m_Node)->children[m_Index + 1];
+					while (!m_Node->leaf) {
+						m_Node = static_cast<inner_type*>(m_Node)->children[0];
+					}
+					m_Index = 0;
+				} else if (++m_Index == m_Node->count) {
+					// Climb out of every subtree that was the last child, the element after the first one that was not is next
+					node_type* cur = m_Node;
+					size_t index = m_Index;
+					while (cur->parent && index == cur->count) {
+						index = cur->position;
+						cur = cur->parent;
+					}
+					// Otherwise this was the last element, and one past the end of the rightmost leaf is end
+					if (index < cur->count) {
+						m_Node = cur;
+						m_Index = index;
+					}
+				}
+				return *this;
+			}
+
+			basic_iterator operator++(int) {
+				basic_iterator itr = *this;
+				++*this;
+				return itr;
+			}
+
+			basic_iterator& operator--() {
+				if (!m_Node->leaf) {
+					// The previous element is the rightmost one in the subtree left of this element
+					m_Node = static_cast<inner_type*>(m_Node)->children[m_Index];
+					while (!m_Node->leaf) {
+						m_Node = static_cast<inner_type*>(m_Node)->children[m_Node->count];
+					}
+					m_Index = m_Node->count - 1;
+				} else if (m_Index > 0) {
+					--m_Index;
+				} else {
+					// Climb out of every subtree that was the first child, the element before the first one that was not is previous
+					while (m_Node->position == 0) {
+						m_Node = m_Node->parent;
+					}
+					m_Index = m_Node->position - 1;
+					m_Node = m_Node->parent;
+				}
+				return *this;
+			}
+
+			basic_iterator operator--(int) {
+				basic_iterator itr = *this;
+				--*this;
+				return itr;
+			}
+
+			friend bool operator==(const basic_iterator& fst, const basic_iterator& snd) {
+				return fst.m_Node == snd.m_Node && fst.m_Index == snd.m_Index;
+			}
+
+			friend bool operator!=(const basic_iterator& fst, const basic_iterator& snd) {
+				return !(fst == snd);
+			}
+
+		private:
+
+			friend struct btree;
+
+			node_type* m_Node = nullptr;
+			size_t m_Index = 0;
+		};
+
+		using iterator = basic_iterator<false>;
+		using const_iterator = basic_iterator<true>;
+
+		btree() = default;
+
+		explicit btree(const TAllocator& allocator): m_Allocator(allocator) {}
+
+		btree(const btree& otr): m_Allocator(traits::select_on_container_copy_construction(otr.m_Allocator)) {
+			copyFrom(otr);
+		}
+
+		btree(btree&& otr) noexcept: m_Allocator(otr.m_Allocator) {
+			swap(otr);
+		}
+
+		btree& operator=(const btree& otr) {
+			if (this != &otr) {
+				clear();
+				if constexpr (traits::propagate_on_container_copy_assignment::value) m_Allocator = otr.m_Allocator;
+				copyFrom(otr);
+			}
+			return *this;
+		}
+
+		// Nodes from an allocator that is not ours cannot be taken over, so then the elements are moved one by one instead
+		btree& operator=(btree&& otr) noexcept(traits::propagate_on_container_move_assignment::value || traits::is_always_equal::value) {
+			if (this != &otr) {
+				clear();
+				if (traits::propagate_on_container_move_assignment::value || m_Allocator == otr.m_Allocator) {
+					if constexpr (traits::propagate_on_container_move_assignment::value) m_Allocator = otr.m_Allocator;
+					swap(otr);
+				} else {
+					for (TValue& value : otr) {
+						emplaceMulti(TKeyOf{}(value), std::move(value));
+					}
+					otr.clear();
+				}
+			}
+			return *this;
+		}
+
+		~btree() {
+			clear();
+		}
+
+		[[nodiscard]] TAllocator getAllocator() const { return m_Allocator; }
+
+		// Swaps the nodes but not the allocators, so both trees must use equal allocators
+		void swap(btree& otr) noexcept {
+			std::swap(m_Root, otr.m_Root);
+			std::swap(m_Leftmost, otr.m_Leftmost);
+			std::swap(m_Rightmost, otr.m_Rightmost);
+			std::swap(m_Size, otr.m_Size);
+		}
+
+		[[nodiscard]] size_t size() const { return m_Size; }
+
+		[[nodiscard]] bool empty() const { return m_Size == 0; }
+
+		iterator begin() { return iterator(m_Leftmost, 0); }
+
+		const_iterator begin() const { return const_iterator(m_Leftmost, 0); }
+
+		iterator end() { return m_Rightmost ? iterator(m_Rightmost, m_Rightmost->count) : iterator(); }
+
+		const_iterator end() const { return m_Rightmost ? const_iterator(m_Rightmost, m_Rightmost->count) : const_iterator(); }
+
+		const_iterator cbegin() const { return begin(); }
+
+		const_iterator cend() const { return end(); }
+
+		// The largest element is always the last one in the rightmost leaf
+		TValue& back() { return m_Rightmost->values()[m_Rightmost->count - 1]; }
+
+		const TValue& back() const { return m_Rightmost->values()[m_Rightmost->count - 1]; }
+
+		iterator find(const TKey& key) {
+			const auto [cur, index] = locate(key);
+			return cur ? iterator(cur, index) : end();
+		}
+
+		const_iterator find(const TKey& key) const {
+			const auto [cur, index] = locate(key);
+			return cur ? const_iterator(cur, index) : end();
+		}
+
+		[[nodiscard]] bool contains(const TKey& key) const {
+			return locate(key).first != nullptr;
+		}
+
+		// First element whose key is not less than key
+		iterator lowerBound(const TKey& key) {
+			const auto [cur, index] = bound(key, &btree::lowerIndex);
+			return iterator(cur, index);
+		}
+
+		const_iterator lowerBound(const TKey& key) const {
+			const auto [cur, index] = bound(key, &btree::lowerIndex);
+			return const_iterator(cur, index);
+		}
+
+		// First element whose key is greater than key
+		iterator upperBound(const TKey& key) {
+			const auto [cur, index] = bound(key, &btree::upperIndex);
+			return iterator(cur, index);
+		}
+
+		const_iterator upperBound(const TKey& key) const {
+			const auto [cur, index] = bound(key, &btree::upperIndex);
+			return const_iterator(cur, index);
+		}
+
+		// Constructs a TValue from args if key is not present yet, args are left untouched otherwise
+		template <typename... TArgs>
+		std::pair<iterator, bool> tryEmplace(const TKey& key, TArgs&&... args) {
+			prepareRoot();
+			node* cur = m_Root;
+			while (true) {
+				size_t index = lowerIndex(cur, key);
+				if (index < cur->count && !(key < TKeyOf{}(cur->values()[index]))) {
+					return {iterator(cur, index), false};
+				}
+				if (cur->leaf) {
+					insertAt(cur, index, std::forward<TArgs>(args)...);
+					++m_Size;
+					return {iterator(cur, index), true};
+				}
+				if (children(cur)[index]->count == capacity) {
+					split(static_cast<inner*>(cur), index);
+					// The median moved up to index, so key may now be it, or belong to the new right half
+					const TKey& median = TKeyOf{}(cur->values()[index]);
+					if (!(key < median)) {
+						if (!(median < key)) {
+							return {iterator(cur, index), false};
+						}
+						++index;
+					}
+				}
+				cur = children(cur)[index];
+			}
+		}
+
+		// Constructs a TValue from args after every element with an equal key, for containers that allow duplicates
+		template <typename... TArgs>
+		iterator emplaceMulti(const TKey& key, TArgs&&... args) {
+			prepareRoot();
+			node* cur = m_Root;
+			while (true) {
+				size_t index = upperIndex(cur, key);
+				if (cur->leaf) {
+					insertAt(cur, index, std::forward<TArgs>(args)...);
+					++m_Size;
+					return iterator(cur, index);
+				}
+				if (children(cur)[index]->count == capacity) {
+					split(static_cast<inner*>(cur), index);
+					// The median moved up to index, anything not less than it belongs in the new right half
+					if (!(key < TKeyOf{}(cur->values()[index]))) {
+						++index;
+					}
+				}
+				cur = children(cur)[index];
+			}
+		}
+
+		void erase(const_iterator itr) {
+			node* cur = const_cast<node*>(itr.m_Node);
+			const size_t index = itr.m_Index;
+			TValue* values = cur->values();
+			if (cur->leaf) {
+				values[index].~TValue();
+				for (size_t i = index + 1; i < cur->count; ++i) {
+					relocate(values + i - 1, values + i);
+				}
+			} else {
+				// An inner element is replaced by the one just before it, which is always the last element of a leaf
+				node* leaf = children(cur)[index];
+				while (!leaf->leaf) {
+					leaf = children(leaf)[leaf->count];
+				}
+				values[index].~TValue();
+				relocate(values + index, leaf->values() + leaf->count - 1);
+				cur = leaf;
+			}
+			--cur->count;
+			--m_Size;
+			rebalance(cur);
+		}
+
+		size_t erase(const TKey& key) {
+			const auto [cur, index] = locate(key);
+			if (!cur) return 0;
+			erase(const_iterator(cur, index));
+			return 1;
+		}
+
+		// Erases every element with an equal key, returns how many there were
+		size_t eraseAll(const TKey& key) {
+			size_t count = 0;
+			for (auto found = locate(key); found.first; found = locate(key)) {
+				erase(const_iterator(found.first, found.second));
+				++count;
+			}
+			return count;
+		}
+
+		void clear() {
+			if (!m_Root) return;
+			destroy(m_Root);
+			m_Root = m_Leftmost = m_Rightmost = nullptr;
+			m_Size = 0;
+		}
+
+	protected:
+
+		using traits = std::allocator_traits<TAllocator>;
+
+		template <typename TNode>
+		using node_traits = typename traits::template rebind_traits<TNode>;
+
+		template <typename TNode, typename... TArgs>
+		TNode* allocateNode(TArgs&&... args) {
+			typename node_traits<TNode>::allocator_type allocator(m_Allocator);
+			TNode* cur = node_traits<TNode>::allocate(allocator, 1);
+			return ::new (static_cast<void*>(cur)) TNode(std::forward<TArgs>(args)...);
+		}
+
+		node* makeNode(const bool leaf) {
+			return leaf ? allocateNode<node>(true) : static_cast<node*>(allocateNode<inner>());
+		}
+
+		template <typename TNode>
+		void deallocateNode(TNode* cur) {
+			typename node_traits<TNode>::allocator_type allocator(m_Allocator);
+			cur->~TNode();
+			node_traits<TNode>::deallocate(allocator, cur, 1);
+		}
+
+		// Frees a node whose elements are already destroyed or moved out
+		void freeNode(node* cur) {
+			if (cur->leaf) {
+				deallocateNode(cur);
+			} else {
+				deallocateNode(static_cast<inner*>(cur));
+			}
+		}
+
+		// Full nodes are split on the way down, so there is always room for the median of a split child
+		void prepareRoot() {
+			if (!m_Root) {
+				m_Root = m_Leftmost = m_Rightmost = makeNode(true);
+			}
+			if (m_Root->count == capacity) {
+				inner* root = allocateNode<inner>();
+				setChild(root, 0, m_Root);
+				m_Root = root;
+				split(root, 0);
+			}
+		}
+
+		static node** children(node* cur) {
+			return static_cast<inner*>(cur)->children;
+		}
+
+		static void setChild(inner* parent, const size_t index, node* child) {
+			parent->children[index] = child;
+			child->parent = parent;
+			child->position = static_cast<uint16_t>(index);
+		}
+
+		// Moves an element to uninitialized storage, leaving from uninitialized
+		static void relocate(TValue* to, TValue* from) {
+			::new (static_cast<void*>(to)) TValue(std::move(*from));
+			from->~TValue();
+		}
+
+		static size_t lowerIndex(const node* cur, const TKey& key) {
+			const TValue* values = cur->values();
+			return std::lower_bound(values, values + cur->count, key, [](const TValue& obj, const TKey& otr) {
+				return TKeyOf{}(obj) < otr;
+			}) - values;
+		}
+
+		static size_t upperIndex(const node* cur, const TKey& key) {
+			const TValue* values = cur->values();
+			return std::upper_bound(values, values + cur->count, key, [](const TKey& otr, const TValue& obj) {
+				return otr < TKeyOf{}(obj);
+			}) - values;
+		}
+
+		// Finds the node and index holding key, the node is null if key is not present
+		std::pair<node*, size_t> locate(const TKey& key) const {
+			node* cur = m_Root;
+			while (cur) {
+				const size_t index = lowerIndex(cur, key);
+				if (index < cur->count && !(key < TKeyOf{}(cur->values()[index]))) {
+					return {cur, index};
+				}
+				if (cur->leaf) break;
+				cur = children(cur)[index];
+			}
+			return {nullptr, 0};
+		}
+
+		// Every element a search lands on in an inner node is a candidate, anything found further down is closer to key
+		std::pair<node*, size_t> bound(const TKey& key, size_t (*search)(const node*, const TKey&)) const {
+			std::pair<node*, size_t> result = {m_Rightmost, m_Rightmost ? m_Rightmost->count : 0};
+			node* cur = m_Root;
+			while (cur) {
+				const size_t index = search(cur, key);
+				if (index < cur->count) {
+					result = {cur, index};
+				}
+				if (cur->leaf) break;
+				cur = children(cur)[index];
+			}
+			return result;
+		}
+
+		// Constructs an element at index, shifting the rest right, cur must have room
+		template <typename... TArgs>
+		void insertAt(node* cur, const size_t index, TArgs&&... args) {
+			TValue* values = cur->values();
+			for (size_t i = cur->count; i > index; --i) {
+				relocate(values + i, values + i - 1);
+			}
+			try {
+				::new (static_cast<void*>(values + index)) TValue(std::forward<TArgs>(args)...);
+			} catch (...) {
+				for (size_t i = index; i < cur->count; ++i) {
+					relocate(values + i, values + i + 1);
+				}
+				throw;
+			}
+			++cur->count;
+		}
+
+		// Splits the full child at index in two, its median moves up into parent between the halves
+		void split(inner* parent, const size_t index) {
+			node* left = parent->children[index];
+			node* right = makeNode(left->leaf);
+			constexpr size_t mid = capacity / 2;
+
+			TValue* leftValues = left->values();
+			for (size_t i = mid + 1; i < capacity; ++i) {
+				relocate(right->values() + i - mid - 1, leftValues + i);
+			}
+			if (!left->leaf) {
+				for (size_t i = mid + 1; i <= capacity; ++i) {
+					setChild(static_cast<inner*>(right), i - mid - 1, children(left)[i]);
+				}
+			}
+			right->count = static_cast<uint16_t>(capacity - mid - 1);
+			left->count = static_cast<uint16_t>(mid);
+
+			TValue* parentValues = parent->values();
+			for (size_t i = parent->count; i > index; --i) {
+				relocate(parentValues + i, parentValues + i - 1);
+				setChild(parent, i + 1, parent->children[i]);
+			}
+			relocate(parentValues + index, leftValues + mid);
+			setChild(parent, index + 1, right);
+			++parent->count;
+
+			if (left == m_Rightmost) {
+				m_Rightmost = right;
+			}
+		}
+
+		// Refills cur if it has too few elements, from a sibling that can spare one, or by merging with a sibling
+		void rebalance(node* cur) {
+			while (cur != m_Root && cur->count < minimum) {
+				inner* parent = static_cast<inner*>(cur->parent);
+				const size_t index = cur->position;
+				if (index > 0 && parent->children[index - 1]->count > minimum) {
+					rotateRight(parent, index - 1);
+					return;
+				}
+				if (index < parent->count && parent->children[index + 1]->count > minimum) {
+					rotateLeft(parent, index);
+					return;
+				}
+				merge(parent, index > 0 ? index - 1 : index);
+				cur = parent;
+			}
+			// An inner root left without elements only has one child, which takes its place
+			if (!m_Root->leaf && m_Root->count == 0) {
+				node* root = children(m_Root)[0];
+				freeNode(m_Root);
+				m_Root = root;
+				m_Root->parent = nullptr;
+				m_Root->position = 0;
+			}
+		}
+
+		// Moves the element at index in parent down to the front of the right child, and the left child's last element up in its place
+		void rotateRight(inner* parent, const size_t index) {
+			node* left = parent->children[index];
+			node* right = parent->children[index + 1];
+			TValue* rightValues = right->values();
+			for (size_t i = right->count; i > 0; --i) {
+				relocate(rightValues + i, rightValues + i - 1);
+			}
+			relocate(rightValues, parent->values() + index);
+			relocate(parent->values() + index, left->values() + left->count - 1);
+			if (!right->leaf) {
+				for (size_t i = right->count + 1; i > 0; --i) {
+					setChild(static_cast<inner*>(right), i, children(right)[i - 1]);
+				}
+				setChild(static_cast<inner*>(right), 0, children(left)[left->count]);
+			}
+			--left->count;
+			++right->count;
+		}
+
+		// Moves the element at index in parent down to the back of the left child, and the right child's first element up in its place
+		void rotateLeft(inner* parent, const size_t index) {
+			node* left = parent->children[index];
+			node* right = parent->children[index + 1];
+			TValue* rightValues = right->values();
+			relocate(left->values() + left->count, parent->values() + index);
+			relocate(parent->values() + index, rightValues);
+			for (size_t i = 1; i < right->count; ++i) {
+				relocate(rightValues + i - 1, rightValues + i);
+			}
+			if (!right->leaf) {
+				setChild(static_cast<inner*>(left), left->count + 1, children(right)[0]);
+				for (size_t i = 0; i < right->count; ++i) {
+					setChild(static_cast<inner*>(right), i, children(right)[i + 1]);
+				}
+			}
+			++left->count;
+			--right->count;
+		}
+
+		// Joins the children either side of the element at index in parent, along with that element, into the left child
+		void merge(inner* parent, const size_t index) {
+			node* left = parent->children[index];
+			node* right = parent->children[index + 1];
+			TValue* leftValues = left->values();
+			relocate(leftValues + left->count, parent->values() + index);
+			for (size_t i = 0; i < right->count; ++i) {
+				relocate(leftValues + left->count + 1 + i, right->values() + i);
+			}
+			if (!left->leaf) {
+				for (size_t i = 0; i <= right->count; ++i) {
+					setChild(static_cast<inner*>(left), left->count + 1 + i, children(right)[i]);
+				}
+			}
+			left->count += right->count + 1;
+
+			TValue* parentValues = parent->values();
+			for (size_t i = index + 1; i < parent->count; ++i) {
+				relocate(parentValues + i - 1, parentValues + i);
+				setChild(parent, i, parent->children[i + 1]);
+			}
+			--parent->count;
+
+			if (right == m_Rightmost) {
+				m_Rightmost = left;
+			}
+			freeNode(right);
+		}
+
+		void copyFrom(const btree& otr) {
+			if (!otr.m_Root) return;
+			m_Root = clone(otr.m_Root, nullptr, 0);
+			m_Size = otr.m_Size;
+			m_Leftmost = m_Rightmost = m_Root;
+			while (!m_Leftmost->leaf) m_Leftmost = children(m_Leftmost)[0];
+			while (!m_Rightmost->leaf) m_Rightmost = children(m_Rightmost)[m_Rightmost->count];
+		}
+
+		node* clone(const node* src, inner* parent, const size_t index) {
+			node* cur = makeNode(src->leaf);
+			if (parent) {
+				setChild(parent, index, cur);
+			}
+			for (size_t i = 0; i < src->count; ++i) {
+				::new (static_cast<void*>(cur->values() + i)) TValue(src->values()[i]);
+			}
+			cur->count = src->count;
+			if (!src->leaf) {
+				for (size_t i = 0; i <= src->count; ++i) {
+					clone(static_cast<const inner*>(src)->children[i], static_cast<inner*>(cur), i);
+				}
+			}
+			return cur;
+		}
+
+		void destroy(node* cur) {
+			if constexpr (!std::is_trivially_destructible_v<TValue>) {
+				for (size_t i = 0; i < cur->count; ++i) {
+					cur->values()[i].~TValue();
+				}
+			}
+			if (!cur->leaf) {
+				for (size_t i = 0; i <= cur->count; ++i) {
+					destroy(children(cur)[i]);
+				}
+			}
+			freeNode(cur);
+		}
+
+		node* m_Root = nullptr;
+
+		// Leaves holding the smallest and largest elements, so begin, end and back do not need to search
+		node* m_Leftmost = nullptr;
+		node* m_Rightmost = nullptr;
+
+		size_t m_Size = 0;
+
+		TAllocator m_Allocator;
+	};
+}
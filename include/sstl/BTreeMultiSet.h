@@ -0,0 +1,257 @@
+﻿#pragma once
+
+#include "BTree.h"
+#include "InitializerList.h"
+
+// Ordered multiset backed by a B-tree, equal elements are kept in the order they were pushed
+// Same interface as TPriorityMultiSet, but pushing or popping invalidates iterators and references
+template <typename TType, typename TAllocator = std::allocator<TType>,
+	std::enable_if_t<sstl::is_less_than_comparable_v<TType>, int> = 0
+>
+struct TBTreeMultiSet : TSingleAssociativeContainer<TType> {
+
+	// Elements are keys, so they cannot be modified in place
+	using iterator = typename sstl::btree<TType, TType, sstl::set_key, TAllocator>::const_iterator;
+	using const_iterator = typename sstl::btree<TType, TType, sstl::set_key, TAllocator>::const_iterator;
+	using reverse_iterator = std::reverse_iterator<const_iterator>;
+	using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+	TBTreeMultiSet() = default;
+
+	explicit TBTreeMultiSet(const TAllocator& allocator): m_Container(allocator) {}
+
+	template <typename TOtherType = TType,
+		std::enable_if_t<std::is_copy_constructible_v<TOtherType>, int> = 0
+	>
+	TBTreeMultiSet(TInitializerList<TType> init) {
+		for (auto& obj : init) {
+			m_Container.emplaceMulti(obj, obj);
+		}
+	}
+
+	template <typename... TArgs,
+		std::enable_if_t<std::conjunction_v<std::is_constructible<TType, TArgs>...>, int> = 0
+	>
+	explicit TBTreeMultiSet(TArgs&&... args) {
+		(emplace(std::forward<TArgs>(args)), ...);
+	}
+
+	[[nodiscard]] virtual size_t getSize() const override {
+		return m_Container.size();
+	}
+
+	[[nodiscard]] TAllocator getAllocator() const {
+		return m_Container.getAllocator();
+	}
+
+	virtual const TType& top() const override {
+		return *m_Container.begin();
+	}
+
+	virtual const TType& bottom() const override {
+		return m_Container.back();
+	}
+
+	virtual bool contains(const TType& obj) const override {
+		return m_Container.contains(obj);
+	}
+
+	virtual bool contains(typename TUnfurled<TType>::Type* obj) const override {
+		if constexpr (sstl::is_managed_v<TType>) {
+			return CONTAINS(m_Container, obj, TUnfurled<TType>::get);
+		} else {
+			return contains(*obj);
+		}
+	}
+
+	virtual void resize(const size_t amt) override {
+		if constexpr (std::is_default_constructible_v<TType>) {
+			for (size_t i = getSize(); i < amt; ++i) {
+				emplace();
+			}
+		} else {
+			throw std::runtime_error("Type is not default constructible!");
+		}
+	}
+
+	virtual void resize(const size_t amt, std::function<TType()> func) override {
+		for (size_t i = getSize(); i < amt; ++i) {
+			emplace(func());
+		}
+	}
+
+	virtual const TType& push() override {
+		if constexpr (std::is_default_constructible_v<TType>) {
+			emplace();
+			return top();
+		} else {
+			throw std::runtime_error("Type is not default constructible!");
+		}
+	}
+
+	virtual void push(const TType& obj) override {
+		if constexpr (std::is_copy_constructible_v<TType>) {
+			m_Container.emplaceMulti(obj, obj);
+		} else {
+			throw std::runtime_error("Type is not copyable!");
+		}
+	}
+
+	virtual void push(TType&& obj) override {
+		if constexpr (std::is_move_constructible_v<TType>) {
+			m_Container.emplaceMulti(obj, std::move(obj));
+		} else {
+			throw std::runtime_error("Type is not moveable!");
+		}
+	}
+
+	// Constructs an element from args, the key has to be compared before there is a slot, so it is built once and moved in
+	// Passing a TType directly skips that, equal elements are always added
+	template <typename... TArgs>
+	const TType& emplace(TArgs&&... args) {
+		if constexpr (sizeof...(TArgs) == 1 && std::conjunction_v<std::is_same<std::decay_t<TArgs>, TType>...>) {
+			return *m_Container.emplaceMulti(args..., std::forward<TArgs>(args)...);
+		} else {
+			TType obj(std::forward<TArgs>(args)...);
+			return *m_Container.emplaceMulti(obj, std::move(obj));
+		}
+	}
+
+	virtual void replace(const TType& tgt, const TType& obj) override {
+		if constexpr (std::is_copy_constructible_v<TType>) {
+			// Since this container is sorted, replacing doesn't need to set at the same index
+			pop(tgt);
+			m_Container.emplaceMulti(obj, obj);
+		} else {
+			throw std::runtime_error("Type is not copyable!");
+		}
+	}
+
+	virtual void replace(const TType& tgt, TType&& obj) override {
+		if constexpr (std::is_move_constructible_v<TType>) {
+			// Since this container is sorted, replacing doesn't need to set at the same index
+			pop(tgt);
+			m_Container.emplaceMulti(obj, std::move(obj));
+		} else {
+			throw std::runtime_error("Type is not moveable!");
+		}
+	}
+
+	virtual void clear() override {
+		m_Container.clear();
+	}
+
+	virtual void pop() override {
+		m_Container.erase(m_Container.begin());
+	}
+
+	// Pops every element equal to obj
+	virtual void pop(const TType& obj) override {
+		m_Container.eraseAll(obj);
+	}
+
+	virtual void pop(typename TUnfurled<TType>::Type* obj) override {
+		if constexpr (sstl::is_managed_v<TType>) {
+			auto itr = FIND(m_Container, obj, TUnfurled<TType>::get);
+			if (itr != m_Container.end()) {
+				m_Container.erase(itr);
+			}
+		} else {
+			pop(*obj);
+		}
+	}
+
+	virtual void transfer(TSingleAssociativeContainer<TType>& otr, TType& obj) override {
+		auto itr = m_Container.find(obj);
+		if (itr == m_Container.end()) return;
+		transferAt(otr, itr);
+	}
+
+	virtual void transfer(TSingleAssociativeContainer<TType>& otr, typename TUnfurled<TType>::Type* obj) override {
+		if constexpr (sstl::is_managed_v<TType>) {
+			auto itr = FIND(m_Container, obj, TUnfurled<TType>::get);
+			if (itr == m_Container.end()) return;
+			transferAt(otr, itr);
+		} else {
+			transfer(otr, *obj);
+		}
+	}
+
+	virtual void forEach(const std::function<void(const TType&)>& func) const override {
+		for (auto itr = m_Container.begin(); itr != m_Container.end(); ++itr) {
+			func(*itr);
+		}
+	}
+
+	// Iterates through each element, accepts any callable so the loop can be inlined
+	template <typename TFunc>
+	void forEach(TFunc&& func) const {
+		for (auto itr = m_Container.begin(); itr != m_Container.end(); ++itr) {
+			func(*itr);
+		}
+	}
+
+	// Gets an iterator to the first element that is not less than obj
+	const_iterator lowerBound(const TType& obj) const {
+		return m_Container.lowerBound(obj);
+	}
+
+	// Gets an iterator to the first element that is greater than obj
+	const_iterator upperBound(const TType& obj) const {
+		return m_Container.upperBound(obj);
+	}
+
+	// Iterates in order through each element from min up to but not including max
+	template <typename TFunc>
+	void forEachInRange(const TType& min, const TType& max, TFunc&& func) const {
+		for (auto itr = m_Container.lowerBound(min); itr != m_Container.end() && *itr < max; ++itr) {
+			func(*itr);
+		}
+	}
+
+	iterator begin() { return m_Container.begin(); }
+
+	const_iterator begin() const { return m_Container.begin(); }
+
+	iterator end() { return m_Container.end(); }
+
+	const_iterator end() const { return m_Container.end(); }
+
+	const_iterator cbegin() const { return m_Container.cbegin(); }
+
+	const_iterator cend() const { return m_Container.cend(); }
+
+	reverse_iterator rbegin() { return reverse_iterator(end()); }
+
+	const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+
+	reverse_iterator rend() { return reverse_iterator(begin()); }
+
+	const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+	const_reverse_iterator crbegin() const { return rbegin(); }
+
+	const_reverse_iterator crend() const { return rend(); }
+
+protected:
+
+	// There are no nodes to extract, so the element is moved out before it is erased
+	template <typename TIterator>
+	void transferAt(TSingleAssociativeContainer<TType>& otr, TIterator itr) {
+		// Prefer move, but copy if not available
+		if constexpr (std::is_move_constructible_v<TType>) {
+			TType obj = std::move(*itr);
+			m_Container.erase(itr);
+			otr.push(std::move(obj));
+		} else {
+			TType obj = *itr;
+			m_Container.erase(itr);
+			otr.push(obj);
+		}
+	}
+
+	sstl::btree<TType, TType, sstl::set_key, TAllocator> m_Container;
+};
+
+template <typename TType, typename... TArgs>
+TBTreeMultiSet(TType, TArgs...) -> TBTreeMultiSet<typename sstl::EnforceConvertible<TType, TArgs...>::Type>;
@@ -0,0 +1,140 @@
+﻿#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#if CXX_VERSION >= 20
+#include <bit>
+#elif defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace sstl {
+
+	// Index of the lowest set bit, mask cannot be 0
+	inline uint32_t countTrailingZeros(const uint32_t mask) {
+#if CXX_VERSION >= 20
+		return static_cast<uint32_t>(std::countr_zero(mask));
+#elif defined(_MSC_VER)
+		unsigned long index;
+		_BitScanForward(&index, mask);
+		return static_cast<uint32_t>(index);
+#else
+		return static_cast<uint32_t>(__builtin_ctz(mask));
+#endif
+	}
+
+	// Index of the lowest set bit, mask cannot be 0
+	inline uint32_t countTrailingZeros(const uint64_t mask) {
+#if CXX_VERSION >= 20
+		return static_cast<uint32_t>(std::countr_zero(mask));
+#elif defined(_MSC_VER)
+		unsigned long index;
+		_BitScanForward64(&index, mask);
+		return static_cast<uint32_t>(index);
+#else
+		return static_cast<uint32_t>(__builtin_ctzll(mask));
+#endif
+	}
+
+	// Number of bits above the highest set bit, mask cannot be 0
+	inline uint32_t countLeadingZeros(const uint64_t mask) {
+#if CXX_VERSION >= 20
+		return static_cast<uint32_t>(std::countl_zero(mask));
+#elif defined(_MSC_VER)
+		unsigned long index;
+		_BitScanReverse64(&index, mask);
+		return static_cast<uint32_t>(63 - index);
+#else
+		return static_cast<uint32_t>(__builtin_clzll(mask));
+#endif
+	}
+
+	inline uint32_t popCount(const uint64_t mask) {
+#if CXX_VERSION >= 20
+		return static_cast<uint32_t>(std::popcount(mask));
+#elif defined(_MSC_VER)
+		return static_cast<uint32_t>(__popcnt64(mask));
+#else
+		return static_cast<uint32_t>(__builtin_popcountll(mask));
+#endif
+	}
+
+	// TSize bits packed into 64 bit words, so a search looks at 64 slots per step instead of one
+	// Bits past TSize in the last word are never set
+	template <size_t TSize>
+	struct bit_array {
+
+		constexpr static size_t words = (TSize + 63) / 64;
+
+		[[nodiscard]] bool test(const size_t index) const {
+			return (m_Words[index / 64] >> (index % 64)) & 1;
+		}
+
+		bool operator[](const size_t index) const {
+			return test(index);
+		}
+
+		void set(const size_t index) {
+			m_Words[index / 64] |= uint64_t(1) << (index % 64);
+		}
+
+		void reset(const size_t index) {
+			m_Words[index / 64] &= ~(uint64_t(1) << (index % 64));
+		}
+
+		// Sets the first amt bits and clears every other one
+		void assign(const size_t amt) {
+			for (size_t word = 0; word < words; ++word) {
+				const size_t start = word * 64;
+				m_Words[word] = amt >= start + 64 ? ~uint64_t(0) : amt > start ? (uint64_t(1) << (amt - start)) - 1 : 0;
+			}
+		}
+
+		[[nodiscard]] size_t count() const {
+			size_t amt = 0;
+			for (const uint64_t word : m_Words) {
+				amt += popCount(word);
+			}
+			return amt;
+		}
+
+		// Index of the first clear bit at or after start, TSize if there is none
+		[[nodiscard]] size_t findClear(const size_t start) const {
+			if (start >= TSize) return TSize;
+			size_t word = start / 64;
+			uint64_t mask = ~m_Words[word] & (~uint64_t(0) << (start % 64));
+			while (mask == 0) {
+				if (++word == words) return TSize;
+				mask = ~m_Words[word];
+			}
+			const size_t index = word * 64 + countTrailingZeros(mask);
+			return index < TSize ? index : TSize;
+		}
+
+		// Index of the last set bit, TSize if there is none
+		[[nodiscard]] size_t findLastSet() const {
+			for (size_t word = words; word > 0; --word) {
+				if (m_Words[word - 1] != 0) {
+					return word * 64 - 1 - countLeadingZeros(m_Words[word - 1]);
+				}
+			}
+			return TSize;
+		}
+
+		// Calls func(index) for every set bit in order, each word is read before its bits are visited, so func can clear them
+		template <typename TFunc>
+		void forEachSet(TFunc&& func) const {
+			for (size_t word = 0; word < words; ++word) {
+				for (uint64_t mask = m_Words[word]; mask != 0; mask &= mask - 1) {
+					func(word * 64 + countTrailingZeros(mask));
+				}
+			}
+		}
+
+	private:
+
+		std::array<uint64_t, words> m_Words{};
+	};
+}
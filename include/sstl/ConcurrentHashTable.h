@@ -0,0 +1,167 @@
+﻿#pragma once
+
+#include <array>
+#include <iterator>
+#include <mutex>
+#include <shared_mutex>
+#include <utility>
+#include <vector>
+#include "FlatHashTable.h"
+#include "Parallel.h"
+
+namespace sstl {
+
+	// Splits keys across TShards flat hash tables, each guarded by its own reader-writer lock
+	// Threads only contend when they touch the same shard, and readers of a shard never block each other
+	// Every shard allocates from a copy of the same TAllocator without a common lock, so it has to be thread safe
+	template <typename TKey, typename TValue, typename TKeyOf, size_t TShards, typename TAllocator = std::allocator<TValue>>
+	struct concurrent_hash_table {
+
+		static_assert(TShards > 0 && (TShards & (TShards - 1)) == 0, "Shard count must be a power of two!");
+
+		using table = flat_hash_table<TKey, TValue, TKeyOf, TAllocator>;
+
+		constexpr static size_t shards = TShards;
+
+		concurrent_hash_table() = default;
+
+		explicit concurrent_hash_table(const TAllocator& allocator): concurrent_hash_table(allocator, std::make_index_sequence<TShards>()) {}
+
+		// Shards hold mutexes, which cannot be copied or moved
+		concurrent_hash_table(const concurrent_hash_table&) = delete;
+		concurrent_hash_table& operator=(const concurrent_hash_table&) = delete;
+
+		// Calls func with the table holding key, while other threads may read that shard but not write to it
+		template <typename TFunc>
+		decltype(auto) read(const TKey& key, TFunc&& func) const {
+			const shard& cur = m_Shards[shardOf(key)];
+			std::shared_lock lock(cur.mtx);
+			return func(static_cast<const table&>(cur.contents));
+		}
+
+		// Calls func with the table holding key, while no other thread can use that shard
+		template <typename TFunc>
+		decltype(auto) write(const TKey& key, TFunc&& func) {
+			shard& cur = m_Shards[shardOf(key)];
+			std::unique_lock lock(cur.mtx);
+			return func(cur.contents);
+		}
+
+		// Calls func with each table in turn, only one shard is locked at a time, so this is not a snapshot
+		template <typename TFunc>
+		void readEach(TFunc&& func) const {
+			for (const shard& cur : m_Shards) {
+				std::shared_lock lock(cur.mtx);
+				func(static_cast<const table&>(cur.contents));
+			}
+		}
+
+		template <typename TFunc>
+		void writeEach(TFunc&& func) {
+			for (shard& cur : m_Shards) {
+				std::unique_lock lock(cur.mtx);
+				func(cur.contents);
+			}
+		}
+
+		// Calls insert(table, element) for every element of [first, last), with each shard filled by a single task
+		// Elements are first sorted into shards in parallel chunks, then every shard is grown once and filled under one lock
+		// Elements that land in the same shard are inserted in the order they appear, so the result does not depend on the pool size
+		template <typename TIterator, typename TInsert>
+		void buildParallel(TIterator first, TIterator last, TInsert&& insert, TThreadPool& pool) {
+			static_assert(std::is_base_of_v<std::random_access_iterator_tag, typename std::iterator_traits<TIterator>::iterator_category>, "Parallel builds need a random access range!");
+			const size_t amt = static_cast<size_t>(last - first);
+			if (amt == 0) return;
+
+			// A fixed grain keeps the chunks, and so the insertion order, the same on any pool
+			constexpr size_t grain = 16384;
+			std::vector<std::array<std::vector<size_t>, TShards>> chunks((amt + grain - 1) / grain);
+			parallelChunks(0, amt, [&](const size_t start, const size_t end) {
+				auto& bins = chunks[start / grain];
+				for (size_t i = start; i < end; ++i) {
+					bins[shardOf(TKeyOf{}(first[i]))].push_back(i);
+				}
+			}, grain, pool);
+
+			parallelFor(0, TShards, [&](const size_t index) {
+				size_t count = 0;
+				for (const auto& bins : chunks) count += bins[index].size();
+				if (count == 0) return;
+				shard& cur = m_Shards[index];
+				std::unique_lock lock(cur.mtx);
+				cur.contents.reserve(cur.contents.size() + count);
+				for (const auto& bins : chunks) {
+					for (const size_t i : bins[index]) {
+						insert(cur.contents, first[i]);
+					}
+				}
+			}, 1, pool);
+		}
+
+		// Moves every element of otr whose key is not present here into this table, one task per shard
+		// Both tables split keys the same way, so shard i only ever exchanges elements with shard i of otr
+		void mergeParallel(concurrent_hash_table& otr, TThreadPool& pool) {
+			if (&otr == this) return;
+			parallelFor(0, TShards, [&](const size_t index) {
+				shard& cur = m_Shards[index];
+				shard& other = otr.m_Shards[index];
+				std::scoped_lock lock(cur.mtx, other.mtx);
+				cur.contents.reserve(cur.contents.size() + other.contents.size());
+				for (auto itr = other.contents.begin(); itr != other.contents.end();) {
+					// tryEmplace leaves the element untouched if the key is already here, so it can stay in otr
+					if (cur.contents.tryEmplace(TKeyOf{}(*itr), std::move(*itr)).second) {
+						itr = other.contents.erase(itr);
+					} else {
+						++itr;
+					}
+				}
+			}, 1, pool);
+		}
+
+		[[nodiscard]] size_t size() const {
+			size_t size = 0;
+			readEach([&](const table& cur) { size += cur.size(); });
+			return size;
+		}
+
+		// Shards never change their allocator, so this does not need a lock
+		[[nodiscard]] TAllocator getAllocator() const {
+			return m_Shards[0].contents.getAllocator();
+		}
+
+	protected:
+
+		// Each shard gets its own cache line, so locking one does not slow down threads working on its neighbours
+		struct alignas(64) shard {
+
+			shard() = default;
+
+			explicit shard(const TAllocator& allocator): contents(allocator) {}
+
+			mutable std::shared_mutex mtx;
+			table contents;
+		};
+
+		// Shards cannot be moved, so each one is constructed in place with the allocator
+		template <size_t... TIndices>
+		concurrent_hash_table(const TAllocator& allocator, std::index_sequence<TIndices...>): m_Shards{((void)TIndices, shard(allocator))...} {}
+
+		// The tables pick groups from the low bits of their own hash, so the shard is taken from the high bits
+		static size_t shardOf(const TKey& key) {
+			if constexpr (TShards == 1) {
+				return 0;
+			} else {
+				const uint64_t hash = static_cast<uint64_t>(hasher<TKey>{}(key)) * 0x9E3779B97F4A7C15ull;
+				return static_cast<size_t>(hash >> (64 - shardBits()));
+			}
+		}
+
+		constexpr static size_t shardBits() {
+			size_t bits = 0;
+			while ((size_t{1} << bits) < TShards) ++bits;
+			return bits;
+		}
+
+		shard m_Shards[TShards];
+	};
+}
@@ -0,0 +1,191 @@
+﻿#pragma once
+
+#include <optional>
+#include <tuple>
+#include "ConcurrentHashTable.h"
+#include "InitializerList.h"
+
+// Map that can be used from many threads at once, keys are spread over TShards flat tables with a reader-writer lock each
+// Unlike TThreadSafe<TMap>, threads only wait on each other when their keys land in the same shard, and readers never wait on readers
+// A reference into the map could be invalidated by another thread as soon as its shard is unlocked, so values are copied out or used through a callable
+template <typename TKeyType, typename TValueType, size_t TShards = 64, typename TAllocator = std::allocator<std::pair<TKeyType, TValueType>>,
+	std::enable_if_t<sstl::is_hashable_v<TKeyType>, int> = 0
+>
+struct TConcurrentMap {
+
+	using table = typename sstl::concurrent_hash_table<TKeyType, std::pair<TKeyType, TValueType>, sstl::map_key, TShards, TAllocator>::table;
+
+	TConcurrentMap() = default;
+
+	// The allocator is shared by every shard, so it has to be thread safe, like std::pmr::synchronized_pool_resource
+	explicit TConcurrentMap(const TAllocator& allocator): m_Container(allocator) {}
+
+	template <typename TOtherValueType = TValueType,
+		std::enable_if_t<std::is_copy_constructible_v<TOtherValueType>, int> = 0
+	>
+	TConcurrentMap(TInitializerList<TPair<TKeyType, TValueType>> init) {
+		for (auto& pair : init) {
+			emplace(pair.first(), pair.second());
+		}
+	}
+
+	// Only exact while no other thread is pushing or popping
+	[[nodiscard]] size_t getSize() const {
+		return m_Container.size();
+	}
+
+	[[nodiscard]] TAllocator getAllocator() const {
+		return m_Container.getAllocator();
+	}
+
+	bool contains(const TKeyType& key) const {
+		return m_Container.read(key, [&](const table& cur) {
+			return cur.contains(key);
+		});
+	}
+
+	// Gets a copy of the value at key
+	TValueType get(const TKeyType& key) const {
+		return m_Container.read(key, [&](const table& cur) {
+			auto itr = cur.find(key);
+			if (itr == cur.end()) {
+				throw std::out_of_range("Key is not in the container!");
+			}
+			return itr->second;
+		});
+	}
+
+	// Copies the value at key into out, returns false and leaves out untouched if key is not present
+	bool tryGet(const TKeyType& key, TValueType& out) const {
+		return m_Container.read(key, [&](const table& cur) {
+			auto itr = cur.find(key);
+			if (itr == cur.end()) return false;
+			out = itr->second;
+			return true;
+		});
+	}
+
+	// Pushes value if key is not present yet, returns if it was pushed
+	bool push(const TKeyType& key, const TValueType& value) {
+		return emplace(key, value);
+	}
+
+	bool push(const TKeyType& key, TValueType&& value) {
+		return emplace(key, std::move(value));
+	}
+
+	// Constructs the value in place from args if key is not present yet, returns if it was constructed
+	template <typename... TArgs>
+	bool emplace(const TKeyType& key, TArgs&&... args) {
+		return m_Container.write(key, [&](table& cur) {
+			return cur.tryEmplace(key, std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple(std::forward<TArgs>(args)...)).second;
+		});
+	}
+
+	// Sets the value at key, pushing it if key is not present yet
+	void replace(const TKeyType& key, const TValueType& value) {
+		m_Container.write(key, [&](table& cur) {
+			auto [itr, pushed] = cur.tryEmplace(key, std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple(value));
+			if (!pushed) itr->second = value;
+		});
+	}
+
+	void replace(const TKeyType& key, TValueType&& value) {
+		m_Container.write(key, [&](table& cur) {
+			// tryEmplace leaves value untouched if key is already present, so it can still be moved from after
+			auto [itr, pushed] = cur.tryEmplace(key, std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple(std::move(value)));
+			if (!pushed) itr->second = std::move(value);
+		});
+	}
+
+	// Gets a copy of the value at key, if key is not present func() is pushed first
+	// func is called with the shard locked, so it runs at most once per key even if many threads ask at the same time
+	template <typename TFunc>
+	TValueType computeIfAbsent(const TKeyType& key, TFunc&& func) {
+		// Most calls find the key, which only needs a read lock
+		std::optional<TValueType> found = m_Container.read(key, [&](const table& cur) -> std::optional<TValueType> {
+			auto itr = cur.find(key);
+			if (itr == cur.end()) return std::nullopt;
+			return itr->second;
+		});
+		if (found) return std::move(*found);
+		return m_Container.write(key, [&](table& cur) {
+			auto itr = cur.find(key);
+			if (itr == cur.end()) {
+				itr = cur.tryEmplace(key, std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple(func())).first;
+			}
+			return itr->second;
+		});
+	}
+
+	// Pushes every std::pair of [first, last) whose key is not present yet, each shard is filled by one task on pool
+	// Much faster than pushing one at a time for large ranges, since every shard is locked and grown only once
+	template <typename TIterator>
+	void pushRange(TIterator first, TIterator last, TThreadPool& pool = TThreadPool::get()) {
+		m_Container.buildParallel(first, last, [](table& cur, auto&& pair) {
+			cur.tryEmplace(pair.first, std::forward<decltype(pair)>(pair));
+		}, pool);
+	}
+
+	// Pushes every pair of another container or range, pairs are moved out if it is an rvalue
+	template <typename TRange>
+	void pushRange(TRange&& range, TThreadPool& pool = TThreadPool::get()) {
+		if constexpr (std::is_rvalue_reference_v<TRange&&>) {
+			pushRange(std::make_move_iterator(range.begin()), std::make_move_iterator(range.end()), pool);
+		} else {
+			pushRange(range.begin(), range.end(), pool);
+		}
+	}
+
+	// Moves every pair of otr whose key is not present yet into this map, pairs whose key is stay in otr
+	// Each pair of matching shards is merged by one task on pool
+	void merge(TConcurrentMap& otr, TThreadPool& pool = TThreadPool::get()) {
+		m_Container.mergeParallel(otr.m_Container, pool);
+	}
+
+	// Pops the pair at key, returns if it was present
+	bool pop(const TKeyType& key) {
+		return m_Container.write(key, [&](table& cur) {
+			return cur.erase(key) != 0;
+		});
+	}
+
+	void clear() {
+		m_Container.writeEach([](table& cur) { cur.clear(); });
+	}
+
+	// Calls func with the value at key while its shard is locked, returns false if key is not present
+	template <typename TFunc>
+	bool doFor(const TKeyType& key, TFunc&& func) {
+		return m_Container.write(key, [&](table& cur) {
+			auto itr = cur.find(key);
+			if (itr == cur.end()) return false;
+			func(itr->second);
+			return true;
+		});
+	}
+
+	template <typename TFunc>
+	bool doFor(const TKeyType& key, TFunc&& func) const {
+		return m_Container.read(key, [&](const table& cur) {
+			auto itr = cur.find(key);
+			if (itr == cur.end()) return false;
+			func(static_cast<const TValueType&>(itr->second));
+			return true;
+		});
+	}
+
+	// Iterates through each element, one shard at a time, pairs pushed or popped by other threads meanwhile may or may not be seen
+	template <typename TFunc>
+	void forEach(TFunc&& func) const {
+		m_Container.readEach([&](const table& cur) {
+			for (auto itr = cur.begin(); itr != cur.end(); ++itr) {
+				func(TPair<TKeyType, const TValueType&>{itr->first, itr->second});
+			}
+		});
+	}
+
+protected:
+
+	sstl::concurrent_hash_table<TKeyType, std::pair<TKeyType, TValueType>, sstl::map_key, TShards, TAllocator> m_Container;
+};
@@ -0,0 +1,266 @@
+﻿#pragma once
+
+#include <atomic>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include "Threading.h"
+
+// Bounded first in first out queue that many threads can push to and pop from at once without locking (Dmitry Vyukov's ring)
+// Unlike TThreadSafe<TQueue>, producers only contend with producers and consumers with consumers, through a single compare and swap each
+// Capacity is fixed on construction and rounded up to a power of two, pushing to a full queue fails instead of growing it
+// Another thread could pop the top element at any time, so there is no top() or get(), elements are moved out through pop instead
+template <typename TType>
+struct TConcurrentQueue {
+
+	// A slot is claimed before the element is moved in or out of it, and a throw in between would leave the slot unpublished and stall the queue for good
+	static_assert(std::is_nothrow_move_constructible_v<TType> && std::is_nothrow_move_assignable_v<TType>, "Concurrent queue elements must be nothrow move constructible and move assignable!");
+
+	explicit TConcurrentQueue(const size_t capacity = 1024)
+	: m_Mask(roundCapacity(capacity) - 1),
+	  m_Slots(new slot[m_Mask + 1]) {
+		for (size_t i = 0; i <= m_Mask; ++i) {
+			m_Slots[i].sequence.store(i, std::memory_order_relaxed);
+		}
+	}
+
+	// Other threads may hold positions in the ring, so it cannot be copied or moved
+	TConcurrentQueue(const TConcurrentQueue&) = delete;
+	TConcurrentQueue& operator=(const TConcurrentQueue&) = delete;
+
+	~TConcurrentQueue() {
+		clear();
+		delete[] m_Slots;
+	}
+
+	[[nodiscard]] size_t getCapacity() const {
+		return m_Mask + 1;
+	}
+
+	// Only exact while no other thread is pushing or popping
+	[[nodiscard]] size_t getSize() const {
+		const size_t head = m_Head.position.load(std::memory_order_acquire);
+		const size_t tail = m_Tail.position.load(std::memory_order_acquire);
+		return tail > head ? tail - head : 0;
+	}
+
+	// Constructs an element from args at the back, returns false if the queue is full
+	// Unless that construction cannot throw, the element is built before a slot is claimed and then moved in
+	template <typename... TArgs>
+	bool tryEmplace(TArgs&&... args) {
+		if constexpr (!std::is_nothrow_constructible_v<TType, TArgs&&...>) {
+			TType obj(std::forward<TArgs>(args)...);
+			return tryEmplace(std::move(obj));
+		}
+		size_t position = m_Tail.position.load(std::memory_order_relaxed);
+		while (true) {
+			slot& cur = m_Slots[position & m_Mask];
+			const size_t sequence = cur.sequence.load(std::memory_order_acquire);
+			if (sequence == position) {
+				// Slot is free for this lap, claim it before another producer does
+				if (m_Tail.position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+					new (cur.get()) TType(std::forward<TArgs>(args)...);
+					cur.sequence.store(position + 1, std::memory_order_release);
+					return true;
+				}
+			} else if (sequence < position) {
+				// A consumer has not popped the element from the last lap yet, so the queue is full
+				return false;
+			} else {
+				position = m_Tail.position.load(std::memory_order_relaxed);
+			}
+		}
+	}
+
+	bool tryPush(const TType& obj) {
+		return tryEmplace(obj);
+	}
+
+	bool tryPush(TType&& obj) {
+		return tryEmplace(std::move(obj));
+	}
+
+	// Moves the front element into out, returns false and leaves out untouched if the queue is empty
+	bool tryPop(TType& out) {
+		size_t position = m_Head.position.load(std::memory_order_relaxed);
+		while (true) {
+			slot& cur = m_Slots[position & m_Mask];
+			const size_t sequence = cur.sequence.load(std::memory_order_acquire);
+			if (sequence == position + 1) {
+				if (m_Head.position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+					out = std::move(*cur.get());
+					cur.get()->~TType();
+					// Hands the slot back to producers for the next lap
+					cur.sequence.store(position + m_Mask + 1, std::memory_order_release);
+					return true;
+				}
+			} else if (sequence < position + 1) {
+				// The producer for this position has not finished, so the queue is empty
+				return false;
+			} else {
+				position = m_Head.position.load(std::memory_order_relaxed);
+			}
+		}
+	}
+
+	// Waits for space if the queue is full
+	void push(const TType& obj) {
+		for (uint32_t spins = 0; !tryPush(obj); ++spins) {
+			backoff(spins);
+		}
+	}
+
+	void push(TType&& obj) {
+		for (uint32_t spins = 0; !tryPush(std::move(obj)); ++spins) {
+			backoff(spins);
+		}
+	}
+
+	// Waits for an element if the queue is empty
+	void pop(TType& out) {
+		for (uint32_t spins = 0; !tryPop(out); ++spins) {
+			backoff(spins);
+		}
+	}
+
+	// Pushes as many elements of [first, last) as fit, returns how many were pushed
+	// Runs of free slots are claimed with a single compare and swap, so producers contend once per batch instead of once per element
+	template <typename TIterator>
+	size_t pushRange(TIterator first, TIterator last) {
+		size_t pushed = 0;
+		// Elements that could throw while being built are built one at a time before their slot is claimed
+		if constexpr (!std::is_nothrow_constructible_v<TType, decltype(*first)>) {
+			for (; first != last && tryEmplace(*first); ++first) {
+				++pushed;
+			}
+			return pushed;
+		}
+		while (first != last) {
+			size_t position = m_Tail.position.load(std::memory_order_relaxed);
+			const size_t wanted = static_cast<size_t>(std::distance(first, last));
+			size_t count = 0;
+			bool full = false;
+			// Only the producer that moves the tail past a slot can fill it, so slots seen free here stay free until the swap
+			while (count < wanted && count <= m_Mask) {
+				const size_t sequence = m_Slots[(position + count) & m_Mask].sequence.load(std::memory_order_acquire);
+				if (sequence != position + count) {
+					full = sequence < position + count;
+					break;
+				}
+				++count;
+			}
+			if (count == 0) {
+				if (full) break;
+				continue;
+			}
+			if (!m_Tail.position.compare_exchange_weak(position, position + count, std::memory_order_relaxed)) continue;
+			for (size_t i = 0; i < count; ++i, ++first) {
+				slot& cur = m_Slots[(position + i) & m_Mask];
+				new (cur.get()) TType(*first);
+				cur.sequence.store(position + i + 1, std::memory_order_release);
+			}
+			pushed += count;
+		}
+		return pushed;
+	}
+
+	// Pushes as many elements of another container or range as fit, elements are moved out if it is an rvalue
+	template <typename TRange>
+	size_t pushRange(TRange&& range) {
+		if constexpr (std::is_rvalue_reference_v<TRange&&>) {
+			return pushRange(std::make_move_iterator(range.begin()), std::make_move_iterator(range.end()));
+		} else {
+			return pushRange(range.begin(), range.end());
+		}
+	}
+
+	// Pops up to amt elements from the front and passes each to func in order, returns how many were popped
+	// Like pushRange, runs of filled slots are claimed with a single compare and swap
+	// If func throws, the rest of the claimed run is destroyed and handed back to producers before the exception is passed on
+	template <typename TFunc>
+	size_t popRange(const size_t amt, TFunc&& func) {
+		size_t popped = 0;
+		while (popped < amt) {
+			size_t position = m_Head.position.load(std::memory_order_relaxed);
+			size_t count = 0;
+			bool empty = false;
+			while (popped + count < amt && count <= m_Mask) {
+				const size_t sequence = m_Slots[(position + count) & m_Mask].sequence.load(std::memory_order_acquire);
+				if (sequence != position + count + 1) {
+					empty = sequence < position + count + 1;
+					break;
+				}
+				++count;
+			}
+			if (count == 0) {
+				if (empty) break;
+				continue;
+			}
+			if (!m_Head.position.compare_exchange_weak(position, position + count, std::memory_order_relaxed)) continue;
+			for (size_t i = 0; i < count; ++i) {
+				slot& cur = m_Slots[(position + i) & m_Mask];
+				try {
+					func(std::move(*cur.get()));
+				} catch (...) {
+					for (size_t j = i; j < count; ++j) {
+						slot& rest = m_Slots[(position + j) & m_Mask];
+						rest.get()->~TType();
+						rest.sequence.store(position + j + m_Mask + 1, std::memory_order_release);
+					}
+					throw;
+				}
+				cur.get()->~TType();
+				cur.sequence.store(position + i + m_Mask + 1, std::memory_order_release);
+			}
+			popped += count;
+		}
+		return popped;
+	}
+
+	// Pops up to amt elements into the back of a container with push, returns how many were popped
+	template <typename TContainer>
+	size_t transferRange(TContainer& otr, const size_t amt) {
+		return popRange(amt, [&](TType&& obj) { otr.push(std::move(obj)); });
+	}
+
+	// Pops every element present, elements pushed by other threads meanwhile may or may not be popped
+	void clear() {
+		popRange(getCapacity(), [](TType&&) {});
+	}
+
+protected:
+
+	// Padded to its own cache line, so producers moving the tail do not slow down consumers moving the head
+	struct alignas(64) counter {
+		std::atomic<size_t> position = 0;
+	};
+
+	// The sequence says whose turn it is, position when free for a producer, position + 1 when filled for a consumer
+	struct slot {
+		std::atomic<size_t> sequence;
+		alignas(TType) unsigned char storage[sizeof(TType)];
+
+		TType* get() { return std::launder(reinterpret_cast<TType*>(storage)); }
+	};
+
+	static size_t roundCapacity(const size_t capacity) {
+		size_t rounded = 2;
+		while (rounded < capacity) rounded <<= 1;
+		return rounded;
+	}
+
+	static void backoff(const uint32_t spins) {
+		if (spins < 64) {
+			sstl::cpuRelax();
+		} else {
+			std::this_thread::yield();
+		}
+	}
+
+	counter m_Head;
+	counter m_Tail;
+
+	const size_t m_Mask;
+
+	slot* m_Slots;
+};
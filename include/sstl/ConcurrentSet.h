@@ -0,0 +1,106 @@
+﻿#pragma once
+
+#include "ConcurrentHashTable.h"
+#include "InitializerList.h"
+
+// Set that can be used from many threads at once, elements are spread over TShards flat tables with a reader-writer lock each
+// Unlike TThreadSafe<TSet>, threads only wait on each other when their elements land in the same shard, and readers never wait on readers
+template <typename TType, size_t TShards = 64, typename TAllocator = std::allocator<TType>,
+	std::enable_if_t<sstl::is_hashable_v<TType>, int> = 0
+>
+struct TConcurrentSet {
+
+	using table = typename sstl::concurrent_hash_table<TType, TType, sstl::set_key, TShards, TAllocator>::table;
+
+	TConcurrentSet() = default;
+
+	// The allocator is shared by every shard, so it has to be thread safe, like std::pmr::synchronized_pool_resource
+	explicit TConcurrentSet(const TAllocator& allocator): m_Container(allocator) {}
+
+	template <typename TOtherType = TType,
+		std::enable_if_t<std::is_copy_constructible_v<TOtherType>, int> = 0
+	>
+	TConcurrentSet(TInitializerList<TType> init) {
+		for (auto& obj : init) {
+			push(obj);
+		}
+	}
+
+	// Only exact while no other thread is pushing or popping
+	[[nodiscard]] size_t getSize() const {
+		return m_Container.size();
+	}
+
+	[[nodiscard]] TAllocator getAllocator() const {
+		return m_Container.getAllocator();
+	}
+
+	bool contains(const TType& obj) const {
+		return m_Container.read(obj, [&](const table& cur) {
+			return cur.contains(obj);
+		});
+	}
+
+	// Pushes obj if it is not present yet, returns if it was pushed
+	bool push(const TType& obj) {
+		return m_Container.write(obj, [&](table& cur) {
+			return cur.tryEmplace(obj, obj).second;
+		});
+	}
+
+	bool push(TType&& obj) {
+		return m_Container.write(obj, [&](table& cur) {
+			return cur.tryEmplace(obj, std::move(obj)).second;
+		});
+	}
+
+	// Pushes every element of [first, last) that is not present yet, each shard is filled by one task on pool
+	// Much faster than pushing one at a time for large ranges, since every shard is locked and grown only once
+	template <typename TIterator>
+	void pushRange(TIterator first, TIterator last, TThreadPool& pool = TThreadPool::get()) {
+		m_Container.buildParallel(first, last, [](table& cur, auto&& obj) {
+			cur.tryEmplace(obj, std::forward<decltype(obj)>(obj));
+		}, pool);
+	}
+
+	// Pushes every element of another container or range, elements are moved out if it is an rvalue
+	template <typename TRange>
+	void pushRange(TRange&& range, TThreadPool& pool = TThreadPool::get()) {
+		if constexpr (std::is_rvalue_reference_v<TRange&&>) {
+			pushRange(std::make_move_iterator(range.begin()), std::make_move_iterator(range.end()), pool);
+		} else {
+			pushRange(range.begin(), range.end(), pool);
+		}
+	}
+
+	// Moves every element of otr that is not present yet into this set, elements that are stay in otr
+	// Each pair of matching shards is merged by one task on pool
+	void merge(TConcurrentSet& otr, TThreadPool& pool = TThreadPool::get()) {
+		m_Container.mergeParallel(otr.m_Container, pool);
+	}
+
+	// Pops obj, returns if it was present
+	bool pop(const TType& obj) {
+		return m_Container.write(obj, [&](table& cur) {
+			return cur.erase(obj) != 0;
+		});
+	}
+
+	void clear() {
+		m_Container.writeEach([](table& cur) { cur.clear(); });
+	}
+
+	// Iterates through each element, one shard at a time, elements pushed or popped by other threads meanwhile may or may not be seen
+	template <typename TFunc>
+	void forEach(TFunc&& func) const {
+		m_Container.readEach([&](const table& cur) {
+			for (auto itr = cur.begin(); itr != cur.end(); ++itr) {
+				func(*itr);
+			}
+		});
+	}
+
+protected:
+
+	sstl::concurrent_hash_table<TType, TType, sstl::set_key, TShards, TAllocator> m_Container;
+};
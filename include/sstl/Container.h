@@ -89,6 +89,61 @@ namespace sstl {
 	template <typename TType>
 	constexpr bool is_hashable_v = is_hashable<TType>::value;
 #endif
+
+	// Hashes any type with a getHash function, used by the hashed containers
+	template <typename TType>
+	struct hasher {
+		size_t operator()(const TType& obj) const noexcept {
+			return getHash(obj);
+		}
+	};
+
+	// Gets the key of an element stored in a set, which is the element itself
+	struct set_key {
+		template <typename TType>
+		const TType& operator()(const TType& obj) const { return obj; }
+	};
+
+	// Gets the key of an element stored in a map, maps store a std::pair with the key first
+	struct map_key {
+		template <typename TPairType>
+		const typename TPairType::first_type& operator()(const TPairType& pair) const { return pair.first; }
+	};
+
+	// The static interface shared by every sequence container, used to write generic code without TSequenceContainer
+#if CXX_VERSION >= 20
+	template <typename TContainer>
+	concept is_sequence_container_v = requires(TContainer& c, const TContainer& cc, size_t index) {
+		{cc.getSize()} -> std::convertible_to<size_t>;
+		c.top();
+		c.get(index);
+		c.push();
+		c.pop();
+		c.clear();
+	};
+
+	template <typename TContainer>
+	struct is_sequence_container : std::bool_constant<is_sequence_container_v<TContainer>> {};
+#else
+	template <typename TContainer, typename = void>
+	struct is_sequence_container : std::false_type {};
+
+	template <typename TContainer>
+	struct is_sequence_container
+	<TContainer,
+		std::void_t<
+			decltype(std::declval<const TContainer&>().getSize()),
+			decltype(std::declval<TContainer&>().top()),
+			decltype(std::declval<TContainer&>().get(std::declval<size_t>())),
+			decltype(std::declval<TContainer&>().push()),
+			decltype(std::declval<TContainer&>().pop()),
+			decltype(std::declval<TContainer&>().clear())
+		>
+	> : std::true_type {};
+
+	template <typename TContainer>
+	constexpr bool is_sequence_container_v = is_sequence_container<TContainer>::value;
+#endif
 }
 
 // A basic container of any amount of objects
@@ -200,6 +255,17 @@ struct TSequenceContainer {
 	// Version of pop that guarantees raw pointer input
 	virtual void pop(typename TUnfurled<TType>::Type* obj)
 		GUARANTEED
+	// Removes the bottommost element from the container, containers that can do this in O(1) override it
+	virtual void popBack() {
+		pop(getSize() - 1);
+	}
+
+	// Removes every element in the range [start, end)
+	virtual void popRange(const size_t start, const size_t end) {
+		for (size_t i = start; i < end; ++i) {
+			pop(start);
+		}
+	}
 
 	// Moves an object at index from this to container otr
 	virtual void transfer(TSequenceContainer& otr, const size_t index) {
@@ -213,6 +279,21 @@ struct TSequenceContainer {
 		pop(index);
 	}
 
+	// Moves every object in the range [start, end) from this to container otr
+	// Containers override this to move the whole range at once when otr is the same kind of container
+	virtual void transferRange(TSequenceContainer& otr, const size_t start, const size_t end) {
+		for (size_t i = start; i < end; ++i) {
+			// Prefer move, but copy if not available
+			auto& obj = get(i);
+			if constexpr (std::is_move_constructible_v<TType>) {
+				otr.push(std::move(obj));
+			} else {
+				otr.push(obj);
+			}
+		}
+		popRange(start, end);
+	}
+
 	virtual void doFor(const size_t index, const std::function<void(TType&)>& func) {
 		func(get(index));
 	}
@@ -422,4 +503,19 @@ struct TSingleAssociativeContainer {
 	// Iterates through each element
 	virtual void forEach(const std::function<void(const TType&)>& func) const
 		GUARANTEED
-};
\ No newline at end of file
+};
+
+// Statically dispatched version of any container
+// Since it is final, the compiler knows every call resolves to TContainer, so nothing goes through the virtual table and calls can be inlined
+// It is still a TContainer, so it can be passed anywhere a TSequenceContainer or other type-erased view is expected
+template <typename TContainer>
+struct TStatic final : TContainer {
+
+	using TContainer::TContainer;
+
+	TStatic() = default;
+
+	TStatic(const TContainer& container): TContainer(container) {}
+
+	TStatic(TContainer&& container): TContainer(std::move(container)) {}
+};
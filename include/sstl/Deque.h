@@ -3,12 +3,20 @@
 #include <deque>
 #include "Container.h"
 #include "InitializerList.h"
+#include "Sort.h"
 
-template <typename TType>
+template <typename TType, typename TAllocator = std::allocator<TType>>
 struct TDeque : TSequenceContainer<TType> {
 
+	using iterator = typename std::deque<TType, TAllocator>::iterator;
+	using const_iterator = typename std::deque<TType, TAllocator>::const_iterator;
+	using reverse_iterator = typename std::deque<TType, TAllocator>::reverse_iterator;
+	using const_reverse_iterator = typename std::deque<TType, TAllocator>::const_reverse_iterator;
+
 	TDeque() = default;
 
+	explicit TDeque(const TAllocator& allocator): m_Container(allocator) {}
+
 	template <typename TOtherType = TType,
 		std::enable_if_t<std::is_copy_constructible_v<TOtherType>, int> = 0
 	>
@@ -25,6 +33,10 @@ struct TDeque : TSequenceContainer<TType> {
 		return m_Container.size();
 	}
 
+	[[nodiscard]] TAllocator getAllocator() const {
+		return m_Container.get_allocator();
+	}
+
 	virtual TType& top() override {
 		return m_Container.front();
 	}
@@ -141,6 +153,34 @@ struct TDeque : TSequenceContainer<TType> {
 		}
 	}
 
+	// Adds every element in [first, last), memory is only reserved once when the distance is known
+	template <typename TIterator>
+	void pushRange(TIterator first, TIterator last) {
+		m_Container.insert(m_Container.end(), first, last);
+	}
+
+	// Adds every element of another container or range, elements are moved out if it is an rvalue
+	template <typename TRange>
+	void pushRange(TRange&& range) {
+		if constexpr (std::is_rvalue_reference_v<TRange&&>) {
+			pushRange(std::make_move_iterator(range.begin()), std::make_move_iterator(range.end()));
+		} else {
+			pushRange(range.begin(), range.end());
+		}
+	}
+
+	// Constructs an element in place from args, no temporary TType is made
+	template <typename... TArgs>
+	TType& emplace(TArgs&&... args) {
+		return m_Container.emplace_back(std::forward<TArgs>(args)...);
+	}
+
+	// Constructs an element in place at index from args
+	template <typename... TArgs>
+	TType& emplaceAt(const size_t index, TArgs&&... args) {
+		return *m_Container.emplace(m_Container.begin() + index, std::forward<TArgs>(args)...);
+	}
+
 	virtual void replace(const size_t index, const TType& obj) override {
 		if constexpr (std::is_copy_constructible_v<TType>) {
 			pop(index);
@@ -167,6 +207,11 @@ struct TDeque : TSequenceContainer<TType> {
 		pop(static_cast<size_t>(0));
 	}
 
+	// Removes the last element in O(1)
+	virtual void popBack() override {
+		m_Container.pop_back();
+	}
+
 	virtual void pop(const size_t index) override {
 		m_Container.erase(m_Container.begin() + index);
 	}
@@ -188,6 +233,58 @@ struct TDeque : TSequenceContainer<TType> {
 		}
 	}
 
+	virtual void popRange(const size_t start, const size_t end) override {
+		m_Container.erase(m_Container.begin() + start, m_Container.begin() + end);
+	}
+
+	// Moves the whole range at once if otr is a TDeque, derived containers keep their own ordering through transferIn
+	virtual void transferRange(TSequenceContainer<TType>& otr, const size_t start, const size_t end) override {
+		// The elements would be inserted from the range that is being removed, and they are already here anyway
+		if (&otr == this) return;
+		if (auto otrDeque = dynamic_cast<TDeque*>(&otr)) {
+			otrDeque->transferIn(m_Container.begin() + start, m_Container.begin() + end);
+			popRange(start, end);
+			return;
+		}
+		TSequenceContainer<TType>::transferRange(otr, start, end);
+	}
+
+	// Sorts by comp on the calling thread, integers and floats compared with std::less are radix sorted
+	template <typename TCompare = std::less<TType>>
+	void sort(TCompare comp = {}) {
+		sstl::sort(m_Container.begin(), m_Container.end(), comp);
+	}
+
+	// Splits large containers across pool, ParallelSort.h has to be included to use it
+	template <typename TCompare>
+	void sort(TCompare comp, TThreadPool& pool) {
+		sstl::sort(m_Container.begin(), m_Container.end(), comp, pool);
+	}
+
+	// Like sort, but equal elements keep their order
+	template <typename TCompare = std::less<TType>>
+	void stableSort(TCompare comp = {}) {
+		sstl::stableSort(m_Container.begin(), m_Container.end(), comp);
+	}
+
+	template <typename TCompare>
+	void stableSort(TCompare comp, TThreadPool& pool) {
+		sstl::stableSort(m_Container.begin(), m_Container.end(), comp, pool);
+	}
+
+	// Sorts only the amt smallest elements into the front, the rest are left in no particular order
+	template <typename TCompare = std::less<TType>>
+	void partialSort(const size_t amt, TCompare comp = {}) {
+		std::partial_sort(m_Container.begin(), m_Container.begin() + std::min(amt, getSize()), m_Container.end(), comp);
+	}
+
+	// Puts the element that belongs at index after sorting there, with nothing after it smaller and nothing before it larger
+	// Does nothing if index is past the end, the same way partialSort clamps amt
+	template <typename TCompare = std::less<TType>>
+	void nthElement(const size_t index, TCompare comp = {}) {
+		std::nth_element(m_Container.begin(), m_Container.begin() + std::min(index, getSize()), m_Container.end(), comp);
+	}
+
 	virtual void forEach(const std::function<void(size_t, TType&)>& func) override {
 		size_t i = 0;
 		for (auto itr = m_Container.begin(); itr != m_Container.end(); ++itr, ++i) {
@@ -216,9 +313,98 @@ struct TDeque : TSequenceContainer<TType> {
 		}
 	}
 
+	// Iterates through each element, accepts any callable so the loop can be inlined
+	template <typename TFunc>
+	void forEach(TFunc&& func) {
+		size_t i = 0;
+		for (auto itr = m_Container.begin(); itr != m_Container.end(); ++itr, ++i) {
+			func(i, *itr);
+		}
+	}
+
+	// Iterates through each element, const version
+	template <typename TFunc>
+	void forEach(TFunc&& func) const {
+		size_t i = 0;
+		for (auto itr = m_Container.begin(); itr != m_Container.end(); ++itr, ++i) {
+			func(i, *itr);
+		}
+	}
+
+	// Iterates through each element in reverse, accepts any callable so the loop can be inlined
+	template <typename TFunc>
+	void forEachReverse(TFunc&& func) {
+		size_t i = m_Container.size() - 1;
+		for (auto itr = m_Container.rbegin(); itr != m_Container.rend(); ++itr, --i) {
+			func(i, *itr);
+		}
+	}
+
+	// Iterates through each element in reverse, const version
+	template <typename TFunc>
+	void forEachReverse(TFunc&& func) const {
+		size_t i = m_Container.size() - 1;
+		for (auto itr = m_Container.rbegin(); itr != m_Container.rend(); ++itr, --i) {
+			func(i, *itr);
+		}
+	}
+
+	template <typename TFunc>
+	void doFor(const size_t index, TFunc&& func) {
+		func(m_Container[index]);
+	}
+
+	template <typename TFunc>
+	void doFor(const size_t index, TFunc&& func) const {
+		func(m_Container[index]);
+	}
+
+	template <typename TFunc>
+	void doFor(const size_t start, const size_t end, TFunc&& func) {
+		for (size_t i = start; i < end; ++i) {
+			func(i, m_Container[i]);
+		}
+	}
+
+	template <typename TFunc>
+	void doFor(const size_t start, const size_t end, TFunc&& func) const {
+		for (size_t i = start; i < end; ++i) {
+			func(i, m_Container[i]);
+		}
+	}
+
+	iterator begin() { return m_Container.begin(); }
+
+	const_iterator begin() const { return m_Container.begin(); }
+
+	iterator end() { return m_Container.end(); }
+
+	const_iterator end() const { return m_Container.end(); }
+
+	const_iterator cbegin() const { return m_Container.cbegin(); }
+
+	const_iterator cend() const { return m_Container.cend(); }
+
+	reverse_iterator rbegin() { return m_Container.rbegin(); }
+
+	const_reverse_iterator rbegin() const { return m_Container.rbegin(); }
+
+	reverse_iterator rend() { return m_Container.rend(); }
+
+	const_reverse_iterator rend() const { return m_Container.rend(); }
+
+	const_reverse_iterator crbegin() const { return m_Container.crbegin(); }
+
+	const_reverse_iterator crend() const { return m_Container.crend(); }
+
 protected:
 
-	std::deque<TType> m_Container;
+	// Takes a run moved out of another TDeque, overridden by containers that order their elements themselves
+	virtual void transferIn(iterator first, iterator last) {
+		pushRange(std::make_move_iterator(first), std::make_move_iterator(last));
+	}
+
+	std::deque<TType, TAllocator> m_Container;
 };
 
 template <typename TType, typename... TArgs>
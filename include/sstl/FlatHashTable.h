@@ -0,0 +1,438 @@
+﻿#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include "Bits.h"
+#include "Container.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SIMPLESTL_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace sstl {
+
+	// Control bytes for 16 slots, a full slot stores the low 7 bits of its hash, so its sign bit is never set
+	struct flat_group {
+
+		constexpr static size_t width = 16;
+		constexpr static int8_t empty = -128;
+		constexpr static int8_t deleted = -2;
+
+		explicit flat_group(const int8_t* ctrl)
+#ifdef SIMPLESTL_SSE2
+		: m_Ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl))) {}
+#else
+		: m_Ctrl(ctrl) {}
+#endif
+
+		// Bitmask of every slot whose control byte is h2
+		[[nodiscard]] uint32_t match(const int8_t h2) const {
+#ifdef SIMPLESTL_SSE2
+			return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(m_Ctrl, _mm_set1_epi8(h2))));
+#else
+			uint32_t mask = 0;
+			for (uint32_t i = 0; i < width; ++i) {
+				if (m_Ctrl[i] == h2) mask |= 1u << i;
+			}
+			return mask;
+#endif
+		}
+
+		[[nodiscard]] uint32_t matchEmpty() const {
+			return match(empty);
+		}
+
+		// Bitmask of every empty or deleted slot, which are the only control bytes with the sign bit set
+		[[nodiscard]] uint32_t matchFree() const {
+#ifdef SIMPLESTL_SSE2
+			return static_cast<uint32_t>(_mm_movemask_epi8(m_Ctrl));
+#else
+			uint32_t mask = 0;
+			for (uint32_t i = 0; i < width; ++i) {
+				if (m_Ctrl[i] < 0) mask |= 1u << i;
+			}
+			return mask;
+#endif
+		}
+
+	private:
+
+#ifdef SIMPLESTL_SSE2
+		__m128i m_Ctrl;
+#else
+		const int8_t* m_Ctrl;
+#endif
+	};
+
+	// Open addressing hash table, elements are stored inline instead of one node allocation each
+	// Slots are probed a group of 16 at a time, and only slots whose control byte matches the hash are compared
+	// TKeyOf gets the key out of a stored TValue, so the same table backs both sets and maps
+	// The control bytes and the slots both come from TAllocator, rebound for the control bytes
+	template <typename TKey, typename TValue, typename TKeyOf, typename TAllocator = std::allocator<TValue>>
+	struct flat_hash_table {
+
+		template <bool TConst>
+		struct basic_iterator {
+
+			using iterator_category = std::forward_iterator_tag;
+			using value_type = TValue;
+			using difference_type = std::ptrdiff_t;
+			using pointer = std::conditional_t<TConst, const TValue*, TValue*>;
+			using reference = std::conditional_t<TConst, const TValue&, TValue&>;
+			using table = std::conditional_t<TConst, const flat_hash_table, flat_hash_table>;
+
+			basic_iterator() = default;
+
+			basic_iterator(table* inTable, const size_t index): m_Table(inTable), m_Index(index) {
+				skip();
+			}
+
+			template <bool TOtherConst = TConst,
+				std::enable_if_t<!TOtherConst, int> = 0
+			>
+			operator basic_iterator<true>() const {
+				return basic_iterator<true>(m_Table, m_Index);
+			}
+
+			reference operator*() const { return m_Table->m_Slots[m_Index]; }
+
+			pointer operator->() const { return m_Table->m_Slots + m_Index; }
+
+			basic_iterator& operator++() {
+				++m_Index;
+				skip();
+				return *this;
+			}
+
+			basic_iterator operator++(int) {
+				basic_iterator itr = *this;
+				++*this;
+				return itr;
+			}
+
+			friend bool operator==(const basic_iterator& fst, const basic_iterator& snd) {
+				return fst.m_Index == snd.m_Index;
+			}
+
+			friend bool operator!=(const basic_iterator& fst, const basic_iterator& snd) {
+				return fst.m_Index != snd.m_Index;
+			}
+
+			[[nodiscard]] size_t index() const { return m_Index; }
+
+		private:
+
+			// Moves forward to the next full slot
+			void skip() {
+				while (m_Index < m_Table->m_Capacity && m_Table->m_Ctrl[m_Index] < 0) {
+					++m_Index;
+				}
+			}
+
+			table* m_Table = nullptr;
+			size_t m_Index = 0;
+		};
+
+		using iterator = basic_iterator<false>;
+		using const_iterator = basic_iterator<true>;
+
+		constexpr static size_t npos = static_cast<size_t>(-1);
+
+		flat_hash_table() = default;
+
+		explicit flat_hash_table(const TAllocator& allocator): m_Allocator(allocator) {}
+
+		flat_hash_table(const flat_hash_table& otr): m_Allocator(traits::select_on_container_copy_construction(otr.m_Allocator)) {
+			copyFrom(otr);
+		}
+
+		flat_hash_table(flat_hash_table&& otr) noexcept: m_Allocator(otr.m_Allocator) {
+			swap(otr);
+		}
+
+		flat_hash_table& operator=(const flat_hash_table& otr) {
+			if (this != &otr) {
+				clear();
+				if constexpr (traits::propagate_on_container_copy_assignment::value) {
+					if (m_Allocator != otr.m_Allocator) deallocate();
+					m_Allocator = otr.m_Allocator;
+				}
+				copyFrom(otr);
+			}
+			return *this;
+		}
+
+		// Storage from an allocator that is not ours cannot be taken over, so then the elements are moved one by one instead
+		flat_hash_table& operator=(flat_hash_table&& otr) noexcept(traits::propagate_on_container_move_assignment::value || traits::is_always_equal::value) {
+			if (this != &otr) {
+				clear();
+				if (traits::propagate_on_container_move_assignment::value || m_Allocator == otr.m_Allocator) {
+					deallocate();
+					if constexpr (traits::propagate_on_container_move_assignment::value) m_Allocator = otr.m_Allocator;
+					swap(otr);
+				} else {
+					reserve(otr.m_Size);
+					moveFrom(otr);
+				}
+			}
+			return *this;
+		}
+
+		~flat_hash_table() {
+			clear();
+			deallocate();
+		}
+
+		[[nodiscard]] TAllocator getAllocator() const { return m_Allocator; }
+
+		// Swaps the storage but not the allocators, so both tables must use equal allocators
+		void swap(flat_hash_table& otr) noexcept {
+			std::swap(m_Ctrl, otr.m_Ctrl);
+			std::swap(m_Slots, otr.m_Slots);
+			std::swap(m_Capacity, otr.m_Capacity);
+			std::swap(m_Size, otr.m_Size);
+			std::swap(m_GrowthLeft, otr.m_GrowthLeft);
+		}
+
+		[[nodiscard]] size_t size() const { return m_Size; }
+
+		[[nodiscard]] bool empty() const { return m_Size == 0; }
+
+		[[nodiscard]] size_t capacity() const { return m_Capacity; }
+
+		iterator begin() { return iterator(this, 0); }
+
+		const_iterator begin() const { return const_iterator(this, 0); }
+
+		iterator end() { return iterator(this, m_Capacity); }
+
+		const_iterator end() const { return const_iterator(this, m_Capacity); }
+
+		const_iterator cbegin() const { return begin(); }
+
+		const_iterator cend() const { return end(); }
+
+		// Returns the last element, scanning backwards since there is no reverse iteration
+		TValue& back() {
+			size_t index = m_Capacity;
+			while (m_Ctrl[--index] < 0) {}
+			return m_Slots[index];
+		}
+
+		const TValue& back() const {
+			size_t index = m_Capacity;
+			while (m_Ctrl[--index] < 0) {}
+			return m_Slots[index];
+		}
+
+		iterator find(const TKey& key) {
+			const size_t index = findIndex(key);
+			return index == npos ? end() : iterator(this, index);
+		}
+
+		const_iterator find(const TKey& key) const {
+			const size_t index = findIndex(key);
+			return index == npos ? end() : const_iterator(this, index);
+		}
+
+		[[nodiscard]] bool contains(const TKey& key) const {
+			return findIndex(key) != npos;
+		}
+
+		// Constructs a TValue from args if key is not present yet, args are left untouched otherwise
+		// The new element is built before the old elements are moved when growing, so args may refer to an element in the table
+		template <typename... TArgs>
+		std::pair<iterator, bool> tryEmplace(const TKey& key, TArgs&&... args) {
+			const uint64_t hash = hashOf(key);
+			const size_t index = findIndex(key, hash);
+			if (index != npos) {
+				return {iterator(this, index), false};
+			}
+			if (m_GrowthLeft == 0) {
+				flat_hash_table table(m_Allocator);
+				table.allocate(nextCapacity(m_Size + 1));
+				const size_t newIndex = table.insertNew(hash, std::forward<TArgs>(args)...);
+				table.moveFrom(*this);
+				swap(table);
+				return {iterator(this, newIndex), true};
+			}
+			return {iterator(this, insertNew(hash, std::forward<TArgs>(args)...)), true};
+		}
+
+		iterator erase(const_iterator itr) {
+			eraseAt(itr.index());
+			return iterator(this, itr.index() + 1);
+		}
+
+		size_t erase(const TKey& key) {
+			const size_t index = findIndex(key);
+			if (index == npos) return 0;
+			eraseAt(index);
+			return 1;
+		}
+
+		void clear() {
+			if (m_Capacity == 0) return;
+			if constexpr (!std::is_trivially_destructible_v<TValue>) {
+				for (size_t i = 0; i < m_Capacity; ++i) {
+					if (m_Ctrl[i] >= 0) m_Slots[i].~TValue();
+				}
+			}
+			std::memset(m_Ctrl, flat_group::empty, m_Capacity);
+			m_Size = 0;
+			m_GrowthLeft = maxLoad(m_Capacity);
+		}
+
+		// Makes room for amt elements without growing again
+		void reserve(const size_t amt) {
+			if (amt <= m_Size + m_GrowthLeft) return;
+			flat_hash_table table(m_Allocator);
+			table.allocate(nextCapacity(amt));
+			table.moveFrom(*this);
+			swap(table);
+		}
+
+	protected:
+
+		using traits = std::allocator_traits<TAllocator>;
+		using ctrl_traits = typename traits::template rebind_traits<int8_t>;
+
+		// Up to 7/8 of the slots can be used, the remaining empty slots end every probe
+		constexpr static size_t maxLoad(const size_t capacity) {
+			return capacity - capacity / 8;
+		}
+
+		// getHash is often the identity, so the bits are mixed before picking a group and the control byte
+		static uint64_t hashOf(const TKey& key) {
+			const uint64_t hash = static_cast<uint64_t>(sstl::hasher<TKey>{}(key)) * 0x9E3779B97F4A7C15ull;
+			return hash ^ (hash >> 32);
+		}
+
+		static int8_t h2(const uint64_t hash) {
+			return static_cast<int8_t>(hash & 0x7F);
+		}
+
+		// Smallest power of two capacity that can hold amt elements
+		static size_t nextCapacity(const size_t amt) {
+			size_t capacity = flat_group::width;
+			while (maxLoad(capacity) < amt) {
+				capacity *= 2;
+			}
+			return capacity;
+		}
+
+		size_t findIndex(const TKey& key) const {
+			return m_Capacity == 0 ? npos : findIndex(key, hashOf(key));
+		}
+
+		size_t findIndex(const TKey& key, const uint64_t hash) const {
+			if (m_Capacity == 0) return npos;
+			const size_t groupMask = m_Capacity / flat_group::width - 1;
+			size_t group = (hash >> 7) & groupMask;
+			// Triangular probing visits every group once when the group count is a power of two
+			for (size_t step = 1; ; ++step) {
+				const flat_group ctrl(m_Ctrl + group * flat_group::width);
+				for (uint32_t mask = ctrl.match(h2(hash)); mask != 0; mask &= mask - 1) {
+					const size_t index = group * flat_group::width + countTrailingZeros(mask);
+					if (TKeyOf{}(m_Slots[index]) == key) return index;
+				}
+				if (ctrl.matchEmpty() != 0) return npos;
+				group = (group + step) & groupMask;
+			}
+		}
+
+		// Constructs a TValue in the first free slot for hash, the key must not be present, and there must be room
+		template <typename... TArgs>
+		size_t insertNew(const uint64_t hash, TArgs&&... args) {
+			const size_t groupMask = m_Capacity / flat_group::width - 1;
+			size_t group = (hash >> 7) & groupMask;
+			for (size_t step = 1; ; ++step) {
+				const uint32_t mask = flat_group(m_Ctrl + group * flat_group::width).matchFree();
+				if (mask != 0) {
+					const size_t index = group * flat_group::width + countTrailingZeros(mask);
+					::new (static_cast<void*>(m_Slots + index)) TValue(std::forward<TArgs>(args)...);
+					if (m_Ctrl[index] == flat_group::empty) --m_GrowthLeft;
+					m_Ctrl[index] = h2(hash);
+					++m_Size;
+					return index;
+				}
+				group = (group + step) & groupMask;
+			}
+		}
+
+		void eraseAt(const size_t index) {
+			m_Slots[index].~TValue();
+			--m_Size;
+			// If the group still has an empty slot, every probe stops here anyway, so the slot can go back to empty
+			// Otherwise a probe may need to pass through it, so it is marked deleted until the next rehash
+			if (flat_group(m_Ctrl + (index & ~(flat_group::width - 1))).matchEmpty() != 0) {
+				m_Ctrl[index] = flat_group::empty;
+				++m_GrowthLeft;
+			} else {
+				m_Ctrl[index] = flat_group::deleted;
+			}
+		}
+
+		// Copies every element of otr, which may use a different allocator
+		void copyFrom(const flat_hash_table& otr) {
+			reserve(otr.m_Size);
+			for (size_t i = 0; i < otr.m_Capacity; ++i) {
+				if (otr.m_Ctrl[i] >= 0) {
+					insertNew(hashOf(TKeyOf{}(otr.m_Slots[i])), otr.m_Slots[i]);
+				}
+			}
+		}
+
+		// Moves every element out of otr, which is left empty without storage
+		void moveFrom(flat_hash_table& otr) {
+			for (size_t i = 0; i < otr.m_Capacity; ++i) {
+				if (otr.m_Ctrl[i] >= 0) {
+					insertNew(hashOf(TKeyOf{}(otr.m_Slots[i])), std::move(otr.m_Slots[i]));
+					otr.m_Slots[i].~TValue();
+				}
+			}
+			otr.m_Size = 0;
+			otr.deallocate();
+		}
+
+		void allocate(const size_t capacity) {
+			typename ctrl_traits::allocator_type ctrlAllocator(m_Allocator);
+			m_Ctrl = ctrl_traits::allocate(ctrlAllocator, capacity);
+			std::memset(m_Ctrl, flat_group::empty, capacity);
+			try {
+				m_Slots = traits::allocate(m_Allocator, capacity);
+			} catch (...) {
+				ctrl_traits::deallocate(ctrlAllocator, m_Ctrl, capacity);
+				m_Ctrl = nullptr;
+				throw;
+			}
+			m_Capacity = capacity;
+			m_GrowthLeft = maxLoad(capacity);
+		}
+
+		void deallocate() {
+			if (m_Capacity == 0) return;
+			typename ctrl_traits::allocator_type ctrlAllocator(m_Allocator);
+			ctrl_traits::deallocate(ctrlAllocator, m_Ctrl, m_Capacity);
+			traits::deallocate(m_Allocator, m_Slots, m_Capacity);
+			m_Ctrl = nullptr;
+			m_Slots = nullptr;
+			m_Capacity = 0;
+			m_GrowthLeft = 0;
+		}
+
+		int8_t* m_Ctrl = nullptr;
+		TValue* m_Slots = nullptr;
+		size_t m_Capacity = 0;
+		size_t m_Size = 0;
+
+		// Number of empty slots that can still be filled before the table has to grow
+		size_t m_GrowthLeft = 0;
+
+		TAllocator m_Allocator;
+	};
+}
@@ -0,0 +1,230 @@
+﻿#pragma once
+
+#include <tuple>
+#include "FlatHashTable.h"
+#include "InitializerList.h"
+
+// Map backed by an open addressing table, pairs live in one flat array, so lookups avoid a node per element
+// Same interface as TMap, but pushing or popping invalidates iterators and references
+template <typename TKeyType, typename TValueType, typename TAllocator = std::allocator<std::pair<const TKeyType, TValueType>>,
+	std::enable_if_t<sstl::is_hashable_v<TKeyType>, int> = 0
+>
+struct TFlatMap : TAssociativeContainer<TKeyType, TValueType> {
+
+	using iterator = typename sstl::flat_hash_table<TKeyType, std::pair<const TKeyType, TValueType>, sstl::map_key, TAllocator>::iterator;
+	using const_iterator = typename sstl::flat_hash_table<TKeyType, std::pair<const TKeyType, TValueType>, sstl::map_key, TAllocator>::const_iterator;
+
+	TFlatMap() = default;
+
+	explicit TFlatMap(const TAllocator& allocator): m_Container(allocator) {}
+
+	template <typename TOtherValueType = TValueType,
+		std::enable_if_t<std::is_copy_constructible_v<TOtherValueType>, int> = 0
+	>
+	TFlatMap(TInitializerList<TPair<TKeyType, TValueType>> init) {
+		m_Container.reserve(init.size());
+		for (auto& pair : init) {
+			emplace(pair.first(), pair.second());
+		}
+	}
+
+	// An allocator on its own goes to the allocator constructor instead
+	template <typename... TPairs,
+		std::enable_if_t<!std::disjunction_v<std::is_convertible<TPairs, TAllocator>...>, int> = 0
+	>
+	explicit TFlatMap(TPairs&&... args) {
+		m_Container.reserve(sizeof...(TPairs));
+		(m_Container.tryEmplace(args.key(), std::forward<typename TPairs::KeyType>(args.key()), std::forward<typename TPairs::ValueType>(args.value())), ...);
+	}
+
+	[[nodiscard]] virtual size_t getSize() const override {
+		return m_Container.size();
+	}
+
+	[[nodiscard]] TAllocator getAllocator() const {
+		return m_Container.getAllocator();
+	}
+
+	virtual TPair<TKeyType, const TValueType&> top() const override {
+		return TPair<TKeyType, const TValueType&>{*m_Container.begin()};
+	}
+
+	virtual TPair<TKeyType, const TValueType&> bottom() const override {
+		return TPair<TKeyType, const TValueType&>{m_Container.back()};
+	}
+
+	virtual bool contains(const TKeyType& key) const override {
+		return m_Container.contains(key);
+	}
+
+	virtual TValueType& get(const TKeyType& key) override {
+		auto itr = m_Container.find(key);
+		if (itr == m_Container.end()) {
+			throw std::out_of_range("Key is not in the container!");
+		}
+		return itr->second;
+	}
+
+	virtual const TValueType& get(const TKeyType& key) const override {
+		auto itr = m_Container.find(key);
+		if (itr == m_Container.end()) {
+			throw std::out_of_range("Key is not in the container!");
+		}
+		return itr->second;
+	}
+
+	virtual void resize(const size_t amt, std::function<TPair<TKeyType, TValueType>()> func) override {
+		m_Container.reserve(amt);
+		for (size_t i = getSize(); i < amt; ++i) {
+			TPair<TKeyType, TValueType> pair = func();
+			m_Container.tryEmplace(pair.key(), std::forward<TKeyType>(pair.key()), std::forward<TValueType>(pair.value()));
+		}
+	}
+
+	virtual void reserve(size_t amt) override {
+		m_Container.reserve(amt);
+	}
+
+	virtual TPair<TKeyType, const TValueType&> push() override {
+		if constexpr (std::is_default_constructible_v<TKeyType> && std::is_default_constructible_v<TValueType>) {
+			const TKeyType key{};
+			return TPair<TKeyType, const TValueType&>{*m_Container.tryEmplace(key, std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple()).first};
+		} else {
+			throw std::runtime_error("Type is not default constructible!");
+		}
+	}
+
+	virtual TValueType& push(const TKeyType& key) override {
+		if constexpr (std::is_default_constructible_v<TValueType>) {
+			return emplace(key);
+		} else {
+			throw std::runtime_error("Type is not default constructible!");
+		}
+	}
+
+	virtual TValueType& push(const TKeyType& key, const TValueType& value) override {
+		if constexpr (std::is_copy_constructible_v<TValueType>) {
+			return emplace(key, value);
+		} else {
+			throw std::runtime_error("Type is not copyable!");
+		}
+	}
+
+	virtual TValueType& push(const TKeyType& key, TValueType&& value) override {
+		if constexpr (std::is_move_constructible_v<TValueType>) {
+			return emplace(key, std::move(value));
+		} else {
+			throw std::runtime_error("Type is not moveable!");
+		}
+	}
+
+	virtual void push(const TPair<TKeyType, TValueType>& pair) override {
+		if constexpr (std::is_copy_constructible_v<TValueType>) {
+			emplace(pair.key(), pair.value());
+		} else {
+			throw std::runtime_error("Type is not copyable!");
+		}
+	}
+
+	virtual void push(TPair<TKeyType, TValueType>&& pair) override {
+		if constexpr (std::is_move_constructible_v<TValueType>) {
+			m_Container.tryEmplace(pair.key(), std::move(pair.key()), std::move(pair.value()));
+		} else {
+			throw std::runtime_error("Type is not moveable!");
+		}
+	}
+
+	// Constructs the value in place from args, no temporary pair or value is made
+	// The slot is found before anything is constructed, so args are left untouched if key is already present
+	template <typename... TArgs>
+	TValueType& emplace(const TKeyType& key, TArgs&&... args) {
+		return m_Container.tryEmplace(key, std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple(std::forward<TArgs>(args)...)).first->second;
+	}
+
+	// Same as emplace, kept so TFlatMap can replace TMap directly
+	template <typename... TArgs>
+	TValueType& tryEmplace(const TKeyType& key, TArgs&&... args) {
+		return emplace(key, std::forward<TArgs>(args)...);
+	}
+
+	virtual void replace(const TKeyType& key, const TValueType& obj) override {
+		if constexpr (std::is_copy_constructible_v<TValueType>) {
+			pop(key);
+			emplace(key, obj);
+		} else {
+			throw std::runtime_error("Type is not copyable!");
+		}
+	}
+
+	virtual void replace(const TKeyType& key, TValueType&& obj) override {
+		if constexpr (std::is_move_constructible_v<TValueType>) {
+			pop(key);
+			emplace(key, std::move(obj));
+		} else {
+			throw std::runtime_error("Type is not moveable!");
+		}
+	}
+
+	virtual void clear() override {
+		m_Container.clear();
+	}
+
+	virtual void pop() override {
+		m_Container.erase(m_Container.begin());
+	}
+
+	virtual void pop(const TKeyType& key) override {
+		m_Container.erase(key);
+	}
+
+	virtual void transfer(TAssociativeContainer<TKeyType, TValueType>& otr, const TKeyType& key) override {
+		auto itr = m_Container.find(key);
+		if (itr == m_Container.end()) return;
+		// There are no nodes to extract, so the pair is moved out before its slot is freed
+		std::pair<TKeyType, TValueType> pair = std::move(*itr);
+		m_Container.erase(itr);
+		// Prefer move, but copy if not available
+		if constexpr (std::is_move_constructible_v<TValueType>) {
+			otr.push(pair.first, std::move(pair.second));
+		} else {
+			otr.push(pair.first, pair.second);
+		}
+	}
+
+	virtual void forEach(const std::function<void(TPair<TKeyType, const TValueType&>)>& func) const override {
+		for (auto itr = m_Container.begin(); itr != m_Container.end(); ++itr) {
+			func(TPair<TKeyType, const TValueType&>{itr->first, itr->second});
+		}
+	}
+
+	// Iterates through each element, accepts any callable so the loop can be inlined
+	template <typename TFunc>
+	void forEach(TFunc&& func) const {
+		for (auto itr = m_Container.begin(); itr != m_Container.end(); ++itr) {
+			func(TPair<TKeyType, const TValueType&>{itr->first, itr->second});
+		}
+	}
+
+	// Pairs hold a const key, since changing it through an iterator would leave the pair in the wrong slot
+	iterator begin() { return m_Container.begin(); }
+
+	const_iterator begin() const { return m_Container.begin(); }
+
+	iterator end() { return m_Container.end(); }
+
+	const_iterator end() const { return m_Container.end(); }
+
+	const_iterator cbegin() const { return m_Container.cbegin(); }
+
+	const_iterator cend() const { return m_Container.cend(); }
+
+protected:
+
+	sstl::flat_hash_table<TKeyType, std::pair<const TKeyType, TValueType>, sstl::map_key, TAllocator> m_Container;
+};
+
+template <typename TKeyType, typename TValueType>
+TFlatMap(TInitializerList<TPair<TKeyType, TValueType>>) -> TFlatMap<TKeyType, TValueType>;
+
+template <typename TPair, typename... TPairs>
+TFlatMap(TPair, TPairs...) -> TFlatMap<typename TPair::KeyType, typename TPair::ValueType>;
@@ -4,11 +4,16 @@
 #include "Container.h"
 #include "InitializerList.h"
 
-template <typename TType>
+template <typename TType, typename TAllocator = std::allocator<TType>>
 struct TForwardList : TSequenceContainer<TType> {
 
+	using iterator = typename std::forward_list<TType, TAllocator>::iterator;
+	using const_iterator = typename std::forward_list<TType, TAllocator>::const_iterator;
+
 	TForwardList() = default;
 
+	explicit TForwardList(const TAllocator& allocator): m_Container(allocator) {}
+
 	template <typename TOtherType = TType,
 		std::enable_if_t<std::is_copy_constructible_v<TOtherType>, int> = 0
 	>
@@ -28,6 +33,10 @@ struct TForwardList : TSequenceContainer<TType> {
 		return m_Size;
 	}
 
+	[[nodiscard]] TAllocator getAllocator() const {
+		return m_Container.get_allocator();
+	}
+
 	virtual TType& top() override {
 		return m_Container.front();
 	}
@@ -151,6 +160,55 @@ struct TForwardList : TSequenceContainer<TType> {
 		}
 	}
 
+	// Adds every element in [first, last) to the front, keeping the order of the range
+	template <typename TIterator>
+	void pushRange(TIterator first, TIterator last) {
+		auto itr = m_Container.before_begin();
+		for (; first != last; ++first) {
+			itr = m_Container.emplace_after(itr, *first);
+			m_Size++;
+		}
+	}
+
+	// Adds every element of another container or range, elements are moved out if it is an rvalue
+	template <typename TRange>
+	void pushRange(TRange&& range) {
+		if constexpr (std::is_rvalue_reference_v<TRange&&>) {
+			pushRange(std::make_move_iterator(range.begin()), std::make_move_iterator(range.end()));
+		} else {
+			pushRange(range.begin(), range.end());
+		}
+	}
+
+	// Splices every element out of otr to the front, nothing is copied or moved
+	// Nodes can only be relinked between lists that share an allocator, otherwise the elements are moved one by one
+	void pushRange(TForwardList&& otr) {
+		if (otr.m_Container.get_allocator() == m_Container.get_allocator()) {
+			m_Container.splice_after(m_Container.before_begin(), otr.m_Container);
+			m_Size += otr.m_Size;
+			otr.m_Size = 0;
+			return;
+		}
+		pushRange(std::make_move_iterator(otr.begin()), std::make_move_iterator(otr.end()));
+		otr.clear();
+	}
+
+	// Constructs an element in place from args, no temporary TType is made
+	template <typename... TArgs>
+	TType& emplace(TArgs&&... args) {
+		m_Size++;
+		return m_Container.emplace_front(std::forward<TArgs>(args)...);
+	}
+
+	// Constructs an element in place at index from args
+	template <typename... TArgs>
+	TType& emplaceAt(const size_t index, TArgs&&... args) {
+		auto itr = m_Container.before_begin();
+		std::advance(itr, index);
+		m_Size++;
+		return *m_Container.emplace_after(itr, std::forward<TArgs>(args)...);
+	}
+
 	virtual void replace(const size_t index, const TType& obj) override {
 		if constexpr (std::is_copy_constructible_v<TType>) {
 			pop(index);
@@ -205,17 +263,43 @@ struct TForwardList : TSequenceContainer<TType> {
 		}
 	}
 
+	virtual void popRange(const size_t start, const size_t end) override {
+		auto first = m_Container.before_begin();
+		std::advance(first, start);
+		auto last = first;
+		std::advance(last, end - start + 1);
+		m_Container.erase_after(first, last);
+		m_Size -= end - start;
+	}
+
 	virtual void transfer(TSequenceContainer<TType>& otr, const size_t index) override {
 		// Forward List transfer can use splicing
-		if (auto otrList = dynamic_cast<TForwardList*>(&otr)) {
+		if (auto otrList = dynamic_cast<TForwardList*>(&otr); otrList && otrList->m_Container.get_allocator() == m_Container.get_allocator()) {
 			auto itr = m_Container.before_begin();
 			std::advance(itr, index);
 			otrList->m_Container.splice_after(otrList->m_Container.before_begin(), m_Container, itr);
+			otrList->m_Size++;
+			m_Size--;
 			return;
 		}
 		TSequenceContainer<TType>::transfer(otr, index);
 	}
 
+	virtual void transferRange(TSequenceContainer<TType>& otr, const size_t start, const size_t end) override {
+		// Forward List transfer can splice the whole range at once
+		if (auto otrList = dynamic_cast<TForwardList*>(&otr); otrList && otrList->m_Container.get_allocator() == m_Container.get_allocator()) {
+			auto first = m_Container.before_begin();
+			std::advance(first, start);
+			auto last = first;
+			std::advance(last, end - start + 1);
+			otrList->m_Container.splice_after(otrList->m_Container.before_begin(), m_Container, first, last);
+			otrList->m_Size += end - start;
+			m_Size -= end - start;
+			return;
+		}
+		TSequenceContainer<TType>::transferRange(otr, start, end);
+	}
+
 	virtual void forEach(const std::function<void(size_t, TType&)>& func) override {
 		size_t i = 0;
 		for (auto itr = m_Container.begin(); itr != m_Container.end(); std::advance(itr, 1), ++i) {
@@ -230,9 +314,74 @@ struct TForwardList : TSequenceContainer<TType> {
 		}
 	}
 
+	// Iterates through each element, accepts any callable so the loop can be inlined
+	template <typename TFunc>
+	void forEach(TFunc&& func) {
+		size_t i = 0;
+		for (auto itr = m_Container.begin(); itr != m_Container.end(); std::advance(itr, 1), ++i) {
+			func(i, *itr);
+		}
+	}
+
+	// Iterates through each element, const version
+	template <typename TFunc>
+	void forEach(TFunc&& func) const {
+		size_t i = 0;
+		for (auto itr = m_Container.begin(); itr != m_Container.end(); std::advance(itr, 1), ++i) {
+			func(i, *itr);
+		}
+	}
+
+
+	template <typename TFunc>
+	void doFor(const size_t index, TFunc&& func) {
+		auto itr = m_Container.begin();
+		std::advance(itr, index);
+		func(*itr);
+	}
+
+	template <typename TFunc>
+	void doFor(const size_t index, TFunc&& func) const {
+		auto itr = m_Container.begin();
+		std::advance(itr, index);
+		func(*itr);
+	}
+
+	// Walks the list once, rather than seeking to every index
+	template <typename TFunc>
+	void doFor(const size_t start, const size_t end, TFunc&& func) {
+		auto itr = m_Container.begin();
+		std::advance(itr, start);
+		for (size_t i = start; i < end; std::advance(itr, 1), ++i) {
+			func(i, *itr);
+		}
+	}
+
+	// Walks the list once, rather than seeking to every index
+	template <typename TFunc>
+	void doFor(const size_t start, const size_t end, TFunc&& func) const {
+		auto itr = m_Container.begin();
+		std::advance(itr, start);
+		for (size_t i = start; i < end; std::advance(itr, 1), ++i) {
+			func(i, *itr);
+		}
+	}
+
+	iterator begin() { return m_Container.begin(); }
+
+	const_iterator begin() const { return m_Container.begin(); }
+
+	iterator end() { return m_Container.end(); }
+
+	const_iterator end() const { return m_Container.end(); }
+
+	const_iterator cbegin() const { return m_Container.cbegin(); }
+
+	const_iterator cend() const { return m_Container.cend(); }
+
 protected:
 
-	std::forward_list<TType> m_Container;
+	std::forward_list<TType, TAllocator> m_Container;
 	size_t m_Size = 0;
 };
 
@@ -0,0 +1,666 @@
+﻿#pragma once
+
+#include <algorithm>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "Container.h"
+#include "InitializerList.h"
+
+namespace sstl {
+	// Orders a heap so the smallest element is on top
+	template <typename TType>
+	struct greater {
+		bool operator()(const TType& a, const TType& b) const {
+			return b < a;
+		}
+	};
+}
+
+// Addressable heap, push returns a handle that stays valid until that element is removed
+// Handles let an element change its key or be removed in O(log n), instead of a search and a full rebuild
+// TCompare follows std::priority_queue, so std::less puts the largest element on top
+// Each node has TArity children, 4 keeps the tree shallow and all siblings next to each other in memory
+// Like TMinHeap, elements are handed out by reference, but changing one must go through update or modify so the heap can move it
+template <typename TType, typename TCompare = std::less<TType>, size_t TArity = 4, typename TAllocator = std::allocator<TType>>
+struct TIndexedHeap : TSequenceContainer<TType> {
+
+	static_assert(TArity >= 2, "A heap node needs at least two children!");
+
+	using Handle = size_t;
+
+	// Elements cannot be modified through iterators, since that would break the heap
+	using iterator = typename std::vector<TType, TAllocator>::const_iterator;
+	using const_iterator = typename std::vector<TType, TAllocator>::const_iterator;
+	using reverse_iterator = typename std::vector<TType, TAllocator>::const_reverse_iterator;
+	using const_reverse_iterator = typename std::vector<TType, TAllocator>::const_reverse_iterator;
+
+	constexpr static Handle invalidHandle = static_cast<Handle>(-1);
+
+	TIndexedHeap() = default;
+
+	// The bookkeeping for handles and pointers comes from the same allocator as the elements
+	explicit TIndexedHeap(const TAllocator& allocator):
+	  m_Container(allocator), m_Handles(allocator), m_Positions(allocator), m_FreeHandles(allocator), m_Pointers(allocator) {}
+
+	template <typename TOtherType = TType,
+		std::enable_if_t<std::is_copy_constructible_v<TOtherType>, int> = 0
+	>
+	TIndexedHeap(TInitializerList<TType> init) {
+		TIndexedHeap::reserve(init.size());
+		for (auto& obj : init) {
+			emplace(obj);
+		}
+	}
+
+	template <typename... TArgs,
+		std::enable_if_t<std::conjunction_v<std::is_constructible<TType, TArgs>...>, int> = 0
+	>
+	explicit TIndexedHeap(TArgs&&... args) {
+		TIndexedHeap::reserve(sizeof...(TArgs));
+		(emplace(std::forward<TArgs>(args)), ...);
+	}
+
+	[[nodiscard]] virtual size_t getSize() const override {
+		return m_Container.size();
+	}
+
+	[[nodiscard]] TAllocator getAllocator() const {
+		return m_Container.get_allocator();
+	}
+
+	// Changing the element through this reference breaks the heap, use update or modify
+	virtual TType& top() override {
+		return m_Container.front();
+	}
+
+	virtual const TType& top() const override {
+		return m_Container.front();
+	}
+
+	// Changing the element through this reference breaks the heap, use update or modify
+	virtual TType& bottom() override {
+		return m_Container.back();
+	}
+
+	virtual const TType& bottom() const override {
+		return m_Container.back();
+	}
+
+	virtual bool contains(const TType& obj) const override {
+		if constexpr (sstl::is_equality_comparable_v<TType>) {
+			return CONTAINS(m_Container, obj);
+		} else {
+			throw std::runtime_error("Type is not comparable!");
+		}
+	}
+
+	virtual bool contains(typename TUnfurled<TType>::Type* obj) const override {
+		if constexpr (sstl::is_managed_v<TType>) {
+			// Managed pointers are tracked, so this does not need to search
+			return m_Pointers.find(obj) != m_Pointers.end();
+		} else {
+			return contains(*obj);
+		}
+	}
+
+	virtual size_t find(const TType& obj) const override {
+		if constexpr (sstl::is_equality_comparable_v<TType>) {
+			return DISTANCE(m_Container, obj);
+		} else {
+			throw std::runtime_error("Type is not comparable!");
+		}
+	}
+
+	virtual size_t find(typename TUnfurled<TType>::Type* obj) const override {
+		if constexpr (sstl::is_managed_v<TType>) {
+			const auto itr = m_Pointers.find(obj);
+			return itr == m_Pointers.end() ? getSize() : m_Positions[itr->second];
+		} else {
+			return find(*obj);
+		}
+	}
+
+	// Changing the element through this reference breaks the heap, use update or modify
+	virtual TType& get(size_t index) override {
+		return m_Container[index];
+	}
+
+	virtual const TType& get(size_t index) const override {
+		return m_Container[index];
+	}
+
+	virtual void resize(size_t amt) override {
+		if constexpr (std::is_default_constructible_v<TType>) {
+			// Removing from the back never breaks the heap
+			while (getSize() > amt) {
+				removeAt(getSize() - 1);
+			}
+			reserve(amt);
+			while (getSize() < amt) {
+				emplace();
+			}
+		} else {
+			throw std::runtime_error("Type is not default constructible!");
+		}
+	}
+
+	virtual void resize(const size_t amt, std::function<TType(size_t)> func) override {
+		reserve(amt);
+		for (size_t i = getSize(); i < amt; ++i) {
+			emplace(func(i));
+		}
+	}
+
+	virtual void reserve(size_t amt) override {
+		m_Container.reserve(amt);
+		m_Handles.reserve(amt);
+		m_Positions.reserve(amt);
+	}
+
+	// Returns the new element after it moved to its place, use emplace to get its handle for modify instead
+	virtual TType& push() override {
+		if constexpr (std::is_default_constructible_v<TType>) {
+			return m_Container[m_Positions[emplace()]];
+		} else {
+			throw std::runtime_error("Type is not default constructible!");
+		}
+	}
+
+	// Returns the handle of the new element, not its index, since the index changes as the heap does
+	virtual size_t push(const TType& obj) override {
+		if constexpr (std::is_copy_constructible_v<TType>) {
+			return emplace(obj);
+		} else {
+			throw std::runtime_error("Type is not copyable!");
+		}
+	}
+
+	// Returns the handle of the new element, not its index, since the index changes as the heap does
+	virtual size_t push(TType&& obj) override {
+		if constexpr (std::is_move_constructible_v<TType>) {
+			return emplace(std::move(obj));
+		} else {
+			throw std::runtime_error("Type is not moveable!");
+		}
+	}
+
+	// Constructs an element in place from args and returns its handle
+	// If an allocation or the constructor throws, everything added so far is taken back out, so the heap is left as it was
+	template <typename... TArgs>
+	Handle emplace(TArgs&&... args) {
+		const size_t size = m_Container.size();
+		const bool reused = !m_FreeHandles.empty();
+		const Handle handle = acquireHandle();
+		try {
+			m_Handles.push_back(handle);
+			m_Container.emplace_back(std::forward<TArgs>(args)...);
+			linkPointer(size);
+		} catch (...) {
+			if (m_Container.size() > size) m_Container.pop_back();
+			if (m_Handles.size() > size) m_Handles.pop_back();
+			// A reused handle goes back where it came from, which still has room for it
+			if (reused) {
+				m_FreeHandles.push_back(handle);
+			} else {
+				m_Positions.pop_back();
+			}
+			throw;
+		}
+		m_Positions[handle] = size;
+		siftUp(size);
+		return handle;
+	}
+
+	// Replaces the element at index, it keeps its handle
+	virtual void replace(const size_t index, const TType& obj) override {
+		if constexpr (std::is_copy_constructible_v<TType>) {
+			assign(index, TType(obj));
+		} else {
+			throw std::runtime_error("Type is not copyable!");
+		}
+	}
+
+	// Replaces the element at index, it keeps its handle
+	virtual void replace(const size_t index, TType&& obj) override {
+		if constexpr (std::is_move_constructible_v<TType>) {
+			assign(index, std::move(obj));
+		} else {
+			throw std::runtime_error("Type is not moveable!");
+		}
+	}
+
+	virtual void clear() override {
+		m_Container.clear();
+		m_Handles.clear();
+		m_Positions.clear();
+		m_FreeHandles.clear();
+		m_Pointers.clear();
+	}
+
+	virtual void pop() override {
+		removeAt(0);
+	}
+
+	virtual void pop(const size_t index) override {
+		removeAt(index);
+	}
+
+	virtual void pop(const TType& obj) override {
+		if constexpr (sstl::is_equality_comparable_v<TType>) {
+			const size_t index = find(obj);
+			if (index < getSize()) {
+				removeAt(index);
+			}
+		} else {
+			throw std::runtime_error("Type is not comparable!");
+		}
+	}
+
+	virtual void pop(typename TUnfurled<TType>::Type* obj) override {
+		if constexpr (sstl::is_managed_v<TType>) {
+			// Managed pointers are tracked, so this is O(log n) like remove
+			const auto itr = m_Pointers.find(obj);
+			if (itr != m_Pointers.end()) {
+				removeAt(m_Positions[itr->second]);
+			}
+		} else {
+			pop(*obj);
+		}
+	}
+
+	// The last element is always a leaf, so it can be removed without touching the rest
+	virtual void popBack() override {
+		removeAt(getSize() - 1);
+	}
+
+	virtual void popRange(const size_t start, const size_t end) override {
+		// Indices move as elements are removed, handles do not
+		const std::vector<Handle> handles(m_Handles.begin() + start, m_Handles.begin() + end);
+		for (const Handle handle : handles) {
+			remove(handle);
+		}
+	}
+
+	// The element is taken out of the heap first, so the heap never compares an element that was moved away
+	virtual void transfer(TSequenceContainer<TType>& otr, const size_t index) override {
+		otr.push(removeAt(index));
+	}
+
+	virtual void transferRange(TSequenceContainer<TType>& otr, const size_t start, const size_t end) override {
+		// Indices move as elements are removed, handles do not
+		const std::vector<Handle> handles(m_Handles.begin() + start, m_Handles.begin() + end);
+		for (const Handle handle : handles) {
+			otr.push(removeAt(m_Positions[handle]));
+		}
+	}
+
+	// Returns true if handle still refers to an element in the heap
+	[[nodiscard]] bool isValid(const Handle handle) const {
+		return handle < m_Positions.size() && m_Positions[handle] != invalidIndex;
+	}
+
+	// Returns the current index of the element at handle
+	[[nodiscard]] size_t indexOf(const Handle handle) const {
+		return m_Positions[handle];
+	}
+
+	// Returns the handle of the element at index
+	[[nodiscard]] Handle handleOf(const size_t index) const {
+		return m_Handles[index];
+	}
+
+	// Gets the element at handle, it is const since changing it directly would break the heap, use update or modify
+	const TType& fromHandle(const Handle handle) const {
+		return m_Container[m_Positions[handle]];
+	}
+
+	// Replaces the element at handle and moves it to its new place in O(log n)
+	void update(const Handle handle, const TType& obj) {
+		assign(m_Positions[handle], TType(obj));
+	}
+
+	// Replaces the element at handle and moves it to its new place in O(log n)
+	void update(const Handle handle, TType&& obj) {
+		assign(m_Positions[handle], std::move(obj));
+	}
+
+	// Changes the element at handle in place with func, then moves it to its new place in O(log n)
+	template <typename TFunc>
+	void modify(const Handle handle, TFunc&& func) {
+		const size_t index = m_Positions[handle];
+		unlinkPointer(index);
+		try {
+			func(m_Container[index]);
+		} catch (...) {
+			// func may have changed the element before it threw, so it is linked and placed again either way
+			linkPointer(index);
+			restore(index);
+			throw;
+		}
+		linkPointer(index);
+		restore(index);
+	}
+
+	// Lowers the key of the element at handle, either direction is handled, so this is the same as update
+	void decreaseKey(const Handle handle, const TType& obj) { update(handle, obj); }
+
+	void decreaseKey(const Handle handle, TType&& obj) { update(handle, std::move(obj)); }
+
+	// Raises the key of the element at handle, either direction is handled, so this is the same as update
+	void increaseKey(const Handle handle, const TType& obj) { update(handle, obj); }
+
+	void increaseKey(const Handle handle, TType&& obj) { update(handle, std::move(obj)); }
+
+	// Removes the element at handle in O(log n), the handle may be reused by a later push
+	void remove(const Handle handle) {
+		removeAt(m_Positions[handle]);
+	}
+
+	// func may change the elements, the heap is rebuilt afterwards in O(n)
+	virtual void forEach(const std::function<void(size_t, TType&)>& func) override {
+		forEachMutable(func);
+	}
+
+	virtual void forEach(const std::function<void(size_t, const TType&)>& func) const override {
+		for (size_t i = 0; i < m_Container.size(); ++i) {
+			func(i, m_Container[i]);
+		}
+	}
+
+	// func may change the elements, the heap is rebuilt afterwards in O(n)
+	virtual void forEachReverse(const std::function<void(size_t, TType&)>& func) override {
+		forEachReverseMutable(func);
+	}
+
+	// Changes the element at index in place with func, then moves it to its new place, the same as modify
+	virtual void doFor(const size_t index, const std::function<void(TType&)>& func) override {
+		modify(m_Handles[index], func);
+	}
+
+	virtual void doFor(const size_t index, const std::function<void(const TType&)>& func) const override {
+		func(m_Container[index]);
+	}
+
+	virtual void forEachReverse(const std::function<void(size_t, const TType&)>& func) const override {
+		for (size_t i = m_Container.size(); i > 0; --i) {
+			func(i - 1, m_Container[i - 1]);
+		}
+	}
+
+	// Iterates through each element in heap order, accepts any callable so the loop can be inlined
+	// A callable that only reads goes through the const version, one that takes TType& rebuilds the heap afterwards
+	template <typename TFunc>
+	void forEach(TFunc&& func) {
+		if constexpr (std::is_invocable_v<TFunc&, size_t, const TType&>) {
+			std::as_const(*this).forEach(std::forward<TFunc>(func));
+		} else {
+			forEachMutable(func);
+		}
+	}
+
+	template <typename TFunc>
+	void forEach(TFunc&& func) const {
+		for (size_t i = 0; i < m_Container.size(); ++i) {
+			func(i, m_Container[i]);
+		}
+	}
+
+	// Iterates through each element in reverse heap order, the same as forEach
+	template <typename TFunc>
+	void forEachReverse(TFunc&& func) {
+		if constexpr (std::is_invocable_v<TFunc&, size_t, const TType&>) {
+			std::as_const(*this).forEachReverse(std::forward<TFunc>(func));
+		} else {
+			forEachReverseMutable(func);
+		}
+	}
+
+	template <typename TFunc>
+	void forEachReverse(TFunc&& func) const {
+		for (size_t i = m_Container.size(); i > 0; --i) {
+			func(i - 1, m_Container[i - 1]);
+		}
+	}
+
+	const_iterator begin() const { return m_Container.begin(); }
+
+	const_iterator end() const { return m_Container.end(); }
+
+	const_iterator cbegin() const { return m_Container.cbegin(); }
+
+	const_iterator cend() const { return m_Container.cend(); }
+
+	const_reverse_iterator rbegin() const { return m_Container.rbegin(); }
+
+	const_reverse_iterator rend() const { return m_Container.rend(); }
+
+	const_reverse_iterator crbegin() const { return m_Container.crbegin(); }
+
+	const_reverse_iterator crend() const { return m_Container.crend(); }
+
+protected:
+
+	constexpr static size_t invalidIndex = static_cast<size_t>(-1);
+
+	// Heaps decide the position themselves
+	virtual void push(size_t, const TType& obj) override {
+		push(obj);
+	}
+
+	virtual void push(size_t, TType&& obj) override {
+		push(std::move(obj));
+	}
+
+	Handle acquireHandle() {
+		if (!m_FreeHandles.empty()) {
+			const Handle handle = m_FreeHandles.back();
+			m_FreeHandles.pop_back();
+			return handle;
+		}
+		m_Positions.push_back(invalidIndex);
+		return m_Positions.size() - 1;
+	}
+
+	void linkPointer(const size_t index) {
+		if constexpr (sstl::is_managed_v<TType>) {
+			m_Pointers.emplace(sstl::getUnfurled(std::as_const(m_Container[index])), m_Handles[index]);
+		}
+	}
+
+	// Shared pointers can hold the same object more than once, so only the entry for this element's handle is removed
+	void unlinkPointer(const size_t index) {
+		if constexpr (sstl::is_managed_v<TType>) {
+			auto [itr, end] = m_Pointers.equal_range(sstl::getUnfurled(std::as_const(m_Container[index])));
+			for (; itr != end; ++itr) {
+				if (itr->second == m_Handles[index]) {
+					m_Pointers.erase(itr);
+					return;
+				}
+			}
+		}
+	}
+
+	// Puts obj and its handle at index, keeping the handle's position up to date
+	void place(const size_t index, TType&& obj, const Handle handle) {
+		m_Container[index] = std::move(obj);
+		m_Handles[index] = handle;
+		m_Positions[handle] = index;
+	}
+
+	void assign(const size_t index, TType&& obj) {
+		unlinkPointer(index);
+		m_Container[index] = std::move(obj);
+		linkPointer(index);
+		restore(index);
+	}
+
+	// Takes the element at index out of the heap and returns it
+	TType removeAt(const size_t index) {
+		unlinkPointer(index);
+		m_Positions[m_Handles[index]] = invalidIndex;
+		m_FreeHandles.push_back(m_Handles[index]);
+		TType obj = std::move(m_Container[index]);
+
+		// The last element fills the hole, then moves to wherever it belongs
+		const size_t last = m_Container.size() - 1;
+		if (index != last) {
+			place(index, std::move(m_Container[last]), m_Handles[last]);
+		}
+		m_Container.pop_back();
+		m_Handles.pop_back();
+		if (index != last) {
+			restore(index);
+		}
+		return obj;
+	}
+
+	template <typename TFunc>
+	void forEachMutable(TFunc& func) {
+		try {
+			for (size_t i = 0; i < m_Container.size(); ++i) {
+				func(i, m_Container[i]);
+			}
+		} catch (...) {
+			rebuild();
+			throw;
+		}
+		rebuild();
+	}
+
+	template <typename TFunc>
+	void forEachReverseMutable(TFunc& func) {
+		try {
+			for (size_t i = m_Container.size(); i > 0; --i) {
+				func(i - 1, m_Container[i - 1]);
+			}
+		} catch (...) {
+			rebuild();
+			throw;
+		}
+		rebuild();
+	}
+
+	// Puts every element back in heap order after any of them changed in place, each handle stays with its element
+	void rebuild() {
+		if constexpr (sstl::is_managed_v<TType>) {
+			m_Pointers.clear();
+			for (size_t i = 0; i < m_Container.size(); ++i) {
+				linkPointer(i);
+			}
+		}
+		if (m_Container.size() < 2) return;
+		for (size_t i = (m_Container.size() - 2) / TArity + 1; i > 0; --i) {
+			siftDown(i - 1);
+		}
+	}
+
+	// Moves the element at index up or down, whichever it needs
+	void restore(const size_t index) {
+		if (index > 0 && m_Compare(m_Container[(index - 1) / TArity], m_Container[index])) {
+			siftUp(index);
+		} else {
+			siftDown(index);
+		}
+	}
+
+	// Moves the element up until its parent should be above it, shifting parents down instead of swapping
+	void siftUp(size_t index) {
+		TType obj = std::move(m_Container[index]);
+		const Handle handle = m_Handles[index];
+		while (index > 0) {
+			const size_t parent = (index - 1) / TArity;
+			if (!m_Compare(m_Container[parent], obj)) break;
+			place(index, std::move(m_Container[parent]), m_Handles[parent]);
+			index = parent;
+		}
+		place(index, std::move(obj), handle);
+	}
+
+	// Moves the element down until none of its children should be above it
+	void siftDown(size_t index) {
+		TType obj = std::move(m_Container[index]);
+		const Handle handle = m_Handles[index];
+		const size_t size = m_Container.size();
+		while (true) {
+			const size_t first = index * TArity + 1;
+			if (first >= size) break;
+			const size_t last = std::min(first + TArity, size);
+			size_t best = first;
+			for (size_t child = first + 1; child < last; ++child) {
+				if (m_Compare(m_Container[best], m_Container[child])) {
+					best = child;
+				}
+			}
+			if (!m_Compare(obj, m_Container[best])) break;
+			place(index, std::move(m_Container[best]), m_Handles[best]);
+			index = best;
+		}
+		place(index, std::move(obj), handle);
+	}
+
+	template <typename TOther>
+	using rebind = typename std::allocator_traits<TAllocator>::template rebind_alloc<TOther>;
+
+	using pointer_key = const typename TUnfurled<TType>::Type*;
+
+	// Elements in heap order
+	std::vector<TType, TAllocator> m_Container;
+
+	// Handle of the element at each index
+	std::vector<Handle, rebind<Handle>> m_Handles;
+
+	// Index of the element for each handle, or invalidIndex if the handle is free
+	std::vector<size_t, rebind<size_t>> m_Positions;
+
+	std::vector<Handle, rebind<Handle>> m_FreeHandles;
+
+	// Handles of the elements holding each managed pointer, so pop and contains by pointer do not need to search
+	std::unordered_multimap<pointer_key, Handle, std::hash<pointer_key>, std::equal_to<pointer_key>, rebind<std::pair<const pointer_key, Handle>>> m_Pointers;
+
+	TCompare m_Compare;
+};
+
+// Indexed heap that is guaranteed to have the smallest value on top
+template <typename TType, size_t TArity = 4, typename TAllocator = std::allocator<TType>>
+struct TIndexedMinHeap : TIndexedHeap<TType, sstl::greater<TType>, TArity, TAllocator> {
+
+	TIndexedMinHeap() = default;
+
+	explicit TIndexedMinHeap(const TAllocator& allocator): TIndexedHeap<TType, sstl::greater<TType>, TArity, TAllocator>(allocator) {}
+
+	template <typename TOtherType = TType,
+		std::enable_if_t<std::is_copy_constructible_v<TOtherType>, int> = 0
+	>
+	TIndexedMinHeap(TInitializerList<TType> init): TIndexedHeap<TType, sstl::greater<TType>, TArity, TAllocator>(init) {}
+
+	template <typename... TArgs,
+		std::enable_if_t<std::conjunction_v<std::is_constructible<TType, TArgs>...>, int> = 0
+	>
+	explicit TIndexedMinHeap(TArgs&&... args): TIndexedHeap<TType, sstl::greater<TType>, TArity, TAllocator>(std::forward<TArgs>(args)...) {}
+};
+
+template <typename TType, typename... TArgs>
+TIndexedMinHeap(TType, TArgs...) -> TIndexedMinHeap<typename sstl::EnforceConvertible<TType, TArgs...>::Type>;
+
+// Indexed heap that is guaranteed to have the largest value on top
+template <typename TType, size_t TArity = 4, typename TAllocator = std::allocator<TType>>
+struct TIndexedMaxHeap : TIndexedHeap<TType, std::less<TType>, TArity, TAllocator> {
+
+	TIndexedMaxHeap() = default;
+
+	explicit TIndexedMaxHeap(const TAllocator& allocator): TIndexedHeap<TType, std::less<TType>, TArity, TAllocator>(allocator) {}
+
+	template <typename TOtherType = TType,
+		std::enable_if_t<std::is_copy_constructible_v<TOtherType>, int> = 0
+	>
+	TIndexedMaxHeap(TInitializerList<TType> init): TIndexedHeap<TType, std::less<TType>, TArity, TAllocator>(init) {}
+
+	template <typename... TArgs,
+		std::enable_if_t<std::conjunction_v<std::is_constructible<TType, TArgs>...>, int> = 0
+	>
+	explicit TIndexedMaxHeap(TArgs&&... args): TIndexedHeap<TType, std::less<TType>, TArity, TAllocator>(std::forward<TArgs>(args)...) {}
+};
+
+template <typename TType, typename... TArgs>
+TIndexedMaxHeap(TType, TArgs...) -> TIndexedMaxHeap<typename sstl::EnforceConvertible<TType, TArgs...>::Type>;
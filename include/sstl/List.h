@@ -4,11 +4,18 @@
 #include "Container.h"
 #include "InitializerList.h"
 
-template <typename TType>
+template <typename TType, typename TAllocator = std::allocator<TType>>
 struct TList : TSequenceContainer<TType> {
 
+	using iterator = typename std::list<TType, TAllocator>::iterator;
+	using const_iterator = typename std::list<TType, TAllocator>::const_iterator;
+	using reverse_iterator = typename std::list<TType, TAllocator>::reverse_iterator;
+	using const_reverse_iterator = typename std::list<TType, TAllocator>::const_reverse_iterator;
+
 	TList() = default;
 
+	explicit TList(const TAllocator& allocator): m_Container(allocator) {}
+
 	template <typename TOtherType = TType,
 		std::enable_if_t<std::is_copy_constructible_v<TOtherType>, int> = 0
 	>
@@ -25,6 +32,10 @@ struct TList : TSequenceContainer<TType> {
 		return m_Container.size();
 	}
 
+	[[nodiscard]] TAllocator getAllocator() const {
+		return m_Container.get_allocator();
+	}
+
 	virtual TType& top() override {
 		return m_Container.front();
 	}
@@ -149,6 +160,47 @@ struct TList : TSequenceContainer<TType> {
 		}
 	}
 
+	// Adds every element in [first, last)
+	template <typename TIterator>
+	void pushRange(TIterator first, TIterator last) {
+		m_Container.insert(m_Container.end(), first, last);
+	}
+
+	// Adds every element of another container or range, elements are moved out if it is an rvalue
+	template <typename TRange>
+	void pushRange(TRange&& range) {
+		if constexpr (std::is_rvalue_reference_v<TRange&&>) {
+			pushRange(std::make_move_iterator(range.begin()), std::make_move_iterator(range.end()));
+		} else {
+			pushRange(range.begin(), range.end());
+		}
+	}
+
+	// Splices every element out of otr, nothing is copied or moved
+	// Nodes can only be relinked between lists that share an allocator, otherwise the elements are moved one by one
+	void pushRange(TList&& otr) {
+		if (otr.m_Container.get_allocator() == m_Container.get_allocator()) {
+			m_Container.splice(m_Container.end(), otr.m_Container);
+			return;
+		}
+		pushRange(std::make_move_iterator(otr.begin()), std::make_move_iterator(otr.end()));
+		otr.clear();
+	}
+
+	// Constructs an element in place from args, no temporary TType is made
+	template <typename... TArgs>
+	TType& emplace(TArgs&&... args) {
+		return m_Container.emplace_back(std::forward<TArgs>(args)...);
+	}
+
+	// Constructs an element in place at index from args
+	template <typename... TArgs>
+	TType& emplaceAt(const size_t index, TArgs&&... args) {
+		auto itr = m_Container.begin();
+		std::advance(itr, index);
+		return *m_Container.emplace(itr, std::forward<TArgs>(args)...);
+	}
+
 	virtual void replace(const size_t index, const TType& obj) override {
 		if constexpr (std::is_copy_constructible_v<TType>) {
 			pop(index);
@@ -175,6 +227,11 @@ struct TList : TSequenceContainer<TType> {
 		m_Container.erase(m_Container.begin());
 	}
 
+	// Removes the last element in O(1)
+	virtual void popBack() override {
+		m_Container.pop_back();
+	}
+
 	virtual void pop(const size_t index) override {
 		auto itr = m_Container.begin();
 		std::advance(itr, index);
@@ -198,9 +255,17 @@ struct TList : TSequenceContainer<TType> {
 		}
 	}
 
+	virtual void popRange(const size_t start, const size_t end) override {
+		auto first = m_Container.begin();
+		std::advance(first, start);
+		auto last = first;
+		std::advance(last, end - start);
+		m_Container.erase(first, last);
+	}
+
 	// List transfer can use splicing
 	virtual void transfer(TSequenceContainer<TType>& otr, const size_t index) override {
-		if (auto otrList = dynamic_cast<TList*>(&otr)) {
+		if (auto otrList = dynamic_cast<TList*>(&otr); otrList && otrList->m_Container.get_allocator() == m_Container.get_allocator()) {
 			auto itr = m_Container.begin();
 			std::advance(itr, index);
 			otrList->m_Container.splice(otrList->m_Container.begin(), m_Container, itr);
@@ -209,6 +274,19 @@ struct TList : TSequenceContainer<TType> {
 		TSequenceContainer<TType>::transfer(otr, index);
 	}
 
+	// List transfer can splice the whole range at once
+	virtual void transferRange(TSequenceContainer<TType>& otr, const size_t start, const size_t end) override {
+		if (auto otrList = dynamic_cast<TList*>(&otr); otrList && otrList->m_Container.get_allocator() == m_Container.get_allocator()) {
+			auto first = m_Container.begin();
+			std::advance(first, start);
+			auto last = first;
+			std::advance(last, end - start);
+			otrList->m_Container.splice(otrList->m_Container.end(), m_Container, first, last);
+			return;
+		}
+		TSequenceContainer<TType>::transferRange(otr, start, end);
+	}
+
 	virtual void forEach(const std::function<void(size_t, TType&)>& func) override {
 		size_t i = 0;
 		for (auto itr = m_Container.begin(); itr != m_Container.end(); std::advance(itr, 1), ++i) {
@@ -237,9 +315,103 @@ struct TList : TSequenceContainer<TType> {
 		}
 	}
 
+	// Iterates through each element, accepts any callable so the loop can be inlined
+	template <typename TFunc>
+	void forEach(TFunc&& func) {
+		size_t i = 0;
+		for (auto itr = m_Container.begin(); itr != m_Container.end(); std::advance(itr, 1), ++i) {
+			func(i, *itr);
+		}
+	}
+
+	// Iterates through each element, const version
+	template <typename TFunc>
+	void forEach(TFunc&& func) const {
+		size_t i = 0;
+		for (auto itr = m_Container.begin(); itr != m_Container.end(); std::advance(itr, 1), ++i) {
+			func(i, *itr);
+		}
+	}
+
+	// Iterates through each element in reverse, accepts any callable so the loop can be inlined
+	template <typename TFunc>
+	void forEachReverse(TFunc&& func) {
+		size_t i = m_Container.size() - 1;
+		for (auto itr = m_Container.rbegin(); itr != m_Container.rend(); std::advance(itr, 1), --i) {
+			func(i, *itr);
+		}
+	}
+
+	// Iterates through each element in reverse, const version
+	template <typename TFunc>
+	void forEachReverse(TFunc&& func) const {
+		size_t i = m_Container.size() - 1;
+		for (auto itr = m_Container.rbegin(); itr != m_Container.rend(); std::advance(itr, 1), --i) {
+			func(i, *itr);
+		}
+	}
+
+	template <typename TFunc>
+	void doFor(const size_t index, TFunc&& func) {
+		auto itr = m_Container.begin();
+		std::advance(itr, index);
+		func(*itr);
+	}
+
+	template <typename TFunc>
+	void doFor(const size_t index, TFunc&& func) const {
+		auto itr = m_Container.begin();
+		std::advance(itr, index);
+		func(*itr);
+	}
+
+	// Walks the list once, rather than seeking to every index
+	template <typename TFunc>
+	void doFor(const size_t start, const size_t end, TFunc&& func) {
+		auto itr = m_Container.begin();
+		std::advance(itr, start);
+		for (size_t i = start; i < end; std::advance(itr, 1), ++i) {
+			func(i, *itr);
+		}
+	}
+
+	// Walks the list once, rather than seeking to every index
+	template <typename TFunc>
+	void doFor(const size_t start, const size_t end, TFunc&& func) const {
+		auto itr = m_Container.begin();
+		std::advance(itr, start);
+		for (size_t i = start; i < end; std::advance(itr, 1), ++i) {
+			func(i, *itr);
+		}
+	}
+
+	iterator begin() { return m_Container.begin(); }
+
+	const_iterator begin() const { return m_Container.begin(); }
+
+	iterator end() { return m_Container.end(); }
+
+	const_iterator end() const { return m_Container.end(); }
+
+	const_iterator cbegin() const { return m_Container.cbegin(); }
+
+	const_iterator cend() const { return m_Container.cend(); }
+
+	reverse_iterator rbegin() { return m_Container.rbegin(); }
+
+	const_reverse_iterator rbegin() const { return m_Container.rbegin(); }
+
+	reverse_iterator rend() { return m_Container.rend(); }
+
+	const_reverse_iterator rend() const { return m_Container.rend(); }
+
+	const_reverse_iterator crbegin() const { return m_Container.crbegin(); }
+
+	const_reverse_iterator crend() const { return m_Container.crend(); }
+
 protected:
 
-	std::list<TType> m_Container;
+	std::list<TType, TAllocator> m_Container;
 };
 
 template <typename TType, typename... TArgs>
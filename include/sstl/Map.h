@@ -1,16 +1,23 @@
 ﻿#pragma once
 
+#include <iterator>
 #include <unordered_map>
+#include <tuple>
 #include "Container.h"
 #include "InitializerList.h"
 
-template <typename TKeyType, typename TValueType,
+template <typename TKeyType, typename TValueType, typename TAllocator = std::allocator<std::pair<const TKeyType, TValueType>>,
 	std::enable_if_t<sstl::is_hashable_v<TKeyType>, int> = 0
 >
 struct TMap : TAssociativeContainer<TKeyType, TValueType> {
 
+	using iterator = typename std::unordered_map<TKeyType, TValueType, sstl::hasher<TKeyType>, std::equal_to<TKeyType>, TAllocator>::iterator;
+	using const_iterator = typename std::unordered_map<TKeyType, TValueType, sstl::hasher<TKeyType>, std::equal_to<TKeyType>, TAllocator>::const_iterator;
+
 	TMap() = default;
 
+	explicit TMap(const TAllocator& allocator): m_Container(allocator) {}
+
 	template <typename TOtherValueType = TValueType,
 		std::enable_if_t<std::is_copy_constructible_v<TOtherValueType>, int> = 0
 	>
@@ -21,7 +28,10 @@ struct TMap : TAssociativeContainer<TKeyType, TValueType> {
 		}
 	}
 
-	template <typename... TPairs>
+	// An allocator on its own goes to the allocator constructor instead
+	template <typename... TPairs,
+		std::enable_if_t<!std::disjunction_v<std::is_convertible<TPairs, TAllocator>...>, int> = 0
+	>
 	explicit TMap(TPairs&&... args) {
 		m_Container.reserve(sizeof...(TPairs));
 		(m_Container.emplace(std::forward<typename TPairs::KeyType>(args.key()), std::forward<typename TPairs::ValueType>(args.value())), ...);
@@ -31,6 +41,10 @@ struct TMap : TAssociativeContainer<TKeyType, TValueType> {
 		return m_Container.size();
 	}
 
+	[[nodiscard]] TAllocator getAllocator() const {
+		return m_Container.get_allocator();
+	}
+
 	virtual TPair<TKeyType, const TValueType&> top() const override {
 		return TPair<TKeyType, const TValueType&>{*m_Container.begin()};
 	}
@@ -76,8 +90,7 @@ struct TMap : TAssociativeContainer<TKeyType, TValueType> {
 
 	virtual TValueType& push(const TKeyType& key) override {
 		if constexpr (std::is_default_constructible_v<TValueType>) {
-			push(TPair<TKeyType, TValueType>{key, {}});
-			return get(key);
+			return m_Container.emplace(std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple()).first->second;
 		} else {
 			throw std::runtime_error("Type is not default constructible!");
 		}
@@ -85,8 +98,7 @@ struct TMap : TAssociativeContainer<TKeyType, TValueType> {
 
 	virtual TValueType& push(const TKeyType& key, const TValueType& value) override {
 		if constexpr (std::is_copy_constructible_v<TValueType>) {
-			push(TPair<TKeyType, TValueType>{key, value});
-			return get(key);
+			return m_Container.emplace(key, value).first->second;
 		} else {
 			throw std::runtime_error("Type is not copyable!");
 		}
@@ -94,8 +106,7 @@ struct TMap : TAssociativeContainer<TKeyType, TValueType> {
 
 	virtual TValueType& push(const TKeyType& key, TValueType&& value) override {
 		if constexpr (std::is_move_constructible_v<TValueType>) {
-			push(TPair<TKeyType, TValueType>{key, std::move(value)});
-			return get(key);
+			return m_Container.emplace(key, std::move(value)).first->second;
 		} else {
 			throw std::runtime_error("Type is not moveable!");
 		}
@@ -117,10 +128,63 @@ struct TMap : TAssociativeContainer<TKeyType, TValueType> {
 		}
 	}
 
+	// Constructs the value in place from args, no temporary pair or value is made
+	template <typename... TArgs>
+	TValueType& emplace(const TKeyType& key, TArgs&&... args) {
+		return m_Container.emplace(std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple(std::forward<TArgs>(args)...)).first->second;
+	}
+
+	// Constructs the value in place only if key is not already present, args are left untouched otherwise
+	template <typename... TArgs>
+	TValueType& tryEmplace(const TKeyType& key, TArgs&&... args) {
+		return m_Container.try_emplace(key, std::forward<TArgs>(args)...).first->second;
+	}
+
+	// Adds every std::pair in [first, last), the table is only grown once up front instead of rehashing as it fills
+	template <typename TIterator>
+	void pushRange(TIterator first, TIterator last) {
+		if constexpr (std::is_base_of_v<std::forward_iterator_tag, typename std::iterator_traits<TIterator>::iterator_category>) {
+			m_Container.reserve(m_Container.size() + static_cast<size_t>(std::distance(first, last)));
+		}
+		m_Container.insert(first, last);
+	}
+
+	// Adds every pair of another container or range, pairs are moved out if it is an rvalue
+	template <typename TRange>
+	void pushRange(TRange&& range) {
+		if constexpr (std::is_rvalue_reference_v<TRange&&>) {
+			pushRange(std::make_move_iterator(range.begin()), std::make_move_iterator(range.end()));
+		} else {
+			pushRange(range.begin(), range.end());
+		}
+	}
+
+	// Moves every pair of otr whose key is not already present into this map, pairs whose key is stay in otr
+	// The nodes are relinked rather than copied, so nothing is allocated and values keep their address
+	// Nodes can only be relinked between maps that share an allocator, otherwise the pairs are moved one by one
+	void merge(TMap& otr) {
+		if (otr.m_Container.get_allocator() == m_Container.get_allocator()) {
+			m_Container.merge(otr.m_Container);
+			return;
+		}
+		for (auto itr = otr.m_Container.begin(); itr != otr.m_Container.end();) {
+			if (m_Container.find(itr->first) != m_Container.end()) {
+				++itr;
+				continue;
+			}
+			auto node = otr.m_Container.extract(itr++);
+			m_Container.emplace(std::move(node.key()), std::move(node.mapped()));
+		}
+	}
+
+	void merge(TMap&& otr) {
+		merge(otr);
+	}
+
 	virtual void replace(const TKeyType& key, const TValueType& obj) override {
 		if constexpr (std::is_copy_constructible_v<TValueType>) {
 			pop(key);
-			push(TPair<TKeyType, TValueType>{key, obj});
+			m_Container.emplace(key, obj);
 		} else {
 			throw std::runtime_error("Type is not copyable!");
 		}
@@ -129,7 +193,7 @@ struct TMap : TAssociativeContainer<TKeyType, TValueType> {
 	virtual void replace(const TKeyType& key, TValueType&& obj) override {
 		if constexpr (std::is_move_constructible_v<TValueType>) {
 			pop(key);
-			push(TPair<TKeyType, TValueType>{key, std::move(obj)});
+			m_Container.emplace(key, std::move(obj));
 		} else {
 			throw std::runtime_error("Type is not moveable!");
 		}
@@ -163,15 +227,31 @@ struct TMap : TAssociativeContainer<TKeyType, TValueType> {
 		}
 	}
 
+	// Iterates through each element, accepts any callable so the loop can be inlined
+	template <typename TFunc>
+	void forEach(TFunc&& func) const {
+		for (auto itr = m_Container.begin(); itr != m_Container.end(); ++itr) {
+			func(TPair<TKeyType, const TValueType&>{itr->first, itr->second});
+		}
+	}
+
+	iterator begin() { return m_Container.begin(); }
+
+	const_iterator begin() const { return m_Container.begin(); }
+
+	iterator end() { return m_Container.end(); }
+
+	const_iterator end() const { return m_Container.end(); }
+
+	const_iterator cbegin() const { return m_Container.cbegin(); }
+
+	const_iterator cend() const { return m_Container.cend(); }
+
 protected:
 
-	struct Hasher {
-		size_t operator()(const TKeyType& p) const noexcept {
-			return getHash(p);
-		}
-	};
+	using Hasher = sstl::hasher<TKeyType>;
 
-	std::unordered_map<TKeyType, TValueType, Hasher> m_Container;
+	std::unordered_map<TKeyType, TValueType, Hasher, std::equal_to<TKeyType>, TAllocator> m_Container;
 };
 
 template <typename TKeyType, typename TValueType>
@@ -4,70 +4,109 @@
 #include "Vector.h"
 
 // Priority Vector is a vector that makes itself into a max heap, it is guaranteed the top value is always the largest
-template <typename TType>
-struct TMaxHeap : TVector<TType> {
+template <typename TType, typename TAllocator = std::allocator<TType>>
+struct TMaxHeap : TVector<TType, TAllocator> {
 
 	TMaxHeap() = default;
 
+	explicit TMaxHeap(const TAllocator& allocator): TVector<TType, TAllocator>(allocator) {}
+
 	template <typename TOtherType = TType,
 		std::enable_if_t<std::is_copy_constructible_v<TOtherType>, int> = 0
 	>
-	TMaxHeap(TInitializerList<TType> init): TVector<TType>(init) {}
+	TMaxHeap(TInitializerList<TType> init): TVector<TType, TAllocator>(init) {}
 
 	template <typename... TArgs,
 		std::enable_if_t<std::conjunction_v<std::is_constructible<TType, TArgs>...>, int> = 0
 	>
-	explicit TMaxHeap(TArgs&&... args): TVector<TType>(std::forward<TArgs>(args)...) {}
+	explicit TMaxHeap(TArgs&&... args): TVector<TType, TAllocator>(std::forward<TArgs>(args)...) {}
 
 	virtual void resize(size_t amt) override {
-		TVector<TType>::resize(amt);
-		std::make_heap(TVector<TType>::m_Container.begin(), TVector<TType>::m_Container.end(), std::less<TType>{});
+		TVector<TType, TAllocator>::resize(amt);
+		std::make_heap(TVector<TType, TAllocator>::m_Container.begin(), TVector<TType, TAllocator>::m_Container.end(), std::less<TType>{});
 	}
 
 	virtual void resize(const size_t amt, std::function<TType(size_t)> func) override {
-		TVector<TType>::resize(amt, func);
-		std::make_heap(TVector<TType>::m_Container.begin(), TVector<TType>::m_Container.end(), std::less<TType>{});
+		TVector<TType, TAllocator>::resize(amt, func);
+		std::make_heap(TVector<TType, TAllocator>::m_Container.begin(), TVector<TType, TAllocator>::m_Container.end(), std::less<TType>{});
 	}
 
 	virtual TType& push() override {
-		TVector<TType>::push();
-		std::push_heap(TVector<TType>::m_Container.begin(), TVector<TType>::m_Container.end(), std::less<TType>{});
-		return TVector<TType>::get(TVector<TType>::getSize() - 1);
+		TVector<TType, TAllocator>::push();
+		std::push_heap(TVector<TType, TAllocator>::m_Container.begin(), TVector<TType, TAllocator>::m_Container.end(), std::less<TType>{});
+		return TVector<TType, TAllocator>::get(TVector<TType, TAllocator>::getSize() - 1);
 	}
 
 	virtual size_t push(const TType& obj) override {
-		TVector<TType>::push(obj);
-		std::push_heap(TVector<TType>::m_Container.begin(), TVector<TType>::m_Container.end(), std::less<TType>{});
-		return TVector<TType>::getSize() - 1;
+		TVector<TType, TAllocator>::push(obj);
+		std::push_heap(TVector<TType, TAllocator>::m_Container.begin(), TVector<TType, TAllocator>::m_Container.end(), std::less<TType>{});
+		return TVector<TType, TAllocator>::getSize() - 1;
 	}
 
 	virtual size_t push(TType&& obj) override {
-		TVector<TType>::push(std::move(obj));
-		std::push_heap(TVector<TType>::m_Container.begin(), TVector<TType>::m_Container.end(), std::less<TType>{});
-		return TVector<TType>::getSize() - 1;
+		TVector<TType, TAllocator>::push(std::move(obj));
+		std::push_heap(TVector<TType, TAllocator>::m_Container.begin(), TVector<TType, TAllocator>::m_Container.end(), std::less<TType>{});
+		return TVector<TType, TAllocator>::getSize() - 1;
+	}
+
+	// Adds every element in [first, last), then restores the heap in whichever way is cheaper
+	template <typename TIterator>
+	void pushRange(TIterator first, TIterator last) {
+		const size_t previousSize = TVector<TType, TAllocator>::getSize();
+		TVector<TType, TAllocator>::pushRange(first, last);
+		restoreHeap(previousSize);
 	}
 
+	// Adds every element of another container or range, elements are moved out if it is an rvalue
+	template <typename TRange>
+	void pushRange(TRange&& range) {
+		const size_t previousSize = TVector<TType, TAllocator>::getSize();
+		TVector<TType, TAllocator>::pushRange(std::forward<TRange>(range));
+		restoreHeap(previousSize);
+	}
+
+	// Constructs an element in place, then sifts it up, so there is no reference to return
+	template <typename... TArgs>
+	void emplace(TArgs&&... args) {
+		TVector<TType, TAllocator>::emplace(std::forward<TArgs>(args)...);
+		std::push_heap(TVector<TType, TAllocator>::m_Container.begin(), TVector<TType, TAllocator>::m_Container.end(), std::less<TType>{});
+	}
+
+	// pop_heap moves the top to the back, so removing it from there keeps pop O(log n)
 	virtual void pop() override {
-		std::pop_heap(TVector<TType>::m_Container.begin(), TVector<TType>::m_Container.end(), std::less<TType>{});
-		TVector<TType>::pop();
+		std::pop_heap(TVector<TType, TAllocator>::m_Container.begin(), TVector<TType, TAllocator>::m_Container.end(), std::less<TType>{});
+		TVector<TType, TAllocator>::popBack();
 	}
 
 	virtual void pop(const TType& obj) override {
-		TVector<TType>::pop(obj);
-		std::make_heap(TVector<TType>::m_Container.begin(), TVector<TType>::m_Container.end(), std::less<TType>{});
+		TVector<TType, TAllocator>::pop(obj);
+		std::make_heap(TVector<TType, TAllocator>::m_Container.begin(), TVector<TType, TAllocator>::m_Container.end(), std::less<TType>{});
 	}
 
 	virtual void pop(typename TUnfurled<TType>::Type* obj) override {
 		if constexpr (sstl::is_managed_v<TType>) {
-			ERASE(TVector<TType>::m_Container, obj, TUnfurled<TType>::get);
-			std::make_heap(TVector<TType>::m_Container.begin(), TVector<TType>::m_Container.end(), std::less<TType>{});
+			ERASE((TVector<TType, TAllocator>::m_Container), obj, TUnfurled<TType>::get);
+			std::make_heap(TVector<TType, TAllocator>::m_Container.begin(), TVector<TType, TAllocator>::m_Container.end(), std::less<TType>{});
 		} else {
 			pop(*obj);
 		}
 	}
 
+	// Writing through an iterator could break the heap, so only const iterators are exposed
+	typename TVector<TType, TAllocator>::const_iterator begin() const { return TVector<TType, TAllocator>::begin(); }
+
+	typename TVector<TType, TAllocator>::const_iterator end() const { return TVector<TType, TAllocator>::end(); }
+
+	typename TVector<TType, TAllocator>::const_reverse_iterator rbegin() const { return TVector<TType, TAllocator>::rbegin(); }
+
+	typename TVector<TType, TAllocator>::const_reverse_iterator rend() const { return TVector<TType, TAllocator>::rend(); }
+
 protected:
 
+	virtual void transferIn(typename TVector<TType, TAllocator>::iterator first, typename TVector<TType, TAllocator>::iterator last) override {
+		pushRange(std::make_move_iterator(first), std::make_move_iterator(last));
+	}
+
 	virtual void push(const size_t index, const TType& obj) override {
 		push(obj);
 	}
@@ -76,9 +115,38 @@ protected:
 		push(std::move(obj));
 	}
 
+	// Heaps decide the position themselves
+	template <typename... TArgs>
+	void emplaceAt(const size_t index, TArgs&&... args) {
+		emplace(std::forward<TArgs>(args)...);
+	}
+
+	// Reordering the elements would break the heap, pop from the top to get them in order
+	using TVector<TType, TAllocator>::sort;
+	using TVector<TType, TAllocator>::stableSort;
+	using TVector<TType, TAllocator>::partialSort;
+	using TVector<TType, TAllocator>::nthElement;
+
 	virtual void pop(const size_t index) override {
-		TVector<TType>::pop(index);
-		std::make_heap(TVector<TType>::m_Container.begin(), TVector<TType>::m_Container.end(), std::less<TType>{});
+		TVector<TType, TAllocator>::pop(index);
+		std::make_heap(TVector<TType, TAllocator>::m_Container.begin(), TVector<TType, TAllocator>::m_Container.end(), std::less<TType>{});
+	}
+
+	virtual void popRange(const size_t start, const size_t end) override {
+		TVector<TType, TAllocator>::popRange(start, end);
+		std::make_heap(TVector<TType, TAllocator>::m_Container.begin(), TVector<TType, TAllocator>::m_Container.end(), std::less<TType>{});
+	}
+
+	// Rebuilding is O(n), so only sift up the new elements if there are few of them
+	void restoreHeap(const size_t previousSize) {
+		auto& container = TVector<TType, TAllocator>::m_Container;
+		if (container.size() - previousSize > previousSize) {
+			std::make_heap(container.begin(), container.end(), std::less<TType>{});
+			return;
+		}
+		for (size_t i = previousSize + 1; i <= container.size(); ++i) {
+			std::push_heap(container.begin(), container.begin() + i, std::less<TType>{});
+		}
 	}
 };
 
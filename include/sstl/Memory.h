@@ -1,11 +1,17 @@
 ﻿#pragma once
 
+#include <atomic>
+#include <cstdint>
 #include <memory>
+#include <utility>
 
 namespace sstl {
 	template <typename>
 	struct is_managed;
 
+	template <typename>
+	struct object_pool;
+
 #ifndef SIMPLESTL_INIT
 	template <typename>
 	constexpr bool is_initializable_v = false;
@@ -148,6 +154,60 @@ namespace sstl {
 		}
 	};
 
+	// Allocator for std::allocate_shared, so the object and its reference counts share one allocation and usually one cache line
+	// The control block destroys the object through destroy, which calls the destroy() hook first just like deleter does
+	template <typename TType>
+	struct hook_allocator {
+		using value_type = TType;
+
+		constexpr hook_allocator() noexcept = default;
+
+		template <typename TOtherType>
+		constexpr hook_allocator(const hook_allocator<TOtherType>&) noexcept {}
+
+		TType* allocate(const size_t amt) {
+			return std::allocator<TType>().allocate(amt);
+		}
+
+		void deallocate(TType* ptr, const size_t amt) noexcept {
+			std::allocator<TType>().deallocate(ptr, amt);
+		}
+
+		template <typename TOtherType, typename... TArgs>
+		void construct(TOtherType* ptr, TArgs&&... args) {
+			::new (static_cast<void*>(ptr)) TOtherType(std::forward<TArgs>(args)...);
+		}
+
+		template <typename TOtherType>
+		void destroy(TOtherType* ptr) noexcept {
+			static_assert(0 < sizeof(TOtherType), "Can't delete an incomplete type!");
+			if constexpr (sstl::is_destroyable_v<TOtherType>) {
+				ptr->destroy();
+			}
+			ptr->~TOtherType();
+		}
+
+		friend bool operator==(const hook_allocator&, const hook_allocator&) noexcept {
+			return true;
+		}
+
+		friend bool operator!=(const hook_allocator&, const hook_allocator&) noexcept {
+			return false;
+		}
+	};
+
+	// Makes the shared pointer behind TShared, in one allocation unless the type releases itself
+	// release() is free to delete the object, which it cannot do when the object lives inside the control block, so those keep the separate allocation and deleter
+	template <typename TType, typename... TArgs>
+	std::shared_ptr<TType> make_shared_impl(TArgs&&... args) {
+		using TObject = std::remove_cv_t<TType>;
+		if constexpr (sstl::is_releasable_v<TObject>) {
+			return std::shared_ptr<TType>(new TType(std::forward<TArgs>(args)...), sstl::deleter<TType>());
+		} else {
+			return std::allocate_shared<TObject>(sstl::hook_allocator<TObject>(), std::forward<TArgs>(args)...);
+		}
+	}
+
 	template <typename TType>
 	struct SharedDeleter {
 		using Type = TType;
@@ -211,6 +271,19 @@ struct TUnique {
 		}
 	}
 
+	// Constructs the object in a slot of pool instead of with new, and gives the slot back to the pool once nothing owns it
+	// init() and destroy() are called just as they are for new, pool comes from sstl/Allocator.h and must outlive the object
+	template <typename TOtherType = TType, typename... TArgs,
+		std::enable_if_t<std::is_convertible_v<TOtherType*, TType*>, int> = 0
+	>
+	static TUnique createIn(sstl::object_pool<TOtherType>& pool, TArgs&&... args) {
+		TUnique<TOtherType> obj{std::unique_ptr<TOtherType, sstl::delayed_deleter<TOtherType>>(pool.create(std::forward<TArgs>(args)...), sstl::delayed_deleter<TOtherType>(&sstl::object_pool<TOtherType>::delete_impl))};
+		if constexpr (sstl::is_initializable_v<TOtherType>) {
+			obj->init();
+		}
+		return obj;
+	}
+
 	template <typename TOtherType = TType,
 		std::enable_if_t<std::is_convertible_v<TOtherType*, TType*>, int> = 0
 	>
@@ -380,7 +453,7 @@ struct TShared {
 	_CONSTEXPR23 TShared() noexcept {
 		// If not default constructible, default to nullptr
 		if constexpr (std::is_default_constructible_v<TType>) {
-			m_ptr = std::shared_ptr<TType>(new TType(), sstl::deleter<TType>());
+			m_ptr = sstl::make_shared_impl<TType>();
 			if constexpr (sstl::is_initializable_v<TType>) {
 				m_ptr->init();
 			}
@@ -415,7 +488,7 @@ struct TShared {
 			int> = 0
 	>
 	_CONSTEXPR23 explicit TShared(TArgs&&... args) noexcept {
-		m_ptr = std::shared_ptr<TType>(new TType(std::forward<TArgs>(args)...), sstl::deleter<TType>());
+		m_ptr = sstl::make_shared_impl<TType>(std::forward<TArgs>(args)...);
 		if constexpr (sstl::is_initializable_v<TType>) {
 			m_ptr->init();
 		}
@@ -826,6 +899,9 @@ template <typename TOtherType>
 _CONSTEXPR23 TShared<TType>::TShared(TWeak<TOtherType>& shared) noexcept
 : m_ptr(shared.m_ptr) {}
 
+template <typename>
+struct TIntrusive;
+
 template <typename TType>
 struct TFrail {
 
@@ -873,6 +949,14 @@ struct TFrail {
 	TFrail(std::unique_ptr<TOtherType>& unique) noexcept
 	: m_ptr(unique.get()) {}
 
+	template <typename TOtherType>
+	TFrail(const TIntrusive<TOtherType>& intrusive) noexcept
+	: m_ptr(intrusive.get()) {}
+
+	template <typename TOtherType>
+	TFrail(TIntrusive<TOtherType>& intrusive) noexcept
+	: m_ptr(intrusive.get()) {}
+
 	TFrail() = default;
 
 	TFrail(TType* ptr): m_ptr(ptr) {}
@@ -1076,6 +1160,274 @@ private:
 	mutable std::weak_ptr<TType> _Wptr;
 };
 
+// Mixin that keeps the reference count of a TIntrusive inside the object, so the pointer is a single raw pointer and there is no control block
+// TAtomic picks atomic counting for objects shared between threads, objects that stay on one thread can skip the atomic operations
+// A copied object starts with its own count of 0, the same way TSharedFrom does not copy its weak pointer
+template <bool TAtomic = true>
+struct TRefCounted {
+
+	[[nodiscard]] uint32_t getRefCount() const noexcept {
+		if constexpr (TAtomic) {
+			return m_RefCount.load(std::memory_order_acquire);
+		} else {
+			return m_RefCount;
+		}
+	}
+
+protected:
+	constexpr TRefCounted() noexcept = default;
+
+	TRefCounted(const TRefCounted&) noexcept {}
+
+	TRefCounted& operator=(const TRefCounted&) noexcept {
+		return *this;
+	}
+
+	~TRefCounted() = default;
+
+private:
+	template <typename>
+	friend struct TIntrusive;
+
+	void addRef() const noexcept {
+		if constexpr (TAtomic) {
+			m_RefCount.fetch_add(1, std::memory_order_relaxed);
+		} else {
+			++m_RefCount;
+		}
+	}
+
+	// Returns true if this removed the last reference
+	bool removeRef() const noexcept {
+		if constexpr (TAtomic) {
+			return m_RefCount.fetch_sub(1, std::memory_order_acq_rel) == 1;
+		} else {
+			return --m_RefCount == 0;
+		}
+	}
+
+	mutable std::conditional_t<TAtomic, std::atomic<uint32_t>, uint32_t> m_RefCount{0};
+};
+
+// Shared ownership of an object deriving from TRefCounted, the size of a raw pointer
+// The last owner to let go calls sstl::deleter, so destroy() and release() are called just as they are for TShared
+// Since the count lives in the object, a TIntrusive can be made again from a raw pointer at any time without a second owner count
+template <typename TType>
+struct TIntrusive {
+
+	_CONSTEXPR23 TIntrusive() noexcept {
+		// If not default constructible, default to nullptr
+		if constexpr (std::is_default_constructible_v<TType>) {
+			reset(new TType());
+			if constexpr (sstl::is_initializable_v<TType>) {
+				m_ptr->init();
+			}
+		}
+	}
+
+	_CONSTEXPR23 TIntrusive(nullptr_t) noexcept {}
+
+	_CONSTEXPR23 TIntrusive& operator=(nullptr_t) noexcept {
+		reset(nullptr);
+		return *this;
+	}
+
+	template <typename TOtherType = TType,
+		std::enable_if_t<std::is_convertible_v<TOtherType*, TType*>, int> = 0
+	>
+	_CONSTEXPR23 explicit TIntrusive(TOtherType* ptr) noexcept {
+		static_assert(std::is_same_v<TOtherType, TType> || std::has_virtual_destructor_v<TType>, "The last owner may be a TIntrusive<TType>, which can only delete a derived object through a virtual destructor!");
+		reset(ptr);
+	}
+
+	template <typename... TArgs,
+		std::enable_if_t<
+			std::conjunction_v<
+				std::negation<std::is_null_pointer<std::decay_t<TArgs>>>...,
+				std::negation<sstl::is_managed<TArgs>>...
+			>,
+			int> = 0
+	>
+	_CONSTEXPR23 explicit TIntrusive(TArgs&&... args) noexcept {
+		reset(new TType(std::forward<TArgs>(args)...));
+		if constexpr (sstl::is_initializable_v<TType>) {
+			m_ptr->init();
+		}
+	}
+
+	/*
+	 * Allow copies of same type
+	 */
+
+	_CONSTEXPR23 TIntrusive(const TIntrusive& otr) noexcept {
+		reset(otr.m_ptr);
+	}
+
+	_CONSTEXPR23 TIntrusive(TIntrusive& otr) noexcept {
+		reset(otr.m_ptr);
+	}
+
+	_CONSTEXPR23 TIntrusive(TIntrusive&& otr) noexcept
+	: m_ptr(std::exchange(otr.m_ptr, nullptr)) {}
+
+	// Unlike TShared, copies from a derived type are allowed, since all it takes is another count on the same object
+	// Any owner may end up deleting the object, so TType needs a virtual destructor unless the types match
+	template <typename TOtherType = TType,
+		std::enable_if_t<std::is_convertible_v<TOtherType*, TType*>, int> = 0
+	>
+	_CONSTEXPR23 TIntrusive(const TIntrusive<TOtherType>& otr) noexcept {
+		static_assert(std::is_same_v<TOtherType, TType> || std::has_virtual_destructor_v<TType>, "The last owner may be a TIntrusive<TType>, which can only delete a derived object through a virtual destructor!");
+		reset(otr.m_ptr);
+	}
+
+	template <typename TOtherType = TType,
+		std::enable_if_t<std::is_convertible_v<TOtherType*, TType*>, int> = 0
+	>
+	_CONSTEXPR23 TIntrusive(TIntrusive<TOtherType>& otr) noexcept {
+		static_assert(std::is_same_v<TOtherType, TType> || std::has_virtual_destructor_v<TType>, "The last owner may be a TIntrusive<TType>, which can only delete a derived object through a virtual destructor!");
+		reset(otr.m_ptr);
+	}
+
+	template <typename TOtherType = TType,
+		std::enable_if_t<std::is_convertible_v<TOtherType*, TType*>, int> = 0
+	>
+	_CONSTEXPR23 TIntrusive(TIntrusive<TOtherType>&& otr) noexcept
+	: m_ptr(std::exchange(otr.m_ptr, nullptr)) {
+		static_assert(std::is_same_v<TOtherType, TType> || std::has_virtual_destructor_v<TType>, "The last owner may be a TIntrusive<TType>, which can only delete a derived object through a virtual destructor!");
+	}
+
+	_CONSTEXPR23 ~TIntrusive() noexcept {
+		reset(nullptr);
+	}
+
+	_CONSTEXPR23 TIntrusive& operator=(const TIntrusive& otr) noexcept {
+		reset(otr.m_ptr);
+		return *this;
+	}
+
+	_CONSTEXPR23 TIntrusive& operator=(TIntrusive& otr) noexcept {
+		reset(otr.m_ptr);
+		return *this;
+	}
+
+	_CONSTEXPR23 TIntrusive& operator=(TIntrusive&& otr) noexcept {
+		if (this != &otr) {
+			reset(nullptr);
+			m_ptr = std::exchange(otr.m_ptr, nullptr);
+		}
+		return *this;
+	}
+
+	template <typename TOtherType = TType,
+		std::enable_if_t<std::is_convertible_v<TOtherType*, TType*>, int> = 0
+	>
+	_CONSTEXPR23 TIntrusive& operator=(TIntrusive<TOtherType>&& otr) noexcept {
+		static_assert(std::is_same_v<TOtherType, TType> || std::has_virtual_destructor_v<TType>, "The last owner may be a TIntrusive<TType>, which can only delete a derived object through a virtual destructor!");
+		reset(nullptr);
+		m_ptr = std::exchange(otr.m_ptr, nullptr);
+		return *this;
+	}
+
+	size_t count() const noexcept {
+		return m_ptr ? m_ptr->getRefCount() : 0;
+	}
+
+	// Releases ownership of the pointer, note the object will not be destroyed unless all other intrusive pointers are
+	void destroy() noexcept {
+		reset(nullptr);
+	}
+
+	template <typename TOtherType>
+	_CONSTEXPR23 TIntrusive<TOtherType> staticCast() const noexcept {
+		return TIntrusive<TOtherType>{static_cast<TOtherType*>(m_ptr)};
+	}
+
+	template <typename TOtherType>
+	_CONSTEXPR23 TIntrusive<TOtherType> dynamicCast() const noexcept {
+		return TIntrusive<TOtherType>{dynamic_cast<TOtherType*>(m_ptr)};
+	}
+
+	template <typename TOtherType>
+	_CONSTEXPR23 TIntrusive<TOtherType> constCast() const noexcept {
+		return TIntrusive<TOtherType>{const_cast<TOtherType*>(m_ptr)};
+	}
+
+	_CONSTEXPR23 TType* operator->() const noexcept {
+		return m_ptr;
+	}
+
+	_CONSTEXPR23 TType& operator*() const noexcept {
+		return *m_ptr;
+	}
+
+	_CONSTEXPR23 TType* get() const noexcept { return m_ptr; }
+
+	_CONSTEXPR23 operator bool() const noexcept {
+		return m_ptr != nullptr;
+	}
+
+	_CONSTEXPR23 friend bool operator<(const TIntrusive& fst, const TIntrusive& snd) noexcept {
+		return std::less<TType*>()(fst.m_ptr, snd.m_ptr);
+	}
+
+	_CONSTEXPR23 friend bool operator<=(const TIntrusive& fst, const TIntrusive& snd) noexcept {
+		return !(snd < fst);
+	}
+
+	_CONSTEXPR23 friend bool operator>(const TIntrusive& fst, const TIntrusive& snd) noexcept {
+		return snd < fst;
+	}
+
+	_CONSTEXPR23 friend bool operator>=(const TIntrusive& fst, const TIntrusive& snd) noexcept {
+		return !(fst < snd);
+	}
+
+	_CONSTEXPR23 friend bool operator==(const TIntrusive& fst, const TIntrusive& snd) noexcept {
+		return fst.m_ptr == snd.m_ptr;
+	}
+
+	// Compare raw pointer
+	_CONSTEXPR23 friend bool operator==(const TIntrusive& fst, const void* snd) noexcept {
+		return fst.m_ptr == snd;
+	}
+
+	_CONSTEXPR23 friend bool operator!=(const TIntrusive& fst, const TIntrusive& snd) noexcept {
+		return fst.m_ptr != snd.m_ptr;
+	}
+
+	// Compare raw pointer
+	_CONSTEXPR23 friend bool operator!=(const TIntrusive& fst, const void* snd) noexcept {
+		return fst.m_ptr != snd;
+	}
+
+	_CONSTEXPR23 friend size_t getHash(const TIntrusive& obj) noexcept {
+		std::hash<TType*> ptrHash;
+		return ptrHash(obj.m_ptr);
+	}
+
+private:
+
+	template <typename>
+	friend struct TIntrusive;
+
+	// Takes a reference to ptr before letting go of the current object, so assigning an object to itself is safe
+	_CONSTEXPR23 void reset(TType* ptr) noexcept {
+		if (ptr) {
+			ptr->addRef();
+		}
+		if (m_ptr && m_ptr->removeRef()) {
+			sstl::deleter<TType>()(m_ptr);
+		}
+		m_ptr = ptr;
+	}
+
+	TType* m_ptr = nullptr;
+};
+
+// Template argument deduction for input of a single type
+template <typename TType>
+TIntrusive(TType*) -> TIntrusive<TType>;
+
 template <typename TType>
 struct TUnfurled {
 	using Type = TType;
@@ -1136,6 +1488,25 @@ struct TUnfurled<TUnique<TType>> {
 	}
 };
 
+template <typename TType>
+struct TUnfurled<TIntrusive<TType>> {
+	using Type = TType;
+	constexpr static bool isManaged = true;
+	constexpr static auto get = &TIntrusive<TType>::get;
+
+	template <typename TOtherType = TType, typename... TArgs,
+		std::enable_if_t<std::is_convertible_v<TOtherType*, TType*>, int> = 0
+	>
+	_CONSTEXPR23 static TIntrusive<TType> create(TArgs&&... args)
+#if CXX_VERSION >= 20
+	noexcept(std::is_nothrow_convertible_v<TOtherType*, TType*>) {
+#else
+	noexcept {
+#endif
+		return TIntrusive<TOtherType>(std::forward<TArgs>(args)...);
+	}
+};
+
 template <typename TType>
 struct TUnfurled<TWeak<TType>> {
 	using Type = TType;
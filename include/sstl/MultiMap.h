@@ -1,16 +1,22 @@
 ﻿#pragma once
 
 #include <unordered_map>
+#include <tuple>
 #include "Container.h"
 #include "InitializerList.h"
 
-template <typename TKeyType, typename TValueType,
+template <typename TKeyType, typename TValueType, typename TAllocator = std::allocator<std::pair<const TKeyType, TValueType>>,
 	std::enable_if_t<sstl::is_hashable_v<TKeyType>, int> = 0
 >
 struct TMultiMap : TAssociativeContainer<TKeyType, TValueType> {
 
+	using iterator = typename std::unordered_multimap<TKeyType, TValueType, sstl::hasher<TKeyType>, std::equal_to<TKeyType>, TAllocator>::iterator;
+	using const_iterator = typename std::unordered_multimap<TKeyType, TValueType, sstl::hasher<TKeyType>, std::equal_to<TKeyType>, TAllocator>::const_iterator;
+
 	TMultiMap() = default;
 
+	explicit TMultiMap(const TAllocator& allocator): m_Container(allocator) {}
+
 	template <typename TOtherValueType = TValueType,
 		std::enable_if_t<std::is_copy_constructible_v<TOtherValueType>, int> = 0
 	>
@@ -21,7 +27,10 @@ struct TMultiMap : TAssociativeContainer<TKeyType, TValueType> {
 		}
 	}
 
-	template <typename... TPairs>
+	// An allocator on its own goes to the allocator constructor instead
+	template <typename... TPairs,
+		std::enable_if_t<!std::disjunction_v<std::is_convertible<TPairs, TAllocator>...>, int> = 0
+	>
 	explicit TMultiMap(TPairs&&... args) {
 		m_Container.reserve(sizeof...(TPairs));
 		(m_Container.emplace(std::forward<typename TPairs::KeyType>(args.key()), std::forward<typename TPairs::ValueType>(args.value())), ...);
@@ -31,6 +40,10 @@ struct TMultiMap : TAssociativeContainer<TKeyType, TValueType> {
 		return m_Container.size();
 	}
 
+	[[nodiscard]] TAllocator getAllocator() const {
+		return m_Container.get_allocator();
+	}
+
 	virtual TPair<TKeyType, const TValueType&> top() const override {
 		return TPair<TKeyType, const TValueType&>{*m_Container.begin()};
 	}
@@ -76,8 +89,7 @@ struct TMultiMap : TAssociativeContainer<TKeyType, TValueType> {
 
 	virtual TValueType& push(const TKeyType& key) override {
 		if constexpr (std::is_default_constructible_v<TValueType>) {
-			push(TPair<TKeyType, TValueType>{key, {}});
-			return get(key);
+			return m_Container.emplace(std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple())->second;
 		} else {
 			throw std::runtime_error("Type is not default constructible!");
 		}
@@ -85,8 +97,7 @@ struct TMultiMap : TAssociativeContainer<TKeyType, TValueType> {
 
 	virtual TValueType& push(const TKeyType& key, const TValueType& value) override {
 		if constexpr (std::is_copy_constructible_v<TValueType>) {
-			push(TPair<TKeyType, TValueType>{key, value});
-			return get(key);
+			return m_Container.emplace(key, value)->second;
 		} else {
 			throw std::runtime_error("Type is not copyable!");
 		}
@@ -94,8 +105,7 @@ struct TMultiMap : TAssociativeContainer<TKeyType, TValueType> {
 
 	virtual TValueType& push(const TKeyType& key, TValueType&& value) override {
 		if constexpr (std::is_move_constructible_v<TValueType>) {
-			push(TPair<TKeyType, TValueType>{key, std::move(value)});
-			return get(key);
+			return m_Container.emplace(key, std::move(value))->second;
 		} else {
 			throw std::runtime_error("Type is not moveable!");
 		}
@@ -117,10 +127,16 @@ struct TMultiMap : TAssociativeContainer<TKeyType, TValueType> {
 		}
 	}
 
+	// Constructs the value in place from args, no temporary pair or value is made
+	template <typename... TArgs>
+	TValueType& emplace(const TKeyType& key, TArgs&&... args) {
+		return m_Container.emplace(std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple(std::forward<TArgs>(args)...))->second;
+	}
+
 	virtual void replace(const TKeyType& key, const TValueType& obj) override {
 		if constexpr (std::is_copy_constructible_v<TValueType>) {
 			pop(key);
-			push(TPair<TKeyType, TValueType>{key, obj});
+			m_Container.emplace(key, obj);
 		} else {
 			throw std::runtime_error("Type is not copyable!");
 		}
@@ -129,7 +145,7 @@ struct TMultiMap : TAssociativeContainer<TKeyType, TValueType> {
 	virtual void replace(const TKeyType& key, TValueType&& obj) override {
 		if constexpr (std::is_move_constructible_v<TValueType>) {
 			pop(key);
-			push(TPair<TKeyType, TValueType>{key, std::move(obj)});
+			m_Container.emplace(key, std::move(obj));
 		} else {
 			throw std::runtime_error("Type is not moveable!");
 		}
@@ -163,15 +179,31 @@ struct TMultiMap : TAssociativeContainer<TKeyType, TValueType> {
 		}
 	}
 
+	// Iterates through each element, accepts any callable so the loop can be inlined
+	template <typename TFunc>
+	void forEach(TFunc&& func) const {
+		for (auto itr = m_Container.begin(); itr != m_Container.end(); ++itr) {
+			func(TPair<TKeyType, const TValueType&>{itr->first, itr->second});
+		}
+	}
+
+	iterator begin() { return m_Container.begin(); }
+
+	const_iterator begin() const { return m_Container.begin(); }
+
+	iterator end() { return m_Container.end(); }
+
+	const_iterator end() const { return m_Container.end(); }
+
+	const_iterator cbegin() const { return m_Container.cbegin(); }
+
+	const_iterator cend() const { return m_Container.cend(); }
+
 protected:
 
-	struct Hasher {
-		size_t operator()(const TKeyType& p) const noexcept {
-			return getHash(p);
-		}
-	};
+	using Hasher = sstl::hasher<TKeyType>;
 
-	std::unordered_multimap<TKeyType, TValueType, Hasher> m_Container;
+	std::unordered_multimap<TKeyType, TValueType, Hasher, std::equal_to<TKeyType>, TAllocator> m_Container;
 };
 
 template <typename TKeyType, typename TValueType>
@@ -4,13 +4,19 @@
 #include "Container.h"
 #include "InitializerList.h"
 
-template <typename TType,
+template <typename TType, typename TAllocator = std::allocator<TType>,
 	std::enable_if_t<sstl::is_hashable_v<TType>, int> = 0
 >
 struct TMultiSet : TSingleAssociativeContainer<TType> {
 
+	// Elements are keys, so they cannot be modified in place
+	using iterator = typename std::unordered_multiset<TType, sstl::hasher<TType>, std::equal_to<TType>, TAllocator>::const_iterator;
+	using const_iterator = typename std::unordered_multiset<TType, sstl::hasher<TType>, std::equal_to<TType>, TAllocator>::const_iterator;
+
 	TMultiSet() = default;
 
+	explicit TMultiSet(const TAllocator& allocator): m_Container(allocator) {}
+
 	template <typename TOtherType = TType,
 		std::enable_if_t<std::is_copy_constructible_v<TOtherType>, int> = 0
 	>
@@ -28,6 +34,10 @@ struct TMultiSet : TSingleAssociativeContainer<TType> {
 		return m_Container.size();
 	}
 
+	[[nodiscard]] TAllocator getAllocator() const {
+		return m_Container.get_allocator();
+	}
+
 	virtual const TType& top() const override {
 		return *m_Container.begin();
 	}
@@ -95,6 +105,12 @@ struct TMultiSet : TSingleAssociativeContainer<TType> {
 		}
 	}
 
+	// Constructs an element in place from args, no temporary TType is made
+	template <typename... TArgs>
+	const TType& emplace(TArgs&&... args) {
+		return *m_Container.emplace(std::forward<TArgs>(args)...);
+	}
+
 	virtual void replace(const TType& tgt, const TType& obj) override {
 		if constexpr (std::is_copy_constructible_v<TType>) {
 			// Since this container is unordered, replacing doesn't need to set at the same index
@@ -166,15 +182,31 @@ struct TMultiSet : TSingleAssociativeContainer<TType> {
 		}
 	}
 
+	// Iterates through each element, accepts any callable so the loop can be inlined
+	template <typename TFunc>
+	void forEach(TFunc&& func) const {
+		for (auto itr = m_Container.begin(); itr != m_Container.end(); ++itr) {
+			func(*itr);
+		}
+	}
+
+	iterator begin() { return m_Container.begin(); }
+
+	const_iterator begin() const { return m_Container.begin(); }
+
+	iterator end() { return m_Container.end(); }
+
+	const_iterator end() const { return m_Container.end(); }
+
+	const_iterator cbegin() const { return m_Container.cbegin(); }
+
+	const_iterator cend() const { return m_Container.cend(); }
+
 protected:
 
-	struct Hasher {
-		size_t operator()(const TType& p) const noexcept {
-			return getHash(p);
-		}
-	};
+	using Hasher = sstl::hasher<TType>;
 
-	std::unordered_multiset<TType, Hasher> m_Container;
+	std::unordered_multiset<TType, Hasher, std::equal_to<TType>, TAllocator> m_Container;
 };
 
 template <typename TType, typename... TArgs>
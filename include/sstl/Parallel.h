@@ -0,0 +1,83 @@
+﻿#pragma once
+
+#include <iterator>
+#include <type_traits>
+
+#include "ThreadPool.h"
+
+namespace sstl {
+
+	// If the container can reach any index in constant time, like TVector, TDeque and TArray
+	template <typename TContainer, typename = void>
+	struct is_random_access_container : std::false_type {};
+
+	template <typename TContainer>
+	struct is_random_access_container
+	<TContainer,
+		std::void_t<typename std::remove_const_t<TContainer>::iterator>
+	> : std::is_base_of<std::random_access_iterator_tag, typename std::iterator_traits<typename std::remove_const_t<TContainer>::iterator>::iterator_category> {};
+
+	template <typename TContainer>
+	constexpr bool is_random_access_container_v = is_random_access_container<TContainer>::value;
+
+	// Picks a grain that gives each worker about four chunks, so a slow chunk can be balanced out by stealing
+	inline size_t defaultGrain(const size_t amt, const TThreadPool& pool) {
+		const size_t chunks = pool.getThreadCount() * 4;
+		return std::max<size_t>(1, (amt + chunks - 1) / chunks);
+	}
+
+	// Calls func(chunkStart, chunkEnd) for every chunk of [start, end) across the pool, and waits for all of them
+	// Chunk k always covers [start + k * grain, start + (k + 1) * grain), so the same grain always splits a range the same way
+	// A grain of 0 picks one from the pool size, the calling thread runs chunks too, and the first exception thrown is rethrown here
+	template <typename TFunc>
+	void parallelChunks(const size_t start, const size_t end, TFunc&& func, size_t grain = 0, TThreadPool& pool = TThreadPool::get()) {
+		if (start >= end) return;
+		if (grain == 0) grain = defaultGrain(end - start, pool);
+		if (end - start <= grain) {
+			func(start, end);
+			return;
+		}
+		TThreadPool::group group;
+		for (size_t chunk = start + grain; chunk < end; chunk += std::min(grain, end - chunk)) {
+			pool.submit([&func, chunk, chunkEnd = chunk + std::min(grain, end - chunk)] { func(chunk, chunkEnd); }, group);
+		}
+		// The first chunk runs here instead of waiting idle, any exception is held until the rest are done
+		try {
+			func(start, start + grain);
+		} catch (...) {
+			pool.wait(group);
+			throw;
+		}
+		pool.wait(group);
+	}
+
+	// Calls func(index) for every index in [start, end) across the pool
+	template <typename TFunc>
+	void parallelFor(const size_t start, const size_t end, TFunc&& func, const size_t grain = 0, TThreadPool& pool = TThreadPool::get()) {
+		parallelChunks(start, end, [&](const size_t chunkStart, const size_t chunkEnd) {
+			for (size_t i = chunkStart; i < chunkEnd; ++i) {
+				func(i);
+			}
+		}, grain, pool);
+	}
+
+	// Calls func(index, element) for every element in [start, end) of container across the pool, like doFor
+	// Each chunk goes through the container's own templated doFor, so the inner loop can be inlined
+	template <typename TContainer, typename TFunc,
+		std::enable_if_t<is_random_access_container_v<TContainer>, int> = 0
+	>
+	void parallelDoFor(TContainer& container, const size_t start, const size_t end, TFunc&& func, const size_t grain = 0, TThreadPool& pool = TThreadPool::get()) {
+		parallelChunks(start, end, [&](const size_t chunkStart, const size_t chunkEnd) {
+			container.doFor(chunkStart, chunkEnd, func);
+		}, grain, pool);
+	}
+
+	// Calls func(index, element) for every element of container across the pool, like forEach
+	// Elements are visited in no particular order, func must be safe to call from many threads at once
+	template <typename TContainer, typename TFunc,
+		std::enable_if_t<is_random_access_container_v<TContainer>, int> = 0
+	>
+	void parallelForEach(TContainer& container, TFunc&& func, const size_t grain = 0, TThreadPool& pool = TThreadPool::get()) {
+		parallelDoFor(container, 0, container.getSize(), std::forward<TFunc>(func), grain, pool);
+	}
+}
@@ -0,0 +1,124 @@
+﻿#pragma once
+
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+#include "Parallel.h"
+#include "Sort.h"
+
+namespace sstl {
+
+	// Below this many elements a sort stays on the calling thread, handing out the work costs more than it saves
+	constexpr size_t parallelSortThreshold = 1 << 16;
+
+	// Finds how many of the first amt merged elements of the runs [start, mid) and [mid, end) come from the left run, taking left on ties
+	template <typename TSource, typename TCompare>
+	size_t mergeSplit(TSource src, const size_t start, const size_t mid, const size_t end, const size_t amt, TCompare& comp) {
+		size_t low = amt > end - mid ? amt - (end - mid) : 0;
+		size_t high = std::min(amt, mid - start);
+		while (low < high) {
+			const size_t fromLeft = low + (high - low) / 2;
+			if (!comp(src[mid + (amt - fromLeft) - 1], src[start + fromLeft])) {
+				low = fromLeft + 1;
+			} else {
+				high = fromLeft;
+			}
+		}
+		return low;
+	}
+
+	// Merges every pair of neighbouring runs of width in src into dst
+	// The output is split into equal chunks and each one finds where its inputs start with mergeSplit, so one large merge still uses every worker
+	template <typename TSource, typename TDest, typename TCompare>
+	void mergeRuns(TSource src, TDest dst, const size_t size, const size_t width, TCompare& comp, TThreadPool& pool) {
+		const size_t grain = defaultGrain(size, pool);
+		const size_t chunks = (size + grain - 1) / grain;
+
+		// Every split is found before anything is moved, since a moved from element can no longer be compared
+		std::vector<size_t> splits(chunks + 1, 0);
+		parallelFor(1, chunks, [&](const size_t chunk) {
+			const size_t outStart = chunk * grain;
+			const size_t pairStart = outStart / (width * 2) * (width * 2);
+			splits[chunk] = mergeSplit(src, pairStart, std::min(pairStart + width, size), std::min(pairStart + width * 2, size), outStart - pairStart, comp);
+		}, 0, pool);
+
+		parallelChunks(0, size, [&](const size_t start, const size_t end) {
+			for (size_t outStart = start; outStart < end;) {
+				const size_t pairStart = outStart / (width * 2) * (width * 2);
+				const size_t mid = std::min(pairStart + width, size);
+				const size_t pairEnd = std::min(pairStart + width * 2, size);
+				const size_t outEnd = std::min(end, pairEnd);
+				// Only the chunk's own ends can fall inside a pair, every other pair is merged whole
+				const size_t left = outStart == start ? splits[start / grain] : 0;
+				const size_t leftEnd = outEnd == pairEnd ? mid - pairStart : splits[start / grain + 1];
+				const size_t right = mid + (outStart - pairStart) - left;
+				const size_t rightEnd = mid + (outEnd - pairStart) - leftEnd;
+				std::merge(
+					std::make_move_iterator(src + (pairStart + left)), std::make_move_iterator(src + (pairStart + leftEnd)),
+					std::make_move_iterator(src + right), std::make_move_iterator(src + rightEnd),
+					dst + outStart, comp
+				);
+				outStart = outEnd;
+			}
+		}, grain, pool);
+	}
+
+	// Sorts one chunk per worker, then merges neighbouring runs until one is left, moving between the range and a buffer each round
+	// Merging takes from the left run on ties, so this is stable when TStable sorts the chunks stably
+	template <bool TStable, typename TIterator, typename TCompare>
+	void mergeSort(TIterator first, TIterator last, TCompare& comp, TThreadPool& pool) {
+		using TType = typename std::iterator_traits<TIterator>::value_type;
+
+		const size_t size = static_cast<size_t>(std::distance(first, last));
+		const size_t grain = (size + pool.getThreadCount() - 1) / pool.getThreadCount();
+		parallelChunks(0, size, [&](const size_t start, const size_t end) {
+			if constexpr (TStable) {
+				std::stable_sort(first + start, first + end, comp);
+			} else {
+				std::sort(first + start, first + end, comp);
+			}
+		}, grain, pool);
+
+		const std::unique_ptr<TType[]> buffer(new TType[size]);
+		bool inBuffer = false;
+		for (size_t width = grain; width < size; width *= 2) {
+			if (inBuffer) {
+				mergeRuns(buffer.get(), first, size, width, comp, pool);
+			} else {
+				mergeRuns(first, buffer.get(), size, width, comp, pool);
+			}
+			inBuffer = !inBuffer;
+		}
+		if (inBuffer) {
+			parallelChunks(0, size, [&](const size_t start, const size_t end) {
+				std::move(buffer.get() + start, buffer.get() + end, first + start);
+			}, defaultGrain(size, pool), pool);
+		}
+	}
+
+	// Picks between a parallel radix sort, a parallel merge sort and sorting on the calling thread by type and size
+	// Types that cannot be default constructed have no buffer to merge into, so they always sort on the calling thread
+	template <bool TStable, typename TIterator>
+	struct parallel_sort {
+
+		template <typename TCompare>
+		static void run(TIterator first, TIterator last, TCompare& comp, TThreadPool& pool) {
+			using TType = typename std::iterator_traits<TIterator>::value_type;
+
+			const size_t size = static_cast<size_t>(std::distance(first, last));
+			if (size >= parallelSortThreshold && pool.getThreadCount() > 1) {
+				if constexpr (is_radix_sortable_v<TType, TCompare> && (!TStable || std::is_integral_v<TType>)) {
+					const size_t grain = defaultGrain(size, pool);
+					radixSort(first, last, grain, [&](auto&& func) { parallelChunks(0, size, func, grain, pool); });
+					return;
+				} else if constexpr (std::is_default_constructible_v<TType>) {
+					mergeSort<TStable>(first, last, comp, pool);
+					return;
+				}
+			}
+			sortRange<TStable>(first, last, comp);
+		}
+	};
+}
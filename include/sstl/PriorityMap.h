@@ -1,16 +1,24 @@
 ﻿#pragma once
 
 #include <map>
+#include <tuple>
 #include "Container.h"
 #include "InitializerList.h"
 
-template <typename TKeyType, typename TValueType,
+template <typename TKeyType, typename TValueType, typename TAllocator = std::allocator<std::pair<const TKeyType, TValueType>>,
 	std::enable_if_t<sstl::is_less_than_comparable_v<TKeyType>, int> = 0
 >
 struct TPriorityMap : TAssociativeContainer<TKeyType, TValueType> {
 
+	using iterator = typename std::map<TKeyType, TValueType, std::less<TKeyType>, TAllocator>::iterator;
+	using const_iterator = typename std::map<TKeyType, TValueType, std::less<TKeyType>, TAllocator>::const_iterator;
+	using reverse_iterator = typename std::map<TKeyType, TValueType, std::less<TKeyType>, TAllocator>::reverse_iterator;
+	using const_reverse_iterator = typename std::map<TKeyType, TValueType, std::less<TKeyType>, TAllocator>::const_reverse_iterator;
+
 	TPriorityMap() = default;
 
+	explicit TPriorityMap(const TAllocator& allocator): m_Container(allocator) {}
+
 	template <typename TOtherValueType = TValueType,
 		std::enable_if_t<std::is_copy_constructible_v<TOtherValueType>, int> = 0
 	>
@@ -20,7 +28,10 @@ struct TPriorityMap : TAssociativeContainer<TKeyType, TValueType> {
 		}
 	}
 
-	template <typename... TPairs>
+	// An allocator on its own goes to the allocator constructor instead
+	template <typename... TPairs,
+		std::enable_if_t<!std::disjunction_v<std::is_convertible<TPairs, TAllocator>...>, int> = 0
+	>
 	explicit TPriorityMap(TPairs&&... args) {
 		(m_Container.emplace(std::forward<typename TPairs::KeyType>(args.key()), std::forward<typename TPairs::ValueType>(args.value())), ...);
 	}
@@ -29,6 +40,10 @@ struct TPriorityMap : TAssociativeContainer<TKeyType, TValueType> {
 		return m_Container.size();
 	}
 
+	[[nodiscard]] TAllocator getAllocator() const {
+		return m_Container.get_allocator();
+	}
+
 	virtual TPair<TKeyType, const TValueType&> top() const override {
 		return TPair<TKeyType, const TValueType&>{*m_Container.begin()};
 	}
@@ -69,8 +84,7 @@ struct TPriorityMap : TAssociativeContainer<TKeyType, TValueType> {
 
 	virtual TValueType& push(const TKeyType& key) override {
 		if constexpr (std::is_default_constructible_v<TValueType>) {
-			push(TPair<TKeyType, TValueType>{key, {}});
-			return get(key);
+			return m_Container.emplace(std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple()).first->second;
 		} else {
 			throw std::runtime_error("Type is not default constructible!");
 		}
@@ -78,8 +92,7 @@ struct TPriorityMap : TAssociativeContainer<TKeyType, TValueType> {
 
 	virtual TValueType& push(const TKeyType& key, const TValueType& value) override {
 		if constexpr (std::is_copy_constructible_v<TValueType>) {
-			push(TPair<TKeyType, TValueType>{key, value});
-			return get(key);
+			return m_Container.emplace(key, value).first->second;
 		} else {
 			throw std::runtime_error("Type is not copyable!");
 		}
@@ -87,8 +100,7 @@ struct TPriorityMap : TAssociativeContainer<TKeyType, TValueType> {
 
 	virtual TValueType& push(const TKeyType& key, TValueType&& value) override {
 		if constexpr (std::is_move_constructible_v<TValueType>) {
-			push(TPair<TKeyType, TValueType>{key, std::move(value)});
-			return get(key);
+			return m_Container.emplace(key, std::move(value)).first->second;
 		} else {
 			throw std::runtime_error("Type is not moveable!");
 		}
@@ -110,10 +122,22 @@ struct TPriorityMap : TAssociativeContainer<TKeyType, TValueType> {
 		}
 	}
 
+	// Constructs the value in place from args, no temporary pair or value is made
+	template <typename... TArgs>
+	TValueType& emplace(const TKeyType& key, TArgs&&... args) {
+		return m_Container.emplace(std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple(std::forward<TArgs>(args)...)).first->second;
+	}
+
+	// Constructs the value in place only if key is not already present, args are left untouched otherwise
+	template <typename... TArgs>
+	TValueType& tryEmplace(const TKeyType& key, TArgs&&... args) {
+		return m_Container.try_emplace(key, std::forward<TArgs>(args)...).first->second;
+	}
+
 	virtual void replace(const TKeyType& key, const TValueType& obj) override {
 		if constexpr (std::is_copy_constructible_v<TValueType>) {
 			pop(key);
-			push(TPair<TKeyType, TValueType>{key, obj});
+			m_Container.emplace(key, obj);
 		} else {
 			throw std::runtime_error("Type is not copyable!");
 		}
@@ -122,7 +146,7 @@ struct TPriorityMap : TAssociativeContainer<TKeyType, TValueType> {
 	virtual void replace(const TKeyType& key, TValueType&& obj) override {
 		if constexpr (std::is_move_constructible_v<TValueType>) {
 			pop(key);
-			push(TPair<TKeyType, TValueType>{key, std::move(obj)});
+			m_Container.emplace(key, std::move(obj));
 		} else {
 			throw std::runtime_error("Type is not moveable!");
 		}
@@ -156,9 +180,67 @@ struct TPriorityMap : TAssociativeContainer<TKeyType, TValueType> {
 		}
 	}
 
+	// Iterates through each element, accepts any callable so the loop can be inlined
+	template <typename TFunc>
+	void forEach(TFunc&& func) const {
+		for (auto itr = m_Container.begin(); itr != m_Container.end(); ++itr) {
+			func(TPair<TKeyType, const TValueType&>{itr->first, itr->second});
+		}
+	}
+
+	// Gets an iterator to the first pair whose key is not less than key
+	iterator lowerBound(const TKeyType& key) {
+		return m_Container.lower_bound(key);
+	}
+
+	const_iterator lowerBound(const TKeyType& key) const {
+		return m_Container.lower_bound(key);
+	}
+
+	// Gets an iterator to the first pair whose key is greater than key
+	iterator upperBound(const TKeyType& key) {
+		return m_Container.upper_bound(key);
+	}
+
+	const_iterator upperBound(const TKeyType& key) const {
+		return m_Container.upper_bound(key);
+	}
+
+	// Iterates in order through each pair with a key from min up to but not including max
+	template <typename TFunc>
+	void forEachInRange(const TKeyType& min, const TKeyType& max, TFunc&& func) const {
+		for (auto itr = m_Container.lower_bound(min); itr != m_Container.end() && itr->first < max; ++itr) {
+			func(TPair<TKeyType, const TValueType&>{itr->first, itr->second});
+		}
+	}
+
+	iterator begin() { return m_Container.begin(); }
+
+	const_iterator begin() const { return m_Container.begin(); }
+
+	iterator end() { return m_Container.end(); }
+
+	const_iterator end() const { return m_Container.end(); }
+
+	const_iterator cbegin() const { return m_Container.cbegin(); }
+
+	const_iterator cend() const { return m_Container.cend(); }
+
+	reverse_iterator rbegin() { return m_Container.rbegin(); }
+
+	const_reverse_iterator rbegin() const { return m_Container.rbegin(); }
+
+	reverse_iterator rend() { return m_Container.rend(); }
+
+	const_reverse_iterator rend() const { return m_Container.rend(); }
+
+	const_reverse_iterator crbegin() const { return m_Container.crbegin(); }
+
+	const_reverse_iterator crend() const { return m_Container.crend(); }
+
 protected:
 
-	std::map<TKeyType, TValueType> m_Container;
+	std::map<TKeyType, TValueType, std::less<TKeyType>, TAllocator> m_Container;
 };
 
 template <typename TKeyType, typename TValueType>
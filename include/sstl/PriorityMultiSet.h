@@ -4,13 +4,21 @@
 #include "Container.h"
 #include "InitializerList.h"
 
-template <typename TType,
+template <typename TType, typename TAllocator = std::allocator<TType>,
 	std::enable_if_t<sstl::is_less_than_comparable_v<TType>, int> = 0
 >
 struct TPriorityMultiSet : TSingleAssociativeContainer<TType> {
 
+	// Elements are keys, so they cannot be modified in place
+	using iterator = typename std::multiset<TType, std::less<TType>, TAllocator>::const_iterator;
+	using const_iterator = typename std::multiset<TType, std::less<TType>, TAllocator>::const_iterator;
+	using reverse_iterator = typename std::multiset<TType, std::less<TType>, TAllocator>::const_reverse_iterator;
+	using const_reverse_iterator = typename std::multiset<TType, std::less<TType>, TAllocator>::const_reverse_iterator;
+
 	TPriorityMultiSet() = default;
 
+	explicit TPriorityMultiSet(const TAllocator& allocator): m_Container(allocator) {}
+
 	template <typename TOtherType = TType,
 		std::enable_if_t<std::is_copy_constructible_v<TOtherType>, int> = 0
 	>
@@ -27,6 +35,10 @@ struct TPriorityMultiSet : TSingleAssociativeContainer<TType> {
 		return m_Container.size();
 	}
 
+	[[nodiscard]] TAllocator getAllocator() const {
+		return m_Container.get_allocator();
+	}
+
 	virtual const TType& top() const override {
 		return *m_Container.begin();
 	}
@@ -90,6 +102,12 @@ struct TPriorityMultiSet : TSingleAssociativeContainer<TType> {
 		}
 	}
 
+	// Constructs an element in place from args, no temporary TType is made
+	template <typename... TArgs>
+	const TType& emplace(TArgs&&... args) {
+		return *m_Container.emplace(std::forward<TArgs>(args)...);
+	}
+
 	virtual void replace(const TType& tgt, const TType& obj) override {
 		if constexpr (std::is_copy_constructible_v<TType>) {
 			// Since this container is unordered, replacing doesn't need to set at the same index
@@ -161,9 +179,59 @@ struct TPriorityMultiSet : TSingleAssociativeContainer<TType> {
 		}
 	}
 
+	// Iterates through each element, accepts any callable so the loop can be inlined
+	template <typename TFunc>
+	void forEach(TFunc&& func) const {
+		for (auto itr = m_Container.begin(); itr != m_Container.end(); ++itr) {
+			func(*itr);
+		}
+	}
+
+	// Gets an iterator to the first element that is not less than obj
+	const_iterator lowerBound(const TType& obj) const {
+		return m_Container.lower_bound(obj);
+	}
+
+	// Gets an iterator to the first element that is greater than obj
+	const_iterator upperBound(const TType& obj) const {
+		return m_Container.upper_bound(obj);
+	}
+
+	// Iterates in order through each element from min up to but not including max
+	template <typename TFunc>
+	void forEachInRange(const TType& min, const TType& max, TFunc&& func) const {
+		for (auto itr = m_Container.lower_bound(min); itr != m_Container.end() && *itr < max; ++itr) {
+			func(*itr);
+		}
+	}
+
+	iterator begin() { return m_Container.begin(); }
+
+	const_iterator begin() const { return m_Container.begin(); }
+
+	iterator end() { return m_Container.end(); }
+
+	const_iterator end() const { return m_Container.end(); }
+
+	const_iterator cbegin() const { return m_Container.cbegin(); }
+
+	const_iterator cend() const { return m_Container.cend(); }
+
+	reverse_iterator rbegin() { return m_Container.rbegin(); }
+
+	const_reverse_iterator rbegin() const { return m_Container.rbegin(); }
+
+	reverse_iterator rend() { return m_Container.rend(); }
+
+	const_reverse_iterator rend() const { return m_Container.rend(); }
+
+	const_reverse_iterator crbegin() const { return m_Container.crbegin(); }
+
+	const_reverse_iterator crend() const { return m_Container.crend(); }
+
 protected:
 
-	std::multiset<TType> m_Container;
+	std::multiset<TType, std::less<TType>, TAllocator> m_Container;
 };
 
 template <typename TType, typename... TArgs>
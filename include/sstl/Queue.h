@@ -3,33 +3,35 @@
 #include "Deque.h"
 
 // std::queue is already a wrapper around a deque, so we do that here too, and skip std::queue's own abstraction
-template <typename TType>
-struct TQueue : TDeque<TType> {
+template <typename TType, typename TAllocator = std::allocator<TType>>
+struct TQueue : TDeque<TType, TAllocator> {
 
 	TQueue() = default;
 
+	explicit TQueue(const TAllocator& allocator): TDeque<TType, TAllocator>(allocator) {}
+
 	template <typename TOtherType = TType,
 		std::enable_if_t<std::is_copy_constructible_v<TOtherType>, int> = 0
 	>
-	TQueue(TInitializerList<TType> init): TDeque<TType>(init) {}
+	TQueue(TInitializerList<TType> init): TDeque<TType, TAllocator>(init) {}
 
 	template <typename... TArgs,
 		std::enable_if_t<std::conjunction_v<std::is_constructible<TType, TArgs>...>, int> = 0
 	>
-	explicit TQueue(TArgs&&... args): TDeque<TType>(std::forward<TArgs>(args)...) {}
+	explicit TQueue(TArgs&&... args): TDeque<TType, TAllocator>(std::forward<TArgs>(args)...) {}
 
 	virtual TType& top() override {
-		return TDeque<TType>::m_Container.back();
+		return TDeque<TType, TAllocator>::m_Container.back();
 	}
 
 	virtual const TType& top() const override {
-		return TDeque<TType>::m_Container.back();
+		return TDeque<TType, TAllocator>::m_Container.back();
 	}
 
 	virtual size_t push(const TType& obj) override {
 		if constexpr (std::is_copy_constructible_v<TType>) {
-			TDeque<TType>::m_Container.emplace_back(obj);
-			return TDeque<TType>::getSize() - 1;
+			TDeque<TType, TAllocator>::m_Container.emplace_back(obj);
+			return TDeque<TType, TAllocator>::getSize() - 1;
 		} else {
 			throw std::runtime_error("Type is not copyable");
 		}
@@ -37,8 +39,8 @@ struct TQueue : TDeque<TType> {
 
 	virtual size_t push(TType&& obj) override {
 		if constexpr (std::is_move_constructible_v<TType>) {
-			TDeque<TType>::m_Container.emplace_back(std::move(obj));
-			return TDeque<TType>::getSize() - 1;
+			TDeque<TType, TAllocator>::m_Container.emplace_back(std::move(obj));
+			return TDeque<TType, TAllocator>::getSize() - 1;
 		} else {
 			throw std::runtime_error("Type is not moveable");
 		}
@@ -46,8 +48,8 @@ struct TQueue : TDeque<TType> {
 
 	virtual void replace(const size_t index, const TType& obj) override {
 		if constexpr (std::is_copy_constructible_v<TType>) {
-			TDeque<TType>::pop(index);
-			TDeque<TType>::push(index, obj);
+			TDeque<TType, TAllocator>::pop(index);
+			TDeque<TType, TAllocator>::push(index, obj);
 		} else {
 			throw std::runtime_error("Type is not copyable");
 		}
@@ -55,41 +57,45 @@ struct TQueue : TDeque<TType> {
 
 	virtual void replace(const size_t index, TType&& obj) override {
 		if constexpr (std::is_move_constructible_v<TType>) {
-			TDeque<TType>::pop(index);
-			TDeque<TType>::push(index, std::move(obj));
+			TDeque<TType, TAllocator>::pop(index);
+			TDeque<TType, TAllocator>::push(index, std::move(obj));
 		} else {
 			throw std::runtime_error("Type is not moveable");
 		}
 	}
 
 	virtual void pop() override {
-		TDeque<TType>::pop(TDeque<TType>::getSize() - 1);
+		TDeque<TType, TAllocator>::popBack();
 	}
 
+	// Keep the templated iteration from TDeque visible alongside the overrides
+	using TDeque<TType, TAllocator>::forEach;
+	using TDeque<TType, TAllocator>::forEachReverse;
+
 	virtual void forEach(const std::function<void(size_t, TType&)>& func) override {
 		size_t i = 0;
-		for (auto itr = TDeque<TType>::m_Container.begin(); itr != TDeque<TType>::m_Container.end(); ++itr, ++i) {
+		for (auto itr = TDeque<TType, TAllocator>::m_Container.begin(); itr != TDeque<TType, TAllocator>::m_Container.end(); ++itr, ++i) {
 			func(i, *itr);
 		}
 	}
 
 	virtual void forEach(const std::function<void(size_t, const TType&)>& func) const override {
 		size_t i = 0;
-		for (auto itr = TDeque<TType>::m_Container.begin(); itr != TDeque<TType>::m_Container.end(); ++itr, ++i) {
+		for (auto itr = TDeque<TType, TAllocator>::m_Container.begin(); itr != TDeque<TType, TAllocator>::m_Container.end(); ++itr, ++i) {
 			func(i, *itr);
 		}
 	}
 
 	virtual void forEachReverse(const std::function<void(size_t, TType&)>& func) override {
-		size_t i = TDeque<TType>::getSize() - 1;
-		for (auto itr = TDeque<TType>::m_Container.rbegin(); itr != TDeque<TType>::m_Container.rend(); ++itr, --i) {
+		size_t i = TDeque<TType, TAllocator>::getSize() - 1;
+		for (auto itr = TDeque<TType, TAllocator>::m_Container.rbegin(); itr != TDeque<TType, TAllocator>::m_Container.rend(); ++itr, --i) {
 			func(i, *itr);
 		}
 	}
 
 	virtual void forEachReverse(const std::function<void(size_t, const TType&)>& func) const override {
-		size_t i = TDeque<TType>::getSize() - 1;
-		for (auto itr = TDeque<TType>::m_Container.rbegin(); itr != TDeque<TType>::m_Container.rend(); ++itr, --i) {
+		size_t i = TDeque<TType, TAllocator>::getSize() - 1;
+		for (auto itr = TDeque<TType, TAllocator>::m_Container.rbegin(); itr != TDeque<TType, TAllocator>::m_Container.rend(); ++itr, --i) {
 			func(i, *itr);
 		}
 	}
@@ -97,31 +103,31 @@ struct TQueue : TDeque<TType> {
 protected:
 
 	virtual TType& bottom() override {
-		return TDeque<TType>::bottom();
+		return TDeque<TType, TAllocator>::bottom();
 	}
 
 	virtual const TType& bottom() const override {
-		return TDeque<TType>::bottom();
+		return TDeque<TType, TAllocator>::bottom();
 	}
 
 	virtual TType& get(size_t index) override {
-		return TDeque<TType>::get(index);
+		return TDeque<TType, TAllocator>::get(index);
 	}
 
 	virtual const TType& get(size_t index) const override {
-		return TDeque<TType>::get(index);
+		return TDeque<TType, TAllocator>::get(index);
 	}
 
 	virtual void push(const size_t index, const TType& obj) override {
-		TDeque<TType>::push(index, obj);
+		TDeque<TType, TAllocator>::push(index, obj);
 	}
 
 	virtual void push(const size_t index, TType&& obj) override {
-		TDeque<TType>::push(index, std::move(obj));
+		TDeque<TType, TAllocator>::push(index, std::move(obj));
 	}
 
 	virtual void pop(const size_t index) override {
-		TDeque<TType>::pop(index);
+		TDeque<TType, TAllocator>::pop(index);
 	}
 };
 
@@ -0,0 +1,278 @@
+﻿#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include "Threading.h"
+
+namespace sstl {
+
+	// A run of contiguous elements, used to hand out parts of a ring without copying
+	template <typename TType>
+	struct span {
+		TType* data = nullptr;
+		size_t size = 0;
+
+		TType* begin() const { return data; }
+		TType* end() const { return data + size; }
+
+		TType& operator[](const size_t index) const { return data[index]; }
+	};
+
+	// Slots of a ring with a capacity known at compile time, stored inline
+	template <typename TType, size_t TSize>
+	struct ring_storage {
+
+		static_assert((TSize & (TSize - 1)) == 0, "Ring capacity must be a power of two!");
+
+		ring_storage() = default;
+
+		[[nodiscard]] constexpr size_t capacity() const { return TSize; }
+
+		TType* slots() { return std::launder(reinterpret_cast<TType*>(m_Storage)); }
+
+	private:
+
+		alignas(TType) unsigned char m_Storage[TSize * sizeof(TType)];
+	};
+
+	// Slots of a ring with a capacity picked on construction, rounded up to a power of two
+	template <typename TType>
+	struct ring_storage<TType, 0> {
+
+		explicit ring_storage(const size_t capacity)
+		: m_Capacity(roundCapacity(capacity)),
+		  m_Storage(static_cast<TType*>(::operator new(m_Capacity * sizeof(TType), std::align_val_t{alignof(TType)}))) {}
+
+		ring_storage(const ring_storage&) = delete;
+		ring_storage& operator=(const ring_storage&) = delete;
+
+		~ring_storage() {
+			::operator delete(m_Storage, std::align_val_t{alignof(TType)});
+		}
+
+		[[nodiscard]] size_t capacity() const { return m_Capacity; }
+
+		TType* slots() { return m_Storage; }
+
+	private:
+
+		static size_t roundCapacity(const size_t capacity) {
+			size_t rounded = 1;
+			while (rounded < capacity) rounded <<= 1;
+			return rounded;
+		}
+
+		const size_t m_Capacity;
+
+		TType* m_Storage;
+	};
+}
+
+// First in first out ring for exactly one producer thread and one consumer thread, every operation finishes in a bounded number of steps
+// TSize is the capacity, which must be a power of two, or 0 to pick the capacity on construction
+// Only the producer may call push functions and only the consumer may call pop functions, use TConcurrentQueue for more threads
+// Each side keeps a cached copy of the other side's index, and only reloads it when the ring looks full or empty
+template <typename TType, size_t TSize = 0>
+struct TRingBuffer {
+
+	template <size_t TOtherSize = TSize,
+		std::enable_if_t<TOtherSize != 0, int> = 0
+	>
+	TRingBuffer() {}
+
+	template <size_t TOtherSize = TSize,
+		std::enable_if_t<TOtherSize == 0, int> = 0
+	>
+	explicit TRingBuffer(const size_t capacity): m_Storage(capacity) {}
+
+	// The producer and consumer hold indices into the ring, so it cannot be copied or moved
+	TRingBuffer(const TRingBuffer&) = delete;
+	TRingBuffer& operator=(const TRingBuffer&) = delete;
+
+	~TRingBuffer() {
+		clear();
+	}
+
+	[[nodiscard]] size_t getCapacity() const {
+		return m_Storage.capacity();
+	}
+
+	// Exact from either thread when the other is idle, otherwise only an estimate
+	[[nodiscard]] size_t getSize() const {
+		const size_t head = m_Consumer.head.load(std::memory_order_acquire);
+		const size_t tail = m_Producer.tail.load(std::memory_order_acquire);
+		return tail - head;
+	}
+
+	/*
+	 * Producer
+	 */
+
+	// Constructs an element in place from args at the back, returns false if the ring is full
+	template <typename... TArgs>
+	bool tryEmplace(TArgs&&... args) {
+		const size_t tail = m_Producer.tail.load(std::memory_order_relaxed);
+		if (freeSlots(tail) == 0) return false;
+		new (m_Storage.slots() + (tail & mask())) TType(std::forward<TArgs>(args)...);
+		m_Producer.tail.store(tail + 1, std::memory_order_release);
+		return true;
+	}
+
+	bool tryPush(const TType& obj) {
+		return tryEmplace(obj);
+	}
+
+	bool tryPush(TType&& obj) {
+		return tryEmplace(std::move(obj));
+	}
+
+	// Pushes as many elements of [first, last) as fit, returns how many were pushed
+	// The consumer sees all of them at once, through a single store
+	template <typename TIterator>
+	size_t pushRange(TIterator first, TIterator last) {
+		const size_t tail = m_Producer.tail.load(std::memory_order_relaxed);
+		const size_t wanted = static_cast<size_t>(std::distance(first, last));
+		const size_t amt = std::min(wanted, freeSlots(tail, wanted));
+		for (size_t i = 0; i < amt; ++i, ++first) {
+			new (m_Storage.slots() + ((tail + i) & mask())) TType(*first);
+		}
+		m_Producer.tail.store(tail + amt, std::memory_order_release);
+		return amt;
+	}
+
+	// Pushes as many elements of another container or range as fit, elements are moved out if it is an rvalue
+	template <typename TRange>
+	size_t pushRange(TRange&& range) {
+		if constexpr (std::is_rvalue_reference_v<TRange&&>) {
+			return pushRange(std::make_move_iterator(range.begin()), std::make_move_iterator(range.end()));
+		} else {
+			return pushRange(range.begin(), range.end());
+		}
+	}
+
+	// Gets the free slots up to the end of the ring, so the producer can write elements directly into it
+	// The slots are raw storage, so only trivial types can be written this way, other types use pushRange or tryEmplace
+	sstl::span<TType> beginWrite() {
+		static_assert(std::is_trivially_default_constructible_v<TType> && std::is_trivially_destructible_v<TType>, "Only trivial types can be written through a span!");
+		const size_t tail = m_Producer.tail.load(std::memory_order_relaxed);
+		const size_t index = tail & mask();
+		const size_t wanted = getCapacity() - index;
+		return {m_Storage.slots() + index, std::min(freeSlots(tail, wanted), wanted)};
+	}
+
+	// Hands the first amt elements of the last beginWrite span to the consumer
+	void commitWrite(const size_t amt) {
+		m_Producer.tail.store(m_Producer.tail.load(std::memory_order_relaxed) + amt, std::memory_order_release);
+	}
+
+	/*
+	 * Consumer
+	 */
+
+	// Gets the front element without popping it, or nullptr if the ring is empty
+	TType* peek() {
+		const size_t head = m_Consumer.head.load(std::memory_order_relaxed);
+		if (filledSlots(head) == 0) return nullptr;
+		return m_Storage.slots() + (head & mask());
+	}
+
+	// Moves the front element into out, returns false and leaves out untouched if the ring is empty
+	bool tryPop(TType& out) {
+		const size_t head = m_Consumer.head.load(std::memory_order_relaxed);
+		if (filledSlots(head) == 0) return false;
+		TType* obj = m_Storage.slots() + (head & mask());
+		out = std::move(*obj);
+		obj->~TType();
+		m_Consumer.head.store(head + 1, std::memory_order_release);
+		return true;
+	}
+
+	// Pops up to amt elements from the front and passes each to func in order, returns how many were popped
+	template <typename TFunc>
+	size_t popRange(const size_t amt, TFunc&& func) {
+		const size_t head = m_Consumer.head.load(std::memory_order_relaxed);
+		const size_t count = std::min(amt, filledSlots(head, amt));
+		for (size_t i = 0; i < count; ++i) {
+			TType* obj = m_Storage.slots() + ((head + i) & mask());
+			func(std::move(*obj));
+			obj->~TType();
+		}
+		m_Consumer.head.store(head + count, std::memory_order_release);
+		return count;
+	}
+
+	// Pops up to amt elements into the back of a container with push, returns how many were popped
+	template <typename TContainer>
+	size_t transferRange(TContainer& otr, const size_t amt) {
+		return popRange(amt, [&](TType&& obj) { otr.push(std::move(obj)); });
+	}
+
+	// Gets the filled slots up to the end of the ring, so the consumer can use elements where they are
+	sstl::span<TType> beginRead() {
+		const size_t head = m_Consumer.head.load(std::memory_order_relaxed);
+		const size_t index = head & mask();
+		const size_t wanted = getCapacity() - index;
+		return {m_Storage.slots() + index, std::min(filledSlots(head, wanted), wanted)};
+	}
+
+	// Pops the first amt elements of the last beginRead span, handing their slots back to the producer
+	void commitRead(const size_t amt) {
+		const size_t head = m_Consumer.head.load(std::memory_order_relaxed);
+		if constexpr (!std::is_trivially_destructible_v<TType>) {
+			for (size_t i = 0; i < amt; ++i) {
+				m_Storage.slots()[(head + i) & mask()].~TType();
+			}
+		}
+		m_Consumer.head.store(head + amt, std::memory_order_release);
+	}
+
+	// Pops until the producer's tail, reloaded on every pass, reaches the head
+	void clear() {
+		while (popRange(getCapacity(), [](TType&&) {}) != 0) {}
+	}
+
+protected:
+
+	[[nodiscard]] size_t mask() const {
+		return getCapacity() - 1;
+	}
+
+	// Only reloads the consumer's head when the cached one says fewer than wanted slots are free
+	size_t freeSlots(const size_t tail, const size_t wanted = 1) {
+		size_t free = getCapacity() - (tail - m_Producer.cachedHead);
+		if (free < wanted) {
+			m_Producer.cachedHead = m_Consumer.head.load(std::memory_order_acquire);
+			free = getCapacity() - (tail - m_Producer.cachedHead);
+		}
+		return free;
+	}
+
+	// Only reloads the producer's tail when the cached one says fewer than wanted slots are filled
+	size_t filledSlots(const size_t head, const size_t wanted = 1) {
+		size_t filled = m_Consumer.cachedTail - head;
+		if (filled < wanted) {
+			m_Consumer.cachedTail = m_Producer.tail.load(std::memory_order_acquire);
+			filled = m_Consumer.cachedTail - head;
+		}
+		return filled;
+	}
+
+	// Everything the producer writes sits on one cache line and everything the consumer writes on another
+	struct alignas(64) producer {
+		std::atomic<size_t> tail = 0;
+		size_t cachedHead = 0;
+	};
+
+	struct alignas(64) consumer {
+		std::atomic<size_t> head = 0;
+		size_t cachedTail = 0;
+	};
+
+	producer m_Producer;
+	consumer m_Consumer;
+
+	sstl::ring_storage<TType, TSize> m_Storage;
+};
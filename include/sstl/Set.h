@@ -1,16 +1,23 @@
 ﻿#pragma once
 
+#include <iterator>
 #include <unordered_set>
 #include "Container.h"
 #include "InitializerList.h"
 
-template <typename TType,
+template <typename TType, typename TAllocator = std::allocator<TType>,
 	std::enable_if_t<sstl::is_hashable_v<TType>, int> = 0
 >
 struct TSet : TSingleAssociativeContainer<TType> {
 
+	// Elements are keys, so they cannot be modified in place
+	using iterator = typename std::unordered_set<TType, sstl::hasher<TType>, std::equal_to<TType>, TAllocator>::const_iterator;
+	using const_iterator = typename std::unordered_set<TType, sstl::hasher<TType>, std::equal_to<TType>, TAllocator>::const_iterator;
+
 	TSet() = default;
 
+	explicit TSet(const TAllocator& allocator): m_Container(allocator) {}
+
 	template <typename TOtherType = TType,
 		std::enable_if_t<std::is_copy_constructible_v<TOtherType>, int> = 0
 	>
@@ -28,6 +35,10 @@ struct TSet : TSingleAssociativeContainer<TType> {
 		return m_Container.size();
 	}
 
+	[[nodiscard]] TAllocator getAllocator() const {
+		return m_Container.get_allocator();
+	}
+
 	virtual const TType& top() const override {
 		return *m_Container.begin();
 	}
@@ -95,6 +106,52 @@ struct TSet : TSingleAssociativeContainer<TType> {
 		}
 	}
 
+	// Constructs an element in place from args, no temporary TType is made
+	template <typename... TArgs>
+	const TType& emplace(TArgs&&... args) {
+		return *m_Container.emplace(std::forward<TArgs>(args)...).first;
+	}
+
+	// Adds every element in [first, last), the table is only grown once up front instead of rehashing as it fills
+	template <typename TIterator>
+	void pushRange(TIterator first, TIterator last) {
+		if constexpr (std::is_base_of_v<std::forward_iterator_tag, typename std::iterator_traits<TIterator>::iterator_category>) {
+			m_Container.reserve(m_Container.size() + static_cast<size_t>(std::distance(first, last)));
+		}
+		m_Container.insert(first, last);
+	}
+
+	// Adds every element of another container or range, elements are moved out if it is an rvalue
+	template <typename TRange>
+	void pushRange(TRange&& range) {
+		if constexpr (std::is_rvalue_reference_v<TRange&&>) {
+			pushRange(std::make_move_iterator(range.begin()), std::make_move_iterator(range.end()));
+		} else {
+			pushRange(range.begin(), range.end());
+		}
+	}
+
+	// Moves every element of otr that is not already present into this set, elements that are stay in otr
+	// The nodes are relinked rather than copied, so nothing is allocated and elements keep their address
+	// Nodes can only be relinked between sets that share an allocator, otherwise the elements are moved one by one
+	void merge(TSet& otr) {
+		if (otr.m_Container.get_allocator() == m_Container.get_allocator()) {
+			m_Container.merge(otr.m_Container);
+			return;
+		}
+		for (auto itr = otr.m_Container.begin(); itr != otr.m_Container.end();) {
+			if (m_Container.find(*itr) != m_Container.end()) {
+				++itr;
+				continue;
+			}
+			m_Container.insert(std::move(otr.m_Container.extract(itr++).value()));
+		}
+	}
+
+	void merge(TSet&& otr) {
+		merge(otr);
+	}
+
 	virtual void replace(const TType& tgt, const TType& obj) override {
 		if constexpr (std::is_copy_constructible_v<TType>) {
 			// Since this container is unordered, replacing doesn't need to set at the same index
@@ -166,15 +223,31 @@ struct TSet : TSingleAssociativeContainer<TType> {
 		}
 	}
 
+	// Iterates through each element, accepts any callable so the loop can be inlined
+	template <typename TFunc>
+	void forEach(TFunc&& func) const {
+		for (auto itr = m_Container.begin(); itr != m_Container.end(); ++itr) {
+			func(*itr);
+		}
+	}
+
+	iterator begin() { return m_Container.begin(); }
+
+	const_iterator begin() const { return m_Container.begin(); }
+
+	iterator end() { return m_Container.end(); }
+
+	const_iterator end() const { return m_Container.end(); }
+
+	const_iterator cbegin() const { return m_Container.cbegin(); }
+
+	const_iterator cend() const { return m_Container.cend(); }
+
 protected:
 
-	struct Hasher {
-		size_t operator()(const TType& p) const noexcept {
-			return getHash(p);
-		}
-	};
+	using Hasher = sstl::hasher<TType>;
 
-	std::unordered_set<TType, Hasher> m_Container;
+	std::unordered_set<TType, Hasher, std::equal_to<TType>, TAllocator> m_Container;
 };
 
 template <typename TType, typename... TArgs>
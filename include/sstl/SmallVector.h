@@ -0,0 +1,580 @@
+﻿#pragma once
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <new>
+#include "Container.h"
+#include "InitializerList.h"
+#include "Sort.h"
+
+// Vector that stores up to TInline elements inside itself, and only allocates once it grows past them
+// Most vectors only ever hold a few elements, so they never touch the heap, and a vector of them keeps its elements next to each other
+// Moving a small vector moves its elements one by one instead of stealing a pointer, so TInline should stay small
+template <typename TType, size_t TInline = 8, typename TAllocator = std::allocator<TType>>
+struct TSmallVector : TSequenceContainer<TType> {
+
+	static_assert(TInline > 0, "A small vector needs room for at least one element inline, use TVector otherwise!");
+
+	using iterator = TType*;
+	using const_iterator = const TType*;
+	using reverse_iterator = std::reverse_iterator<TType*>;
+	using const_reverse_iterator = std::reverse_iterator<const TType*>;
+
+	TSmallVector() = default;
+
+	// Only memory past the inline elements comes from the allocator
+	explicit TSmallVector(const TAllocator& allocator): m_Allocator(allocator) {}
+
+	template <typename TOtherType = TType,
+		std::enable_if_t<std::is_copy_constructible_v<TOtherType>, int> = 0
+	>
+	TSmallVector(TInitializerList<TType> init) {
+		pushRange(init.begin(), init.end());
+	}
+
+	template <typename... TArgs,
+		std::enable_if_t<std::conjunction_v<std::is_constructible<TType, TArgs>...>, int> = 0
+	>
+	explicit TSmallVector(TArgs&&... args) {
+		reserve(sizeof...(TArgs));
+		(emplace(std::forward<TArgs>(args)), ...);
+	}
+
+	TSmallVector(const TSmallVector& otr): m_Allocator(traits::select_on_container_copy_construction(otr.m_Allocator)) {
+		pushRange(otr.begin(), otr.end());
+	}
+
+	// Heap memory is taken over, but inline elements are moved one by one, so this is only noexcept when moving an element cannot throw
+	TSmallVector(TSmallVector&& otr) noexcept(std::is_nothrow_move_constructible_v<TType>): m_Allocator(otr.m_Allocator) {
+		steal(otr);
+	}
+
+	TSmallVector& operator=(const TSmallVector& otr) {
+		if (this != &otr) {
+			clear();
+			if constexpr (traits::propagate_on_container_copy_assignment::value) {
+				if (m_Allocator != otr.m_Allocator) release();
+				m_Allocator = otr.m_Allocator;
+			}
+			pushRange(otr.begin(), otr.end());
+		}
+		return *this;
+	}
+
+	// Heap memory from an allocator that is not ours cannot be taken over, so then the elements are moved one by one instead
+	TSmallVector& operator=(TSmallVector&& otr) noexcept(std::is_nothrow_move_constructible_v<TType> && (traits::propagate_on_container_move_assignment::value || traits::is_always_equal::value)) {
+		if (this != &otr) {
+			clear();
+			if (traits::propagate_on_container_move_assignment::value || m_Allocator == otr.m_Allocator) {
+				release();
+				if constexpr (traits::propagate_on_container_move_assignment::value) m_Allocator = otr.m_Allocator;
+				steal(otr);
+			} else {
+				pushRange(std::make_move_iterator(otr.begin()), std::make_move_iterator(otr.end()));
+				otr.clear();
+			}
+		}
+		return *this;
+	}
+
+	~TSmallVector() override {
+		clear();
+		release();
+	}
+
+	[[nodiscard]] virtual size_t getSize() const override {
+		return m_Size;
+	}
+
+	[[nodiscard]] TAllocator getAllocator() const {
+		return m_Allocator;
+	}
+
+	[[nodiscard]] size_t getCapacity() const {
+		return m_Capacity;
+	}
+
+	// If the elements are still stored inside the vector, and not on the heap
+	[[nodiscard]] bool isInline() const {
+		return m_Data == inlineData();
+	}
+
+	TType* data() { return m_Data; }
+
+	const TType* data() const { return m_Data; }
+
+	virtual TType& top() override {
+		return m_Data[0];
+	}
+
+	virtual const TType& top() const override {
+		return m_Data[0];
+	}
+
+	virtual TType& bottom() override {
+		return m_Data[m_Size - 1];
+	}
+
+	virtual const TType& bottom() const override {
+		return m_Data[m_Size - 1];
+	}
+
+	virtual bool contains(const TType& obj) const override {
+		if constexpr (sstl::is_equality_comparable_v<TType>) {
+			return std::find(begin(), end(), obj) != end();
+		} else {
+			throw std::runtime_error("Type is not comparable!");
+		}
+	}
+
+	virtual bool contains(typename TUnfurled<TType>::Type* obj) const override {
+		if constexpr (sstl::is_managed_v<TType>) {
+			// Will compare pointers, is always comparable
+			return findManaged(obj) != end();
+		} else {
+			return contains(*obj);
+		}
+	}
+
+	virtual size_t find(const TType& obj) const override {
+		if constexpr (sstl::is_equality_comparable_v<TType>) {
+			return static_cast<size_t>(std::find(begin(), end(), obj) - begin());
+		} else {
+			throw std::runtime_error("Type is not comparable!");
+		}
+	}
+
+	virtual size_t find(typename TUnfurled<TType>::Type* obj) const override {
+		if constexpr (sstl::is_managed_v<TType>) {
+			// Will compare pointers, is always comparable
+			return static_cast<size_t>(findManaged(obj) - begin());
+		} else {
+			return find(*obj);
+		}
+	}
+
+	virtual TType& get(size_t index) override {
+		return m_Data[index];
+	}
+
+	virtual const TType& get(size_t index) const override {
+		return m_Data[index];
+	}
+
+	virtual void resize(size_t amt) override {
+		if constexpr (std::is_default_constructible_v<TType>) {
+			if (amt < m_Size) {
+				popRange(amt, m_Size);
+				return;
+			}
+			reserve(amt);
+			for (; m_Size < amt; ++m_Size) {
+				new (m_Data + m_Size) TType();
+			}
+		} else {
+			throw std::runtime_error("Type is not default constructible!");
+		}
+	}
+
+	virtual void resize(const size_t amt, std::function<TType(size_t)> func) override {
+		reserve(amt);
+		for (size_t i = m_Size; i < amt; ++i) {
+			emplace(func(i));
+		}
+	}
+
+	virtual void reserve(size_t amt) override {
+		if (amt > m_Capacity) {
+			reallocate(amt);
+		}
+	}
+
+	virtual TType& push() override {
+		if constexpr (std::is_default_constructible_v<TType>) {
+			return emplace();
+		} else {
+			throw std::runtime_error("Type is not default constructible!");
+		}
+	}
+
+	virtual size_t push(const TType& obj) override {
+		if constexpr (std::is_copy_constructible_v<TType>) {
+			emplace(obj);
+			return m_Size - 1;
+		} else {
+			throw std::runtime_error("Type is not copyable");
+		}
+	}
+
+	virtual size_t push(TType&& obj) override {
+		if constexpr (std::is_move_constructible_v<TType>) {
+			emplace(std::move(obj));
+			return m_Size - 1;
+		} else {
+			throw std::runtime_error("Type is not moveable");
+		}
+	}
+
+	virtual void push(const size_t index, const TType& obj) override {
+		if constexpr (std::is_copy_constructible_v<TType>) {
+			emplaceAt(index, obj);
+		} else {
+			throw std::runtime_error("Type is not copyable!");
+		}
+	}
+
+	virtual void push(const size_t index, TType&& obj) override {
+		if constexpr (std::is_move_constructible_v<TType>) {
+			emplaceAt(index, std::move(obj));
+		} else {
+			throw std::runtime_error("Type is not moveable!");
+		}
+	}
+
+	// Adds every element in [first, last), memory is only reserved once when the distance is known
+	template <typename TIterator>
+	void pushRange(TIterator first, TIterator last) {
+		if constexpr (std::is_base_of_v<std::forward_iterator_tag, typename std::iterator_traits<TIterator>::iterator_category>) {
+			reserve(m_Size + static_cast<size_t>(std::distance(first, last)));
+		}
+		for (; first != last; ++first) {
+			emplace(*first);
+		}
+	}
+
+	// Adds every element of another container or range, elements are moved out if it is an rvalue
+	template <typename TRange>
+	void pushRange(TRange&& range) {
+		if constexpr (std::is_rvalue_reference_v<TRange&&>) {
+			pushRange(std::make_move_iterator(range.begin()), std::make_move_iterator(range.end()));
+		} else {
+			pushRange(range.begin(), range.end());
+		}
+	}
+
+	// Constructs an element in place from args, no temporary TType is made
+	template <typename... TArgs>
+	TType& emplace(TArgs&&... args) {
+		if (m_Size < m_Capacity) {
+			TType* obj = new (m_Data + m_Size) TType(std::forward<TArgs>(args)...);
+			++m_Size;
+			return *obj;
+		}
+		// The new element is made before the old ones are moved out, since args may refer to one of them
+		const size_t capacity = m_Capacity * 2;
+		TType* data = traits::allocate(m_Allocator, capacity);
+		TType* obj = nullptr;
+		try {
+			obj = new (data + m_Size) TType(std::forward<TArgs>(args)...);
+			relocate(m_Data, m_Size, data);
+		} catch (...) {
+			if (obj) obj->~TType();
+			traits::deallocate(m_Allocator, data, capacity);
+			throw;
+		}
+		release();
+		m_Data = data;
+		m_Capacity = capacity;
+		++m_Size;
+		return *obj;
+	}
+
+	// Constructs an element in place at index from args
+	template <typename... TArgs>
+	TType& emplaceAt(const size_t index, TArgs&&... args) {
+		emplace(std::forward<TArgs>(args)...);
+		std::rotate(m_Data + index, m_Data + m_Size - 1, m_Data + m_Size);
+		return m_Data[index];
+	}
+
+	virtual void replace(const size_t index, const TType& obj) override {
+		if constexpr (std::is_copy_constructible_v<TType>) {
+			pop(index);
+			push(index, obj);
+		} else {
+			throw std::runtime_error("Type is not copyable!");
+		}
+	}
+
+	virtual void replace(const size_t index, TType&& obj) override {
+		if constexpr (std::is_move_constructible_v<TType>) {
+			pop(index);
+			push(index, std::move(obj));
+		} else {
+			throw std::runtime_error("Type is not moveable!");
+		}
+	}
+
+	// Destroys every element but keeps any heap memory, so refilling the vector does not allocate again
+	virtual void clear() override {
+		std::destroy(m_Data, m_Data + m_Size);
+		m_Size = 0;
+	}
+
+	// Removes the top, which is the front, so everything after it is shifted down, use popBack to remove in O(1)
+	virtual void pop() override {
+		pop(static_cast<size_t>(0));
+	}
+
+	// Removes the last element in O(1)
+	virtual void popBack() override {
+		m_Data[--m_Size].~TType();
+	}
+
+	virtual void pop(const size_t index) override {
+		popRange(index, index + 1);
+	}
+
+	virtual void pop(const TType& obj) override {
+		if constexpr (sstl::is_equality_comparable_v<TType>) {
+			const TType* itr = std::find(begin(), end(), obj);
+			if (itr != end()) pop(static_cast<size_t>(itr - begin()));
+		} else {
+			throw std::runtime_error("Type is not comparable!");
+		}
+	}
+
+	virtual void pop(typename TUnfurled<TType>::Type* obj) override {
+		if constexpr (sstl::is_managed_v<TType>) {
+			// Will compare pointers, is always comparable
+			const TType* itr = findManaged(obj);
+			if (itr != end()) pop(static_cast<size_t>(itr - begin()));
+		} else {
+			pop(*obj);
+		}
+	}
+
+	virtual void popRange(const size_t start, const size_t end) override {
+		std::move(m_Data + end, m_Data + m_Size, m_Data + start);
+		std::destroy(m_Data + m_Size - (end - start), m_Data + m_Size);
+		m_Size -= end - start;
+	}
+
+	// Moves the whole range at once if otr is a TSmallVector, derived containers keep their own ordering through transferIn
+	virtual void transferRange(TSequenceContainer<TType>& otr, const size_t start, const size_t end) override {
+		// The elements would be inserted from the range that is being removed, and they are already here anyway
+		if (&otr == this) return;
+		if (auto otrVector = dynamic_cast<TSmallVector*>(&otr)) {
+			otrVector->transferIn(m_Data + start, m_Data + end);
+			popRange(start, end);
+			return;
+		}
+		TSequenceContainer<TType>::transferRange(otr, start, end);
+	}
+
+	// Sorts by comp on the calling thread, integers and floats compared with std::less are radix sorted
+	template <typename TCompare = std::less<TType>>
+	void sort(TCompare comp = {}) {
+		sstl::sort(begin(), end(), comp);
+	}
+
+	// Splits large containers across pool, ParallelSort.h has to be included to use it
+	template <typename TCompare>
+	void sort(TCompare comp, TThreadPool& pool) {
+		sstl::sort(begin(), end(), comp, pool);
+	}
+
+	// Like sort, but equal elements keep their order
+	template <typename TCompare = std::less<TType>>
+	void stableSort(TCompare comp = {}) {
+		sstl::stableSort(begin(), end(), comp);
+	}
+
+	template <typename TCompare>
+	void stableSort(TCompare comp, TThreadPool& pool) {
+		sstl::stableSort(begin(), end(), comp, pool);
+	}
+
+	// Sorts only the amt smallest elements into the front, the rest are left in no particular order
+	template <typename TCompare = std::less<TType>>
+	void partialSort(const size_t amt, TCompare comp = {}) {
+		std::partial_sort(begin(), begin() + std::min(amt, m_Size), end(), comp);
+	}
+
+	// Puts the element that belongs at index after sorting there, with nothing after it smaller and nothing before it larger
+	// Does nothing if index is past the end, the same way partialSort clamps amt
+	template <typename TCompare = std::less<TType>>
+	void nthElement(const size_t index, TCompare comp = {}) {
+		std::nth_element(begin(), begin() + std::min(index, m_Size), end(), comp);
+	}
+
+	virtual void forEach(const std::function<void(size_t, TType&)>& func) override {
+		for (size_t i = 0; i < m_Size; ++i) {
+			func(i, m_Data[i]);
+		}
+	}
+
+	virtual void forEach(const std::function<void(size_t, const TType&)>& func) const override {
+		for (size_t i = 0; i < m_Size; ++i) {
+			func(i, m_Data[i]);
+		}
+	}
+
+	virtual void forEachReverse(const std::function<void(size_t, TType&)>& func) override {
+		for (size_t i = m_Size; i > 0; --i) {
+			func(i - 1, m_Data[i - 1]);
+		}
+	}
+
+	virtual void forEachReverse(const std::function<void(size_t, const TType&)>& func) const override {
+		for (size_t i = m_Size; i > 0; --i) {
+			func(i - 1, m_Data[i - 1]);
+		}
+	}
+
+	// Iterates through each element, accepts any callable so the loop can be inlined
+	template <typename TFunc>
+	void forEach(TFunc&& func) {
+		for (size_t i = 0; i < m_Size; ++i) {
+			func(i, m_Data[i]);
+		}
+	}
+
+	// Iterates through each element, const version
+	template <typename TFunc>
+	void forEach(TFunc&& func) const {
+		for (size_t i = 0; i < m_Size; ++i) {
+			func(i, m_Data[i]);
+		}
+	}
+
+	// Iterates through each element in reverse, accepts any callable so the loop can be inlined
+	template <typename TFunc>
+	void forEachReverse(TFunc&& func) {
+		for (size_t i = m_Size; i > 0; --i) {
+			func(i - 1, m_Data[i - 1]);
+		}
+	}
+
+	// Iterates through each element in reverse, const version
+	template <typename TFunc>
+	void forEachReverse(TFunc&& func) const {
+		for (size_t i = m_Size; i > 0; --i) {
+			func(i - 1, m_Data[i - 1]);
+		}
+	}
+
+	template <typename TFunc>
+	void doFor(const size_t index, TFunc&& func) {
+		func(m_Data[index]);
+	}
+
+	template <typename TFunc>
+	void doFor(const size_t index, TFunc&& func) const {
+		func(m_Data[index]);
+	}
+
+	template <typename TFunc>
+	void doFor(const size_t start, const size_t end, TFunc&& func) {
+		for (size_t i = start; i < end; ++i) {
+			func(i, m_Data[i]);
+		}
+	}
+
+	template <typename TFunc>
+	void doFor(const size_t start, const size_t end, TFunc&& func) const {
+		for (size_t i = start; i < end; ++i) {
+			func(i, m_Data[i]);
+		}
+	}
+
+	iterator begin() { return m_Data; }
+
+	const_iterator begin() const { return m_Data; }
+
+	iterator end() { return m_Data + m_Size; }
+
+	const_iterator end() const { return m_Data + m_Size; }
+
+	const_iterator cbegin() const { return m_Data; }
+
+	const_iterator cend() const { return m_Data + m_Size; }
+
+	reverse_iterator rbegin() { return reverse_iterator(end()); }
+
+	const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+
+	reverse_iterator rend() { return reverse_iterator(begin()); }
+
+	const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+	const_reverse_iterator crbegin() const { return const_reverse_iterator(end()); }
+
+	const_reverse_iterator crend() const { return const_reverse_iterator(begin()); }
+
+protected:
+
+	using traits = std::allocator_traits<TAllocator>;
+
+	// Takes a run moved out of another TSmallVector, overridden by containers that order their elements themselves
+	virtual void transferIn(iterator first, iterator last) {
+		pushRange(std::make_move_iterator(first), std::make_move_iterator(last));
+	}
+
+	TType* inlineData() { return std::launder(reinterpret_cast<TType*>(m_Inline)); }
+
+	const TType* inlineData() const { return std::launder(reinterpret_cast<const TType*>(m_Inline)); }
+
+	const TType* findManaged(typename TUnfurled<TType>::Type* obj) const {
+		return std::find_if(begin(), end(), [&](const TType& otr) { return std::invoke(TUnfurled<TType>::get, otr) == obj; });
+	}
+
+	// Moves amt elements into uninitialized memory at to, and destroys what is left behind
+	static void relocate(TType* from, const size_t amt, TType* to) {
+		if constexpr (std::is_trivially_copyable_v<TType>) {
+			if (amt > 0) std::memcpy(static_cast<void*>(to), static_cast<const void*>(from), amt * sizeof(TType));
+		} else {
+			std::uninitialized_move(from, from + amt, to);
+			std::destroy(from, from + amt);
+		}
+	}
+
+	void reallocate(const size_t capacity) {
+		TType* data = traits::allocate(m_Allocator, capacity);
+		try {
+			relocate(m_Data, m_Size, data);
+		} catch (...) {
+			traits::deallocate(m_Allocator, data, capacity);
+			throw;
+		}
+		release();
+		m_Data = data;
+		m_Capacity = capacity;
+	}
+
+	// Frees heap memory, the elements must already be destroyed or moved out
+	void release() {
+		if (!isInline()) {
+			traits::deallocate(m_Allocator, m_Data, m_Capacity);
+			m_Data = inlineData();
+			m_Capacity = TInline;
+		}
+	}
+
+	// Takes the heap memory of otr, or moves its inline elements one by one, leaving otr empty and inline
+	void steal(TSmallVector& otr) {
+		if (otr.isInline()) {
+			relocate(otr.m_Data, otr.m_Size, m_Data);
+		} else {
+			m_Data = otr.m_Data;
+			m_Capacity = otr.m_Capacity;
+			otr.m_Data = otr.inlineData();
+			otr.m_Capacity = TInline;
+		}
+		m_Size = otr.m_Size;
+		otr.m_Size = 0;
+	}
+
+	alignas(TType) unsigned char m_Inline[TInline * sizeof(TType)];
+
+	TType* m_Data = inlineData();
+	size_t m_Size = 0;
+	size_t m_Capacity = TInline;
+
+	TAllocator m_Allocator;
+};
+
+template <typename TType, typename... TArgs>
+TSmallVector(TType, TArgs...) -> TSmallVector<typename sstl::EnforceConvertible<TType, TArgs...>::Type>;
@@ -0,0 +1,156 @@
+﻿#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+class TThreadPool;
+
+namespace sstl {
+
+	// Below this many elements comparing is faster than counting, since every radix pass clears and scans 256 buckets
+	constexpr size_t radixSortThreshold = 1 << 10;
+
+	// Integers and floats ordered by std::less can be sorted by their bits instead of by comparing them
+	template <typename TType, typename TCompare>
+	constexpr bool is_radix_sortable_v =
+		(std::is_same_v<TCompare, std::less<TType>> || std::is_same_v<TCompare, std::less<>>) &&
+		((std::is_integral_v<TType> && !std::is_same_v<TType, bool>) || std::is_same_v<TType, float> || std::is_same_v<TType, double>);
+
+	// Maps obj to an unsigned key with the same order, signed integers get their sign bit flipped and negative floats every bit
+	template <typename TType>
+	auto radixKey(const TType obj) {
+		if constexpr (std::is_floating_point_v<TType>) {
+			using TKey = std::conditional_t<sizeof(TType) == 4, uint32_t, uint64_t>;
+			constexpr TKey sign = TKey(1) << (sizeof(TKey) * 8 - 1);
+			TKey key;
+			std::memcpy(&key, &obj, sizeof(TKey));
+			return (key & sign) ? static_cast<TKey>(~key) : static_cast<TKey>(key | sign);
+		} else {
+			using TKey = std::make_unsigned_t<TType>;
+			if constexpr (std::is_signed_v<TType>) {
+				return static_cast<TKey>(static_cast<TKey>(obj) ^ (TKey(1) << (sizeof(TKey) * 8 - 1)));
+			} else {
+				return static_cast<TKey>(obj);
+			}
+		}
+	}
+
+	// Least significant byte first, each pass counts the bytes in every chunk, then every chunk scatters its elements to where the counts say
+	// Chunks keep their elements in order so every pass is stable, and a pass where every element has the same byte is skipped
+	// forChunks(func) calls func(chunkStart, chunkEnd) for every chunk of grain elements, on the calling thread or across a pool
+	template <typename TIterator, typename TForChunks>
+	void radixSort(TIterator first, TIterator last, const size_t grain, TForChunks&& forChunks) {
+		using TType = typename std::iterator_traits<TIterator>::value_type;
+		using TKey = decltype(radixKey(std::declval<TType>()));
+
+		const size_t size = static_cast<size_t>(std::distance(first, last));
+		if (size == 0) return;
+		std::vector<std::array<size_t, 256>> counts((size + grain - 1) / grain);
+		// Arithmetic types are left uninitialized by new[], every slot is written before it is read
+		const std::unique_ptr<TType[]> buffer(new TType[size]);
+
+		// Chunk boundaries only depend on the grain, so start / grain always finds the same chunk's counts
+		const auto pass = [&](auto src, auto dst, const size_t shift) {
+			forChunks([&](const size_t start, const size_t end) {
+				std::array<size_t, 256>& count = counts[start / grain];
+				count.fill(0);
+				for (size_t i = start; i < end; ++i) {
+					++count[(radixKey(src[i]) >> shift) & 255];
+				}
+			});
+			for (size_t digit = 0; digit < 256; ++digit) {
+				size_t total = 0;
+				for (const std::array<size_t, 256>& count : counts) total += count[digit];
+				if (total == size) return false;
+				if (total > 0) break;
+			}
+			// Turns counts into where each chunk starts writing each byte, smaller bytes first and earlier chunks first within a byte
+			size_t offset = 0;
+			for (size_t digit = 0; digit < 256; ++digit) {
+				for (std::array<size_t, 256>& count : counts) {
+					const size_t amt = count[digit];
+					count[digit] = offset;
+					offset += amt;
+				}
+			}
+			forChunks([&](const size_t start, const size_t end) {
+				std::array<size_t, 256>& offsets = counts[start / grain];
+				for (size_t i = start; i < end; ++i) {
+					dst[offsets[(radixKey(src[i]) >> shift) & 255]++] = src[i];
+				}
+			});
+			return true;
+		};
+
+		bool inBuffer = false;
+		for (size_t shift = 0; shift < sizeof(TKey) * 8; shift += 8) {
+			if (inBuffer ? pass(buffer.get(), first, shift) : pass(first, buffer.get(), shift)) {
+				inBuffer = !inBuffer;
+			}
+		}
+		if (inBuffer) {
+			forChunks([&](const size_t start, const size_t end) {
+				std::copy(buffer.get() + start, buffer.get() + end, first + start);
+			});
+		}
+	}
+
+	template <typename TIterator>
+	void radixSort(TIterator first, TIterator last) {
+		const size_t size = static_cast<size_t>(std::distance(first, last));
+		radixSort(first, last, size, [size](auto&& func) { func(0, size); });
+	}
+
+	// Sorts on a thread pool, it is defined in ParallelSort.h so sorting on the calling thread does not pull in the pool
+	template <bool TStable, typename TIterator>
+	struct parallel_sort;
+
+	// Picks between a radix sort and the standard sort by type and size
+	// Floats are only radix sorted when stability does not matter, since -0 and 0 compare equal but have different bits
+	template <bool TStable, typename TIterator, typename TCompare>
+	void sortRange(TIterator first, TIterator last, TCompare& comp) {
+		using TType = typename std::iterator_traits<TIterator>::value_type;
+
+		if constexpr (is_radix_sortable_v<TType, TCompare> && (!TStable || std::is_integral_v<TType>)) {
+			if (static_cast<size_t>(std::distance(first, last)) >= radixSortThreshold) {
+				radixSort(first, last);
+				return;
+			}
+		}
+		if constexpr (TStable) {
+			std::stable_sort(first, last, comp);
+		} else {
+			std::sort(first, last, comp);
+		}
+	}
+
+	// Sorts [first, last) by comp on the calling thread, integers and floats compared with std::less are radix sorted
+	template <typename TIterator, typename TCompare = std::less<typename std::iterator_traits<TIterator>::value_type>>
+	void sort(TIterator first, TIterator last, TCompare comp = {}) {
+		sortRange<false>(first, last, comp);
+	}
+
+	// Splits large ranges across pool, ParallelSort.h has to be included to use it
+	template <typename TIterator, typename TCompare>
+	void sort(TIterator first, TIterator last, TCompare comp, TThreadPool& pool) {
+		parallel_sort<false, TIterator>::run(first, last, comp, pool);
+	}
+
+	// Like sort, but equal elements keep their order
+	template <typename TIterator, typename TCompare = std::less<typename std::iterator_traits<TIterator>::value_type>>
+	void stableSort(TIterator first, TIterator last, TCompare comp = {}) {
+		sortRange<true>(first, last, comp);
+	}
+
+	template <typename TIterator, typename TCompare>
+	void stableSort(TIterator first, TIterator last, TCompare comp, TThreadPool& pool) {
+		parallel_sort<true, TIterator>::run(first, last, comp, pool);
+	}
+}
@@ -3,36 +3,38 @@
 #include "Deque.h"
 
 // std::stack is already a wrapper around a deque, so we do that here too, and skip std::stack's own abstraction
-template <typename TType>
-struct TStack : TDeque<TType> {
+template <typename TType, typename TAllocator = std::allocator<TType>>
+struct TStack : TDeque<TType, TAllocator> {
 
 	TStack() = default;
 
+	explicit TStack(const TAllocator& allocator): TDeque<TType, TAllocator>(allocator) {}
+
 	template <typename TOtherType = TType,
 		std::enable_if_t<std::is_copy_constructible_v<TOtherType>, int> = 0
 	>
-	TStack(TInitializerList<TType> init): TDeque<TType>(init) {}
+	TStack(TInitializerList<TType> init): TDeque<TType, TAllocator>(init) {}
 
 	template <typename... TArgs,
 		std::enable_if_t<std::conjunction_v<std::is_constructible<TType, TArgs>...>, int> = 0
 	>
-	explicit TStack(TArgs&&... args): TDeque<TType>(std::forward<TArgs>(args)...) {}
+	explicit TStack(TArgs&&... args): TDeque<TType, TAllocator>(std::forward<TArgs>(args)...) {}
 
 	virtual void resize(const size_t amt, std::function<TType(size_t)> func) override {
-		const size_t previousSize = TDeque<TType>::getSize();
+		const size_t previousSize = TDeque<TType, TAllocator>::getSize();
 		for (size_t i = previousSize; i < amt; ++i) {
-			TDeque<TType>::m_Container.emplace_front(std::forward<TType>(func(i)));
+			TDeque<TType, TAllocator>::m_Container.emplace_front(std::forward<TType>(func(i)));
 		}
 	}
 
 	virtual TType& push() override {
-		TDeque<TType>::m_Container.emplace_front();
-		return TDeque<TType>::top();
+		TDeque<TType, TAllocator>::m_Container.emplace_front();
+		return TDeque<TType, TAllocator>::top();
 	}
 
 	virtual size_t push(const TType& obj) override {
 		if constexpr (std::is_copy_constructible_v<TType>) {
-			TDeque<TType>::m_Container.emplace_front(obj);
+			TDeque<TType, TAllocator>::m_Container.emplace_front(obj);
 			return 0;
 		} else {
 			throw std::runtime_error("Type is not copyable");
@@ -41,17 +43,41 @@ struct TStack : TDeque<TType> {
 
 	virtual size_t push(TType&& obj) override {
 		if constexpr (std::is_move_constructible_v<TType>) {
-			TDeque<TType>::m_Container.emplace_front(std::move(obj));
+			TDeque<TType, TAllocator>::m_Container.emplace_front(std::move(obj));
 			return 0;
 		} else {
 			throw std::runtime_error("Type is not moveable");
 		}
 	}
 
+	// Pushes every element in [first, last) onto the top, so the last element ends up on top
+	template <typename TIterator>
+	void pushRange(TIterator first, TIterator last) {
+		for (; first != last; ++first) {
+			TDeque<TType, TAllocator>::m_Container.emplace_front(*first);
+		}
+	}
+
+	// Pushes every element of another container or range, elements are moved out if it is an rvalue
+	template <typename TRange>
+	void pushRange(TRange&& range) {
+		if constexpr (std::is_rvalue_reference_v<TRange&&>) {
+			pushRange(std::make_move_iterator(range.begin()), std::make_move_iterator(range.end()));
+		} else {
+			pushRange(range.begin(), range.end());
+		}
+	}
+
+	// Constructs an element in place on the top of the stack
+	template <typename... TArgs>
+	TType& emplace(TArgs&&... args) {
+		return TDeque<TType, TAllocator>::m_Container.emplace_front(std::forward<TArgs>(args)...);
+	}
+
 	virtual void replace(const size_t index, const TType& obj) override {
 		if constexpr (std::is_copy_constructible_v<TType>) {
-			TDeque<TType>::pop(index);
-			TDeque<TType>::push(index, obj);
+			TDeque<TType, TAllocator>::pop(index);
+			TDeque<TType, TAllocator>::push(index, obj);
 		} else {
 			throw std::runtime_error("Type is not copyable");
 		}
@@ -59,73 +85,81 @@ struct TStack : TDeque<TType> {
 
 	virtual void replace(const size_t index, TType&& obj) override {
 		if constexpr (std::is_move_constructible_v<TType>) {
-			TDeque<TType>::pop(index);
-			TDeque<TType>::push(index, std::move(obj));
+			TDeque<TType, TAllocator>::pop(index);
+			TDeque<TType, TAllocator>::push(index, std::move(obj));
 		} else {
 			throw std::runtime_error("Type is not moveable");
 		}
 	}
 
 	virtual void pop() override {
-		TDeque<TType>::pop(static_cast<size_t>(0));
+		TDeque<TType, TAllocator>::pop(static_cast<size_t>(0));
 	}
 
+	// Keep the templated iteration from TDeque visible alongside the overrides
+	using TDeque<TType, TAllocator>::forEach;
+	using TDeque<TType, TAllocator>::forEachReverse;
+
 	virtual void forEach(const std::function<void(size_t, TType&)>& func) override {
 		size_t i = 0;
-		for (auto itr = TDeque<TType>::m_Container.begin(); itr != TDeque<TType>::m_Container.end(); ++itr, ++i) {
+		for (auto itr = TDeque<TType, TAllocator>::m_Container.begin(); itr != TDeque<TType, TAllocator>::m_Container.end(); ++itr, ++i) {
 			func(i, *itr);
 		}
 	}
 
 	virtual void forEach(const std::function<void(size_t, const TType&)>& func) const override {
 		size_t i = 0;
-		for (auto itr = TDeque<TType>::m_Container.begin(); itr != TDeque<TType>::m_Container.end(); ++itr, ++i) {
+		for (auto itr = TDeque<TType, TAllocator>::m_Container.begin(); itr != TDeque<TType, TAllocator>::m_Container.end(); ++itr, ++i) {
 			func(i, *itr);
 		}
 	}
 
 	virtual void forEachReverse(const std::function<void(size_t, TType&)>& func) override {
-		size_t i = TDeque<TType>::getSize() - 1;
-		for (auto itr = TDeque<TType>::m_Container.rbegin(); itr != TDeque<TType>::m_Container.rend(); ++itr, --i) {
+		size_t i = TDeque<TType, TAllocator>::getSize() - 1;
+		for (auto itr = TDeque<TType, TAllocator>::m_Container.rbegin(); itr != TDeque<TType, TAllocator>::m_Container.rend(); ++itr, --i) {
 			func(i, *itr);
 		}
 	}
 
 	virtual void forEachReverse(const std::function<void(size_t, const TType&)>& func) const override {
-		size_t i = TDeque<TType>::getSize() - 1;
-		for (auto itr = TDeque<TType>::m_Container.rbegin(); itr != TDeque<TType>::m_Container.rend(); ++itr, --i) {
+		size_t i = TDeque<TType, TAllocator>::getSize() - 1;
+		for (auto itr = TDeque<TType, TAllocator>::m_Container.rbegin(); itr != TDeque<TType, TAllocator>::m_Container.rend(); ++itr, --i) {
 			func(i, *itr);
 		}
 	}
 
 protected:
 
+	virtual void transferIn(typename TDeque<TType, TAllocator>::iterator first, typename TDeque<TType, TAllocator>::iterator last) override {
+		pushRange(std::make_move_iterator(first), std::make_move_iterator(last));
+	}
+
 	virtual TType& bottom() override {
-		return TDeque<TType>::bottom();
+		return TDeque<TType, TAllocator>::bottom();
 	}
 
 	virtual const TType& bottom() const override {
-		return TDeque<TType>::bottom();
+		return TDeque<TType, TAllocator>::bottom();
 	}
 
 	virtual TType& get(size_t index) override {
-		return TDeque<TType>::get(index);
+		return TDeque<TType, TAllocator>::get(index);
 	}
 
 	virtual const TType& get(size_t index) const override {
-		return TDeque<TType>::get(index);
+		return TDeque<TType, TAllocator>::get(index);
 	}
 
 	virtual void push(const size_t index, const TType& obj) override {
-		TDeque<TType>::push(index, obj);
+		TDeque<TType, TAllocator>::push(index, obj);
 	}
 
 	virtual void push(const size_t index, TType&& obj) override {
-		TDeque<TType>::push(index, std::move(obj));
+		TDeque<TType, TAllocator>::push(index, std::move(obj));
 	}
 
 	virtual void pop(const size_t index) override {
-		TDeque<TType>::pop(index);
+		TDeque<TType, TAllocator>::pop(index);
 	}
 };
 
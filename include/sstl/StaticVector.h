@@ -0,0 +1,487 @@
+﻿#pragma once
+
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <new>
+#include "Container.h"
+#include "InitializerList.h"
+#include "Sort.h"
+
+// Vector with a fixed capacity of TSize elements stored inside itself, it never allocates
+// Unlike TArray, slots past the size are left unconstructed and elements are always packed at the front, so push and popBack are O(1)
+// Pushing to a full static vector throws, use TSmallVector to spill to the heap instead
+template <typename TType, size_t TSize>
+struct TStaticVector : TSequenceContainer<TType> {
+
+	static_assert(TSize > 0, "A static vector needs room for at least one element!");
+
+	using iterator = TType*;
+	using const_iterator = const TType*;
+	using reverse_iterator = std::reverse_iterator<TType*>;
+	using const_reverse_iterator = std::reverse_iterator<const TType*>;
+
+	TStaticVector() = default;
+
+	template <typename TOtherType = TType,
+		std::enable_if_t<std::is_copy_constructible_v<TOtherType>, int> = 0
+	>
+	TStaticVector(TInitializerList<TType> init) {
+		pushRange(init.begin(), init.end());
+	}
+
+	template <typename... TArgs,
+		std::enable_if_t<std::conjunction_v<std::is_constructible<TType, TArgs>...>, int> = 0
+	>
+	explicit TStaticVector(TArgs&&... args) {
+		static_assert(sizeof...(TArgs) <= TSize, "Too many elements for the static vector!");
+		(emplace(std::forward<TArgs>(args)), ...);
+	}
+
+	TStaticVector(const TStaticVector& otr) {
+		pushRange(otr.begin(), otr.end());
+	}
+
+	// Elements are stored inline, so they are moved one by one, leaving otr empty
+	// Only noexcept when moving an element cannot throw
+	TStaticVector(TStaticVector&& otr) noexcept(std::is_nothrow_move_constructible_v<TType>) {
+		pushRange(std::make_move_iterator(otr.begin()), std::make_move_iterator(otr.end()));
+		otr.clear();
+	}
+
+	TStaticVector& operator=(const TStaticVector& otr) {
+		if (this != &otr) {
+			clear();
+			pushRange(otr.begin(), otr.end());
+		}
+		return *this;
+	}
+
+	TStaticVector& operator=(TStaticVector&& otr) noexcept(std::is_nothrow_move_constructible_v<TType>) {
+		if (this != &otr) {
+			clear();
+			pushRange(std::make_move_iterator(otr.begin()), std::make_move_iterator(otr.end()));
+			otr.clear();
+		}
+		return *this;
+	}
+
+	~TStaticVector() override {
+		clear();
+	}
+
+	[[nodiscard]] virtual size_t getSize() const override {
+		return m_Size;
+	}
+
+	[[nodiscard]] constexpr size_t getCapacity() const {
+		return TSize;
+	}
+
+	[[nodiscard]] bool isFull() const {
+		return m_Size == TSize;
+	}
+
+	TType* data() { return std::launder(reinterpret_cast<TType*>(m_Storage)); }
+
+	const TType* data() const { return std::launder(reinterpret_cast<const TType*>(m_Storage)); }
+
+	virtual TType& top() override {
+		return data()[0];
+	}
+
+	virtual const TType& top() const override {
+		return data()[0];
+	}
+
+	virtual TType& bottom() override {
+		return data()[m_Size - 1];
+	}
+
+	virtual const TType& bottom() const override {
+		return data()[m_Size - 1];
+	}
+
+	virtual bool contains(const TType& obj) const override {
+		if constexpr (sstl::is_equality_comparable_v<TType>) {
+			return std::find(begin(), end(), obj) != end();
+		} else {
+			throw std::runtime_error("Type is not comparable!");
+		}
+	}
+
+	virtual bool contains(typename TUnfurled<TType>::Type* obj) const override {
+		if constexpr (sstl::is_managed_v<TType>) {
+			// Will compare pointers, is always comparable
+			return findManaged(obj) != end();
+		} else {
+			return contains(*obj);
+		}
+	}
+
+	virtual size_t find(const TType& obj) const override {
+		if constexpr (sstl::is_equality_comparable_v<TType>) {
+			return static_cast<size_t>(std::find(begin(), end(), obj) - begin());
+		} else {
+			throw std::runtime_error("Type is not comparable!");
+		}
+	}
+
+	virtual size_t find(typename TUnfurled<TType>::Type* obj) const override {
+		if constexpr (sstl::is_managed_v<TType>) {
+			// Will compare pointers, is always comparable
+			return static_cast<size_t>(findManaged(obj) - begin());
+		} else {
+			return find(*obj);
+		}
+	}
+
+	virtual TType& get(size_t index) override {
+		return data()[index];
+	}
+
+	virtual const TType& get(size_t index) const override {
+		return data()[index];
+	}
+
+	virtual void resize(size_t amt) override {
+		if constexpr (std::is_default_constructible_v<TType>) {
+			if (amt < m_Size) {
+				popRange(amt, m_Size);
+				return;
+			}
+			reserve(amt);
+			for (; m_Size < amt; ++m_Size) {
+				new (data() + m_Size) TType();
+			}
+		} else {
+			throw std::runtime_error("Type is not default constructible!");
+		}
+	}
+
+	virtual void resize(const size_t amt, std::function<TType(size_t)> func) override {
+		reserve(amt);
+		for (size_t i = m_Size; i < amt; ++i) {
+			emplace(func(i));
+		}
+	}
+
+	// Memory is already there, only checks that amt elements fit
+	virtual void reserve(size_t amt) override {
+		if (amt > TSize) {
+			throw std::runtime_error("Static vector is too small, cannot reserve any more elements.");
+		}
+	}
+
+	virtual TType& push() override {
+		if constexpr (std::is_default_constructible_v<TType>) {
+			return emplace();
+		} else {
+			throw std::runtime_error("Type is not default constructible!");
+		}
+	}
+
+	virtual size_t push(const TType& obj) override {
+		if constexpr (std::is_copy_constructible_v<TType>) {
+			emplace(obj);
+			return m_Size - 1;
+		} else {
+			throw std::runtime_error("Type is not copyable");
+		}
+	}
+
+	virtual size_t push(TType&& obj) override {
+		if constexpr (std::is_move_constructible_v<TType>) {
+			emplace(std::move(obj));
+			return m_Size - 1;
+		} else {
+			throw std::runtime_error("Type is not moveable");
+		}
+	}
+
+	virtual void push(const size_t index, const TType& obj) override {
+		if constexpr (std::is_copy_constructible_v<TType>) {
+			emplaceAt(index, obj);
+		} else {
+			throw std::runtime_error("Type is not copyable!");
+		}
+	}
+
+	virtual void push(const size_t index, TType&& obj) override {
+		if constexpr (std::is_move_constructible_v<TType>) {
+			emplaceAt(index, std::move(obj));
+		} else {
+			throw std::runtime_error("Type is not moveable!");
+		}
+	}
+
+	// Adds every element in [first, last), throws before adding anything if the distance is known and they do not fit
+	template <typename TIterator>
+	void pushRange(TIterator first, TIterator last) {
+		if constexpr (std::is_base_of_v<std::forward_iterator_tag, typename std::iterator_traits<TIterator>::iterator_category>) {
+			reserve(m_Size + static_cast<size_t>(std::distance(first, last)));
+		}
+		for (; first != last; ++first) {
+			emplace(*first);
+		}
+	}
+
+	// Adds every element of another container or range, elements are moved out if it is an rvalue
+	template <typename TRange>
+	void pushRange(TRange&& range) {
+		if constexpr (std::is_rvalue_reference_v<TRange&&>) {
+			pushRange(std::make_move_iterator(range.begin()), std::make_move_iterator(range.end()));
+		} else {
+			pushRange(range.begin(), range.end());
+		}
+	}
+
+	// Constructs an element in place from args at the back in O(1)
+	template <typename... TArgs>
+	TType& emplace(TArgs&&... args) {
+		if (m_Size == TSize) {
+			throw std::runtime_error("Static vector is full, cannot add any more elements.");
+		}
+		TType* obj = new (data() + m_Size) TType(std::forward<TArgs>(args)...);
+		++m_Size;
+		return *obj;
+	}
+
+	// Constructs an element in place at index from args, everything after it is shifted up
+	template <typename... TArgs>
+	TType& emplaceAt(const size_t index, TArgs&&... args) {
+		emplace(std::forward<TArgs>(args)...);
+		std::rotate(data() + index, data() + m_Size - 1, data() + m_Size);
+		return data()[index];
+	}
+
+	virtual void replace(const size_t index, const TType& obj) override {
+		if constexpr (std::is_copy_constructible_v<TType>) {
+			data()[index] = obj;
+		} else {
+			throw std::runtime_error("Type is not copyable!");
+		}
+	}
+
+	virtual void replace(const size_t index, TType&& obj) override {
+		if constexpr (std::is_move_constructible_v<TType>) {
+			data()[index] = std::move(obj);
+		} else {
+			throw std::runtime_error("Type is not moveable!");
+		}
+	}
+
+	virtual void clear() override {
+		std::destroy(data(), data() + m_Size);
+		m_Size = 0;
+	}
+
+	// Removes the top, which is the front, so everything after it is shifted down, use popBack to remove in O(1)
+	virtual void pop() override {
+		pop(static_cast<size_t>(0));
+	}
+
+	// Removes the last element in O(1)
+	virtual void popBack() override {
+		data()[--m_Size].~TType();
+	}
+
+	virtual void pop(const size_t index) override {
+		popRange(index, index + 1);
+	}
+
+	virtual void pop(const TType& obj) override {
+		if constexpr (sstl::is_equality_comparable_v<TType>) {
+			const TType* itr = std::find(begin(), end(), obj);
+			if (itr != end()) pop(static_cast<size_t>(itr - begin()));
+		} else {
+			throw std::runtime_error("Type is not comparable!");
+		}
+	}
+
+	virtual void pop(typename TUnfurled<TType>::Type* obj) override {
+		if constexpr (sstl::is_managed_v<TType>) {
+			// Will compare pointers, is always comparable
+			const TType* itr = findManaged(obj);
+			if (itr != end()) pop(static_cast<size_t>(itr - begin()));
+		} else {
+			pop(*obj);
+		}
+	}
+
+	virtual void popRange(const size_t start, const size_t end) override {
+		std::move(data() + end, data() + m_Size, data() + start);
+		std::destroy(data() + m_Size - (end - start), data() + m_Size);
+		m_Size -= end - start;
+	}
+
+	// Moves the whole range at once if otr is a TStaticVector, derived containers keep their own ordering through transferIn
+	virtual void transferRange(TSequenceContainer<TType>& otr, const size_t start, const size_t end) override {
+		// The elements would be inserted from the range that is being removed, and they are already here anyway
+		if (&otr == this) return;
+		if (auto otrVector = dynamic_cast<TStaticVector*>(&otr)) {
+			otrVector->transferIn(data() + start, data() + end);
+			popRange(start, end);
+			return;
+		}
+		TSequenceContainer<TType>::transferRange(otr, start, end);
+	}
+
+	// Sorts by comp on the calling thread, integers and floats compared with std::less are radix sorted
+	template <typename TCompare = std::less<TType>>
+	void sort(TCompare comp = {}) {
+		sstl::sort(begin(), end(), comp);
+	}
+
+	// Splits large containers across pool, ParallelSort.h has to be included to use it
+	template <typename TCompare>
+	void sort(TCompare comp, TThreadPool& pool) {
+		sstl::sort(begin(), end(), comp, pool);
+	}
+
+	// Like sort, but equal elements keep their order
+	template <typename TCompare = std::less<TType>>
+	void stableSort(TCompare comp = {}) {
+		sstl::stableSort(begin(), end(), comp);
+	}
+
+	template <typename TCompare>
+	void stableSort(TCompare comp, TThreadPool& pool) {
+		sstl::stableSort(begin(), end(), comp, pool);
+	}
+
+	// Sorts only the amt smallest elements into the front, the rest are left in no particular order
+	template <typename TCompare = std::less<TType>>
+	void partialSort(const size_t amt, TCompare comp = {}) {
+		std::partial_sort(begin(), begin() + std::min(amt, m_Size), end(), comp);
+	}
+
+	// Puts the element that belongs at index after sorting there, with nothing after it smaller and nothing before it larger
+	// Does nothing if index is past the end, the same way partialSort clamps amt
+	template <typename TCompare = std::less<TType>>
+	void nthElement(const size_t index, TCompare comp = {}) {
+		std::nth_element(begin(), begin() + std::min(index, m_Size), end(), comp);
+	}
+
+	virtual void forEach(const std::function<void(size_t, TType&)>& func) override {
+		for (size_t i = 0; i < m_Size; ++i) {
+			func(i, data()[i]);
+		}
+	}
+
+	virtual void forEach(const std::function<void(size_t, const TType&)>& func) const override {
+		for (size_t i = 0; i < m_Size; ++i) {
+			func(i, data()[i]);
+		}
+	}
+
+	virtual void forEachReverse(const std::function<void(size_t, TType&)>& func) override {
+		for (size_t i = m_Size; i > 0; --i) {
+			func(i - 1, data()[i - 1]);
+		}
+	}
+
+	virtual void forEachReverse(const std::function<void(size_t, const TType&)>& func) const override {
+		for (size_t i = m_Size; i > 0; --i) {
+			func(i - 1, data()[i - 1]);
+		}
+	}
+
+	// Iterates through each element, accepts any callable so the loop can be inlined
+	template <typename TFunc>
+	void forEach(TFunc&& func) {
+		for (size_t i = 0; i < m_Size; ++i) {
+			func(i, data()[i]);
+		}
+	}
+
+	// Iterates through each element, const version
+	template <typename TFunc>
+	void forEach(TFunc&& func) const {
+		for (size_t i = 0; i < m_Size; ++i) {
+			func(i, data()[i]);
+		}
+	}
+
+	// Iterates through each element in reverse, accepts any callable so the loop can be inlined
+	template <typename TFunc>
+	void forEachReverse(TFunc&& func) {
+		for (size_t i = m_Size; i > 0; --i) {
+			func(i - 1, data()[i - 1]);
+		}
+	}
+
+	// Iterates through each element in reverse, const version
+	template <typename TFunc>
+	void forEachReverse(TFunc&& func) const {
+		for (size_t i = m_Size; i > 0; --i) {
+			func(i - 1, data()[i - 1]);
+		}
+	}
+
+	template <typename TFunc>
+	void doFor(const size_t index, TFunc&& func) {
+		func(data()[index]);
+	}
+
+	template <typename TFunc>
+	void doFor(const size_t index, TFunc&& func) const {
+		func(data()[index]);
+	}
+
+	template <typename TFunc>
+	void doFor(const size_t start, const size_t end, TFunc&& func) {
+		for (size_t i = start; i < end; ++i) {
+			func(i, data()[i]);
+		}
+	}
+
+	template <typename TFunc>
+	void doFor(const size_t start, const size_t end, TFunc&& func) const {
+		for (size_t i = start; i < end; ++i) {
+			func(i, data()[i]);
+		}
+	}
+
+	iterator begin() { return data(); }
+
+	const_iterator begin() const { return data(); }
+
+	iterator end() { return data() + m_Size; }
+
+	const_iterator end() const { return data() + m_Size; }
+
+	const_iterator cbegin() const { return data(); }
+
+	const_iterator cend() const { return data() + m_Size; }
+
+	reverse_iterator rbegin() { return reverse_iterator(end()); }
+
+	const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+
+	reverse_iterator rend() { return reverse_iterator(begin()); }
+
+	const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+	const_reverse_iterator crbegin() const { return const_reverse_iterator(end()); }
+
+	const_reverse_iterator crend() const { return const_reverse_iterator(begin()); }
+
+protected:
+
+	// Takes a run moved out of another TStaticVector, overridden by containers that order their elements themselves
+	virtual void transferIn(iterator first, iterator last) {
+		pushRange(std::make_move_iterator(first), std::make_move_iterator(last));
+	}
+
+	const TType* findManaged(typename TUnfurled<TType>::Type* obj) const {
+		return std::find_if(begin(), end(), [&](const TType& otr) { return std::invoke(TUnfurled<TType>::get, otr) == obj; });
+	}
+
+	alignas(TType) unsigned char m_Storage[TSize * sizeof(TType)];
+
+	size_t m_Size = 0;
+};
+
+template <typename TType, typename... TArgs>
+TStaticVector(TType, TArgs...) -> TStaticVector<typename sstl::EnforceConvertible<TType, TArgs...>::Type, 1 + sizeof...(TArgs)>;
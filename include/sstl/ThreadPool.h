@@ -0,0 +1,240 @@
+﻿#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Deque.h"
+#include "Threading.h"
+#include "WorkStealingDeque.h"
+
+// Fixed number of worker threads, each with its own work stealing deque
+// Tasks submitted from a worker go to the bottom of that worker's deque, so nested work stays on the same core until someone steals it
+// Tasks submitted from any other thread go to a shared queue that every worker takes from
+// Idle workers steal the oldest task of another worker before going to sleep
+class TThreadPool {
+public:
+
+	// Counts the tasks submitted with it that have not finished, so a caller can wait on only its own tasks
+	struct group {
+		group() = default;
+
+		group(const group&) = delete;
+		group& operator=(const group&) = delete;
+
+		[[nodiscard]] bool isDone() const {
+			return m_Remaining.load(std::memory_order_acquire) == 0;
+		}
+
+	private:
+		friend class TThreadPool;
+
+		std::atomic<size_t> m_Remaining = 0;
+		std::mutex m_Mutex;
+		std::exception_ptr m_Error;
+	};
+
+private:
+
+	struct task {
+		std::function<void()> func;
+		group* owner;
+	};
+
+	// Each worker gets its own cache line, so pushing to one deque does not slow down the others
+	struct alignas(64) worker {
+		TWorkStealingDeque<task*> tasks;
+		std::thread thread;
+	};
+
+public:
+
+	explicit TThreadPool(const size_t threadCount = std::max(1u, std::thread::hardware_concurrency())) {
+		m_Workers.reserve(threadCount);
+		for (size_t i = 0; i < threadCount; ++i) {
+			m_Workers.push_back(std::make_unique<worker>());
+		}
+		// Every deque must exist before any worker tries to steal from it
+		for (size_t i = 0; i < threadCount; ++i) {
+			m_Workers[i]->thread = std::thread([this, i] { run(i); });
+		}
+	}
+
+	// Workers hold a pointer to the pool, so it cannot be copied or moved
+	TThreadPool(const TThreadPool&) = delete;
+	TThreadPool& operator=(const TThreadPool&) = delete;
+
+	// Runs every task still queued, then stops the workers
+	// An exception left by a task without a group is dropped, since throwing here would terminate, call wait() first to see it
+	~TThreadPool() {
+		helpWhile([&] { return m_Pending.load(std::memory_order_acquire) > 0; });
+		m_Error = nullptr;
+		{
+			std::lock_guard lock(m_Mutex);
+			m_Stopping = true;
+		}
+		m_Wake.notify_all();
+		for (const std::unique_ptr<worker>& cur : m_Workers) {
+			cur->thread.join();
+		}
+	}
+
+	[[nodiscard]] size_t getThreadCount() const {
+		return m_Workers.size();
+	}
+
+	// Gets the index of the worker running the calling thread, or getThreadCount() if it is not one of this pool's workers
+	[[nodiscard]] size_t getWorkerIndex() const {
+		return t_Pool == this ? t_Index : getThreadCount();
+	}
+
+	// Queues func to run on a worker
+	template <typename TFunc>
+	void submit(TFunc&& func) {
+		enqueue(new task{std::forward<TFunc>(func), nullptr});
+	}
+
+	// Queues func to run on a worker, counted by owner until it finishes
+	template <typename TFunc>
+	void submit(TFunc&& func, group& owner) {
+		owner.m_Remaining.fetch_add(1, std::memory_order_relaxed);
+		enqueue(new task{std::forward<TFunc>(func), &owner});
+	}
+
+	// Waits for every submitted task to finish, running tasks on the calling thread meanwhile
+	// A task is still pending while it runs, so this must not be called from inside a task, wait on a group instead
+	// If any task without a group threw, the first exception is rethrown here
+	void wait() {
+		helpWhile([&] { return m_Pending.load(std::memory_order_acquire) > 0; });
+		std::exception_ptr error;
+		{
+			std::lock_guard lock(m_Mutex);
+			std::swap(error, m_Error);
+		}
+		if (error) std::rethrow_exception(error);
+	}
+
+	// Waits for every task submitted with owner to finish, running tasks on the calling thread meanwhile
+	// Safe to call from inside a task, which is how a task waits on work it submitted itself
+	// If any of them threw, the first exception is rethrown here
+	void wait(group& owner) {
+		helpWhile([&] { return !owner.isDone(); });
+		std::exception_ptr error;
+		{
+			std::lock_guard lock(owner.m_Mutex);
+			std::swap(error, owner.m_Error);
+		}
+		if (error) std::rethrow_exception(error);
+	}
+
+	// The pool shared by the parallel algorithms, with one worker per core
+	static TThreadPool& get() {
+		static TThreadPool pool;
+		return pool;
+	}
+
+protected:
+
+	void enqueue(task* cur) {
+		m_Pending.fetch_add(1, std::memory_order_relaxed);
+		// Counted before it is visible, so the count never drops below zero when a worker takes it right away
+		m_Queued.fetch_add(1, std::memory_order_seq_cst);
+		if (t_Pool == this) {
+			m_Workers[t_Index]->tasks.push(cur);
+		} else {
+			std::lock_guard lock(m_Mutex);
+			m_Shared.push(cur);
+		}
+		// Only pay for the lock when a worker might be asleep
+		if (m_Sleeping.load(std::memory_order_seq_cst) > 0) {
+			{ std::lock_guard lock(m_Mutex); }
+			m_Wake.notify_one();
+		}
+	}
+
+	template <typename TFunc>
+	void helpWhile(TFunc&& busy) {
+		for (uint32_t spins = 0; busy();) {
+			if (runOne(getWorkerIndex())) {
+				spins = 0;
+			} else if (spins++ < 64) {
+				sstl::cpuRelax();
+			} else {
+				std::this_thread::yield();
+			}
+		}
+	}
+
+	// Own deque first, then the shared queue, then the other workers starting from the next one along
+	task* take(const size_t index) {
+		task* cur = nullptr;
+		if (index < getThreadCount() && m_Workers[index]->tasks.pop(cur)) return cur;
+		if (m_Queued.load(std::memory_order_relaxed) == 0) return nullptr;
+		{
+			std::lock_guard lock(m_Mutex);
+			if (m_Shared.getSize() > 0) {
+				cur = m_Shared.top();
+				m_Shared.pop();
+				return cur;
+			}
+		}
+		for (size_t i = 1; i <= getThreadCount(); ++i) {
+			if (m_Workers[(index + i) % getThreadCount()]->tasks.steal(cur)) return cur;
+		}
+		return nullptr;
+	}
+
+	bool runOne(const size_t index) {
+		task* cur = take(index);
+		if (!cur) return false;
+		m_Queued.fetch_sub(1, std::memory_order_relaxed);
+		try {
+			cur->func();
+		} catch (...) {
+			std::lock_guard lock(cur->owner ? cur->owner->m_Mutex : m_Mutex);
+			std::exception_ptr& error = cur->owner ? cur->owner->m_Error : m_Error;
+			if (!error) error = std::current_exception();
+		}
+		group* owner = cur->owner;
+		delete cur;
+		if (owner) owner->m_Remaining.fetch_sub(1, std::memory_order_release);
+		m_Pending.fetch_sub(1, std::memory_order_release);
+		return true;
+	}
+
+	void run(const size_t index) {
+		t_Pool = this;
+		t_Index = index;
+		while (true) {
+			if (runOne(index)) continue;
+			std::unique_lock lock(m_Mutex);
+			m_Sleeping.fetch_add(1, std::memory_order_seq_cst);
+			m_Wake.wait(lock, [&] { return m_Stopping || m_Queued.load(std::memory_order_seq_cst) > 0; });
+			m_Sleeping.fetch_sub(1, std::memory_order_relaxed);
+			if (m_Stopping && m_Queued.load(std::memory_order_relaxed) == 0) return;
+		}
+	}
+
+	inline static thread_local TThreadPool* t_Pool = nullptr;
+	inline static thread_local size_t t_Index = 0;
+
+	std::vector<std::unique_ptr<worker>> m_Workers;
+
+	// Guards the shared queue, the first exception and sleeping
+	std::mutex m_Mutex;
+	std::condition_variable m_Wake;
+	TDeque<task*> m_Shared;
+	std::exception_ptr m_Error;
+	bool m_Stopping = false;
+
+	// Tasks submitted but not finished, and tasks submitted but not taken by any thread
+	std::atomic<size_t> m_Pending = 0;
+	std::atomic<size_t> m_Queued = 0;
+	std::atomic<size_t> m_Sleeping = 0;
+};
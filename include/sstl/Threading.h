@@ -1,19 +1,137 @@
 ﻿#pragma once
 
+#include <atomic>
+#include <cstdint>
+#include <cstring>
 #include <mutex>
+#include <shared_mutex>
+#include <thread>
 #include <functional>
 
 #include "Memory.h"
 
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace sstl {
+
+	// Tells the cpu this thread is spinning, so it can give its resources to the other hyperthread
+	inline void cpuRelax() noexcept {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+		_mm_pause();
+#elif defined(__SSE2__)
+		_mm_pause();
+#elif defined(__aarch64__)
+		asm volatile("yield");
+#endif
+	}
+
+	// Lock that never puts the thread to sleep, only worth it when the lock is held for a handful of instructions
+	// Spins on a plain load so waiting threads do not fight over the cache line, and yields if the wait gets long
+	struct spin_lock {
+
+		void lock() noexcept {
+			for (uint32_t spins = 0; !try_lock(); ++spins) {
+				while (m_Locked.load(std::memory_order_relaxed)) {
+					if (spins < 64) {
+						cpuRelax();
+					} else {
+						std::this_thread::yield();
+					}
+				}
+			}
+		}
+
+		bool try_lock() noexcept {
+			return !m_Locked.exchange(true, std::memory_order_acquire);
+		}
+
+		void unlock() noexcept {
+			m_Locked.store(false, std::memory_order_release);
+		}
+
+	private:
+
+		std::atomic<bool> m_Locked = false;
+	};
+
+	// Writers lock a spin_lock and bump a sequence number before and after, readers never lock at all
+	// A reader copies the object and retries if the sequence was odd or changed, so only trivially copyable types can be read this way
+	struct seq_lock {
+
+		void lock() noexcept {
+			m_Lock.lock();
+			m_Sequence.fetch_add(1, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_release);
+		}
+
+		bool try_lock() noexcept {
+			if (!m_Lock.try_lock()) return false;
+			m_Sequence.fetch_add(1, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_release);
+			return true;
+		}
+
+		void unlock() noexcept {
+			m_Sequence.fetch_add(1, std::memory_order_release);
+			m_Lock.unlock();
+		}
+
+		// Copies obj without blocking writers, obj must only be written while this is locked
+		template <typename TType>
+		TType read(const TType& obj) const noexcept {
+			static_assert(std::is_trivially_copyable_v<TType>, "Only trivially copyable types can be read without a lock!");
+			TType out;
+			while (true) {
+				const size_t sequence = m_Sequence.load(std::memory_order_acquire);
+				if (sequence % 2 == 0) {
+					std::memcpy(&out, &obj, sizeof(TType));
+					std::atomic_thread_fence(std::memory_order_acquire);
+					if (m_Sequence.load(std::memory_order_relaxed) == sequence) return out;
+				}
+				cpuRelax();
+			}
+		}
+
+	private:
+
+		spin_lock m_Lock;
+
+		// Odd while a writer holds the lock
+		std::atomic<size_t> m_Sequence = 0;
+	};
+
+	// If the mutex can be locked by many readers at once, like std::shared_mutex
+	template <typename TMutex, typename = void>
+	struct is_shared_lockable : std::false_type {};
+
+	template <typename TMutex>
+	struct is_shared_lockable<TMutex,
+		std::void_t<decltype(std::declval<TMutex&>().lock_shared()), decltype(std::declval<TMutex&>().unlock_shared())>
+	> : std::true_type {};
+
+	template <typename TMutex>
+	constexpr bool is_shared_lockable_v = is_shared_lockable<TMutex>::value;
+}
+
 // Thanks to Jonathan Wakely on Stack Exchange.
 // https://stackoverflow.com/questions/16859519/how-to-wrap-calls-of-every-member-function-of-a-class-in-c11
-template <typename TType>
+// TMutex picks how access is locked:
+// std::recursive_mutex lets a thread re-enter through operator-> while it already holds the lock
+// std::mutex is cheaper, but a thread must not use operator-> again while it holds the lock
+// std::shared_mutex lets any number of threads use the const operator-> at once, the non-const one is still exclusive
+// sstl::spin_lock never sleeps, for very short operations with little contention
+// sstl::seq_lock lets read() copy a trivially copyable object without locking, writers lock as usual
+template <typename TType, typename TMutex = std::recursive_mutex>
 class TThreadSafe {
-	template<typename TParent, typename TMutex>
-	struct safe_lock : std::lock_guard<TMutex> {
+	template<typename TParent, typename TLock>
+	struct safe_lock : TLock {
 
 		explicit safe_lock(TParent* parent, TMutex& mtx) noexcept(false)
-		: std::lock_guard<TMutex>(mtx),
+		: TLock(mtx),
 		  parent(parent) {}
 
 		decltype(auto) operator->() const noexcept { return parent; }
@@ -21,6 +139,10 @@ class TThreadSafe {
 		TParent* parent;
 	};
 
+	// Readers share the lock if the mutex allows it
+	using read_lock = std::conditional_t<sstl::is_shared_lockable_v<TMutex>, std::shared_lock<TMutex>, std::lock_guard<TMutex>>;
+	using write_lock = std::lock_guard<TMutex>;
+
 public:
 
 	/*
@@ -51,7 +173,7 @@ public:
 	template <typename TOtherType = TType,
 		std::enable_if_t<std::is_convertible_v<TOtherType*, TType*>, int> = 0
 	>
-	TThreadSafe(const TThreadSafe<TOtherType>& otr) noexcept
+	TThreadSafe(const TThreadSafe<TOtherType, TMutex>& otr) noexcept
 	: TThreadSafe(otr.m_obj) {}
 
 	TThreadSafe(const TThreadSafe& otr) noexcept
@@ -60,7 +182,7 @@ public:
 	template <typename TOtherType = TType,
 		std::enable_if_t<std::is_convertible_v<TOtherType*, TType*>, int> = 0
 	>
-	TThreadSafe(TThreadSafe<TOtherType>& otr)
+	TThreadSafe(TThreadSafe<TOtherType, TMutex>& otr)
 #if CXX_VERSION >= 20
 	noexcept(std::is_nothrow_convertible_v<TOtherType*, TType*>)
 #else
@@ -74,7 +196,7 @@ public:
 	template <typename TOtherType = TType,
 		std::enable_if_t<std::is_convertible_v<TOtherType*, TType*>, int> = 0
 	>
-	TThreadSafe(TThreadSafe<TOtherType>&& otr)
+	TThreadSafe(TThreadSafe<TOtherType, TMutex>&& otr)
 #if CXX_VERSION >= 20
 	noexcept(std::is_nothrow_convertible_v<TOtherType*, TType*>)
 #else
@@ -88,7 +210,7 @@ public:
 	template <typename TOtherType = TType,
 		std::enable_if_t<std::is_convertible_v<TOtherType*, TType*>, int> = 0
 	>
-	TThreadSafe& operator=(const TThreadSafe<TOtherType>& otr)
+	TThreadSafe& operator=(const TThreadSafe<TOtherType, TMutex>& otr)
 #if CXX_VERSION >= 20
 	noexcept(std::is_nothrow_convertible_v<TOtherType*, TType*>) {
 #else
@@ -106,7 +228,7 @@ public:
 	template <typename TOtherType = TType,
 		std::enable_if_t<std::is_convertible_v<TOtherType*, TType*>, int> = 0
 	>
-	TThreadSafe& operator=(TThreadSafe<TOtherType>& otr)
+	TThreadSafe& operator=(TThreadSafe<TOtherType, TMutex>& otr)
 #if CXX_VERSION >= 20
 	noexcept(std::is_nothrow_convertible_v<TOtherType*, TType*>) {
 #else
@@ -124,7 +246,7 @@ public:
 	template <typename TOtherType = TType,
 		std::enable_if_t<std::is_convertible_v<TOtherType*, TType*>, int> = 0
 	>
-	TThreadSafe& operator=(TThreadSafe<TOtherType>&& otr)
+	TThreadSafe& operator=(TThreadSafe<TOtherType, TMutex>&& otr)
 #if CXX_VERSION >= 20
 	noexcept(std::is_nothrow_convertible_v<TOtherType*, TType*>) {
 #else
@@ -140,23 +262,38 @@ public:
 	}
 
 	void lockFor(const std::function<void(TType&)>& func) noexcept(false) {
-		std::lock_guard lock(mtx);
+		write_lock lock(mtx);
+		func(m_obj);
+	}
+
+	void lockFor(const std::function<void(const TType&)>& func) const noexcept(false) {
+		read_lock lock(mtx);
 		func(m_obj);
 	}
 
+	// Gets a copy of the object, with sstl::seq_lock this never waits on other readers or blocks writers
+	TType read() const noexcept(false) {
+		if constexpr (std::is_same_v<TMutex, sstl::seq_lock>) {
+			return mtx.read(m_obj);
+		} else {
+			read_lock lock(mtx);
+			return m_obj;
+		}
+	}
+
 	decltype(auto) operator->() noexcept(false) {
 		if constexpr (TUnfurled<std::remove_reference_t<TType>>::isManaged) {
-			return safe_lock(m_obj.get(), mtx);
+			return safe_lock<std::remove_pointer_t<decltype(m_obj.get())>, write_lock>(m_obj.get(), mtx);
 		} else {
-			return safe_lock(&m_obj, mtx);
+			return safe_lock<TType, write_lock>(&m_obj, mtx);
 		}
 	}
 
 	decltype(auto) operator->() const noexcept(false) {
 		if constexpr (TUnfurled<std::remove_reference_t<TType>>::isManaged) {
-			return safe_lock(m_obj.get(), mtx);
+			return safe_lock<std::remove_pointer_t<decltype(m_obj.get())>, read_lock>(m_obj.get(), mtx);
 		} else {
-			return safe_lock(&m_obj, mtx);
+			return safe_lock<const TType, read_lock>(&m_obj, mtx);
 		}
 	}
 
@@ -189,10 +326,10 @@ public:
 	}
 
 private:
-	template <typename>
+	template <typename, typename>
 	friend class TThreadSafe;
 
 	TType m_obj;
 
-	mutable std::recursive_mutex mtx;
+	mutable TMutex mtx;
 };
\ No newline at end of file
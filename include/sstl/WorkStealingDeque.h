@@ -0,0 +1,128 @@
+﻿#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+// Chase-Lev deque, one owner thread pushes and pops at the bottom while any other thread can steal from the top
+// The owner works newest first so its data stays in cache, and thieves take the oldest work, which is usually the largest
+// A thief can read a slot while the owner overwrites it, so only trivially copyable types can be stored, such as pointers to tasks
+// The ring grows when full, old rings are kept until the deque is destroyed since a thief may still be reading one
+template <typename TType>
+struct TWorkStealingDeque {
+
+	static_assert(std::is_trivially_copyable_v<TType>, "Only trivially copyable types can be stolen!");
+
+	explicit TWorkStealingDeque(const size_t capacity = 64) {
+		size_t rounded = 2;
+		while (rounded < capacity) rounded <<= 1;
+		m_Rings.push_back(std::make_unique<ring>(rounded));
+		m_Ring.store(m_Rings.back().get(), std::memory_order_relaxed);
+	}
+
+	// Thieves hold pointers into the ring, so it cannot be copied or moved
+	TWorkStealingDeque(const TWorkStealingDeque&) = delete;
+	TWorkStealingDeque& operator=(const TWorkStealingDeque&) = delete;
+
+	// Only exact while no other thread is using the deque
+	[[nodiscard]] size_t getSize() const {
+		const int64_t bottom = m_Bottom.load(std::memory_order_relaxed);
+		const int64_t top = m_Top.load(std::memory_order_relaxed);
+		return bottom > top ? static_cast<size_t>(bottom - top) : 0;
+	}
+
+	[[nodiscard]] size_t getCapacity() const {
+		return m_Ring.load(std::memory_order_relaxed)->capacity();
+	}
+
+	// Owner only, adds obj at the bottom, growing the ring if it is full
+	void push(const TType obj) {
+		const int64_t bottom = m_Bottom.load(std::memory_order_relaxed);
+		const int64_t top = m_Top.load(std::memory_order_acquire);
+		ring* cur = m_Ring.load(std::memory_order_relaxed);
+		if (bottom - top > static_cast<int64_t>(cur->capacity()) - 1) {
+			cur = grow(cur, bottom, top);
+		}
+		cur->put(bottom, obj);
+		m_Bottom.store(bottom + 1, std::memory_order_release);
+	}
+
+	// Owner only, takes the newest element, returns false if the deque is empty
+	bool pop(TType& out) {
+		const int64_t bottom = m_Bottom.load(std::memory_order_relaxed) - 1;
+		ring* cur = m_Ring.load(std::memory_order_relaxed);
+		m_Bottom.store(bottom, std::memory_order_relaxed);
+		// Thieves must see the smaller bottom before the owner reads top, or both could take the last element
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		int64_t top = m_Top.load(std::memory_order_relaxed);
+		if (top > bottom) {
+			m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+			return false;
+		}
+		out = cur->get(bottom);
+		if (top == bottom) {
+			// Last element, race the thieves for it
+			const bool won = m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+			m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+			return won;
+		}
+		return true;
+	}
+
+	// Any thread, takes the oldest element, returns false if the deque is empty or another thread took it first
+	bool steal(TType& out) {
+		int64_t top = m_Top.load(std::memory_order_acquire);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		const int64_t bottom = m_Bottom.load(std::memory_order_acquire);
+		if (top >= bottom) return false;
+		const TType obj = m_Ring.load(std::memory_order_acquire)->get(top);
+		if (!m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) return false;
+		out = obj;
+		return true;
+	}
+
+protected:
+
+	struct ring {
+
+		explicit ring(const size_t capacity)
+		: m_Mask(capacity - 1),
+		  m_Slots(new std::atomic<TType>[capacity]) {}
+
+		[[nodiscard]] size_t capacity() const { return m_Mask + 1; }
+
+		void put(const int64_t index, const TType obj) {
+			m_Slots[static_cast<size_t>(index) & m_Mask].store(obj, std::memory_order_relaxed);
+		}
+
+		TType get(const int64_t index) const {
+			return m_Slots[static_cast<size_t>(index) & m_Mask].load(std::memory_order_relaxed);
+		}
+
+	private:
+
+		const size_t m_Mask;
+
+		std::unique_ptr<std::atomic<TType>[]> m_Slots;
+	};
+
+	ring* grow(const ring* old, const int64_t bottom, const int64_t top) {
+		m_Rings.push_back(std::make_unique<ring>(old->capacity() * 2));
+		ring* cur = m_Rings.back().get();
+		for (int64_t i = top; i < bottom; ++i) {
+			cur->put(i, old->get(i));
+		}
+		m_Ring.store(cur, std::memory_order_release);
+		return cur;
+	}
+
+	// Each end gets its own cache line, so the owner moving the bottom does not slow down thieves moving the top
+	alignas(64) std::atomic<int64_t> m_Top = 0;
+	alignas(64) std::atomic<int64_t> m_Bottom = 0;
+	alignas(64) std::atomic<ring*> m_Ring = nullptr;
+
+	// Only touched by the owner
+	std::vector<std::unique_ptr<ring>> m_Rings;
+};
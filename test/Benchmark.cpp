@@ -0,0 +1,1145 @@
+﻿#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "sstl/Allocator.h"
+#include "sstl/Array.h"
+#include "sstl/BTreeSet.h"
+#include "sstl/ConcurrentMap.h"
+#include "sstl/ConcurrentSet.h"
+#include "sstl/ConcurrentQueue.h"
+#include "sstl/Deque.h"
+#include "sstl/FlatMap.h"
+#include "sstl/FlatSet.h"
+#include "sstl/List.h"
+#include "sstl/Map.h"
+#include "sstl/Parallel.h"
+#include "sstl/ParallelSort.h"
+#include "sstl/MinHeap.h"
+#include "sstl/PriorityMap.h"
+#include "sstl/PrioritySet.h"
+#include "sstl/Queue.h"
+#include "sstl/RingBuffer.h"
+#include "sstl/Set.h"
+#include "sstl/SmallVector.h"
+#include "sstl/StaticVector.h"
+#include "sstl/ThreadPool.h"
+#include "sstl/Threading.h"
+#include "sstl/Vector.h"
+
+#include "TestShared.h"
+
+#if defined(_MSC_VER)
+#define NOINLINE __declspec(noinline)
+#else
+#define NOINLINE __attribute__((noinline))
+#endif
+
+// Keeps the optimizer from throwing away results
+static volatile size_t g_Sink = 0;
+
+template <typename TFunc>
+double timeMs(TFunc&& func) {
+	const auto start = std::chrono::steady_clock::now();
+	func();
+	const auto end = std::chrono::steady_clock::now();
+	return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+void report(const char* name, const double ms) {
+	std::cout << "  " << name << ": " << ms << " ms" << std::endl;
+}
+
+/*
+ * Static vs Virtual Dispatch
+ */
+
+// Taking the base prevents the compiler from knowing the dynamic type, so every get is a virtual call
+NOINLINE size_t sumVirtual(const TSequenceContainer<int>& container) {
+	size_t sum = 0;
+	for (size_t i = 0; i < container.getSize(); ++i) {
+		sum += container.get(i);
+	}
+	return sum;
+}
+
+// TVector is not final, so this still goes through the virtual table
+NOINLINE size_t sumConcrete(const TVector<int>& container) {
+	size_t sum = 0;
+	for (size_t i = 0; i < container.getSize(); ++i) {
+		sum += container.get(i);
+	}
+	return sum;
+}
+
+// TStatic is final, so get resolves to TVector::get and is inlined into the loop
+NOINLINE size_t sumStatic(const TStatic<TVector<int>>& container) {
+	size_t sum = 0;
+	for (size_t i = 0; i < container.getSize(); ++i) {
+		sum += container.get(i);
+	}
+	return sum;
+}
+
+void dispatchBenchmark() {
+	// Small enough to stay in cache, so the dispatch cost is what gets measured
+	constexpr size_t size = 100'000;
+	constexpr size_t iterations = 1'000;
+
+	TStatic<TVector<int>> container;
+	container.resize(size, [](const size_t index) { return static_cast<int>(index); });
+
+	report("TSequenceContainer<int>::get", timeMs([&] {
+		for (size_t i = 0; i < iterations; ++i) g_Sink = g_Sink + sumVirtual(container);
+	}));
+	report("TVector<int>::get", timeMs([&] {
+		for (size_t i = 0; i < iterations; ++i) g_Sink = g_Sink + sumConcrete(container);
+	}));
+	report("TStatic<TVector<int>>::get", timeMs([&] {
+		for (size_t i = 0; i < iterations; ++i) g_Sink = g_Sink + sumStatic(container);
+	}));
+}
+
+/*
+ * Templated vs std::function Iteration
+ */
+
+void forEachBenchmark() {
+	constexpr size_t size = 100'000;
+	constexpr size_t iterations = 1'000;
+
+	TVector<int> container;
+	container.resize(size, [](const size_t index) { return static_cast<int>(index); });
+	const TSequenceContainer<int>& view = container;
+
+	report("TSequenceContainer<int>::forEach", timeMs([&] {
+		for (size_t i = 0; i < iterations; ++i) {
+			size_t sum = 0;
+			view.forEach([&](size_t, const int& obj) { sum += obj; });
+			g_Sink = g_Sink + sum;
+		}
+	}));
+	report("TVector<int>::forEach", timeMs([&] {
+		for (size_t i = 0; i < iterations; ++i) {
+			size_t sum = 0;
+			container.forEach([&](size_t, const int& obj) { sum += obj; });
+			g_Sink = g_Sink + sum;
+		}
+	}));
+}
+
+/*
+ * Heap Drain
+ */
+
+// Pops every element off a heap, if pop is O(log n) the time divided by n log n stays flat as n grows
+void heapDrainBenchmark() {
+	for (const size_t size : {250'000, 500'000, 1'000'000}) {
+		std::mt19937 random(size);
+		TMinHeap<int> heap;
+		heap.reserve(size);
+		for (size_t i = 0; i < size; ++i) {
+			heap.push(static_cast<int>(random()));
+		}
+
+		int previous = heap.top();
+		bool isSorted = true;
+		const double ms = timeMs([&] {
+			while (heap.getSize() > 0) {
+				isSorted &= previous <= heap.top();
+				previous = heap.top();
+				heap.pop();
+			}
+		});
+		g_Sink = g_Sink + isSorted;
+
+		std::cout << "  TMinHeap<int>::pop x " << size << ": " << ms << " ms, "
+			<< ms * 1'000'000.0 / (size * std::log2(size)) << " ns per n log n"
+			<< (isSorted ? "" : ", NOT SORTED") << std::endl;
+	}
+}
+
+/*
+ * Node vs Flat Hash Lookup
+ */
+
+template <typename TContainer>
+NOINLINE size_t countContained(const TContainer& container, const TVector<int>& keys) {
+	size_t count = 0;
+	for (const int key : keys) {
+		count += container.contains(key);
+	}
+	return count;
+}
+
+template <typename TContainer>
+NOINLINE size_t sumValues(const TContainer& container, const TVector<int>& keys) {
+	size_t sum = 0;
+	for (const int key : keys) {
+		sum += container.get(key);
+	}
+	return sum;
+}
+
+void hashLookupBenchmark() {
+	constexpr size_t size = 1'000'000;
+	constexpr size_t iterations = 10;
+
+	std::mt19937 random(1);
+	TStatic<TSet<int>> set;
+	TStatic<TFlatSet<int>> flatSet;
+	TStatic<TMap<int, int>> map;
+	TStatic<TFlatMap<int, int>> flatMap;
+	TVector<int> keys;
+	keys.reserve(size);
+	for (size_t i = 0; i < size; ++i) {
+		const int key = static_cast<int>(random());
+		set.push(key);
+		flatSet.push(key);
+		map.push(key, static_cast<int>(i));
+		flatMap.push(key, static_cast<int>(i));
+		keys.push(key);
+	}
+
+	// Half of the lookups miss
+	TVector<int> mixedKeys = keys;
+	for (size_t i = 0; i < size; i += 2) {
+		mixedKeys.get(i) = static_cast<int>(random());
+	}
+
+	report("TSet<int>::contains", timeMs([&] {
+		for (size_t i = 0; i < iterations; ++i) g_Sink = g_Sink + countContained(set, mixedKeys);
+	}));
+	report("TFlatSet<int>::contains", timeMs([&] {
+		for (size_t i = 0; i < iterations; ++i) g_Sink = g_Sink + countContained(flatSet, mixedKeys);
+	}));
+	report("TMap<int, int>::get", timeMs([&] {
+		for (size_t i = 0; i < iterations; ++i) g_Sink = g_Sink + sumValues(map, keys);
+	}));
+	report("TFlatMap<int, int>::get", timeMs([&] {
+		for (size_t i = 0; i < iterations; ++i) g_Sink = g_Sink + sumValues(flatMap, keys);
+	}));
+}
+
+/*
+ * Red-Black Tree vs B-Tree
+ */
+
+template <typename TContainer>
+NOINLINE size_t sumInOrder(const TContainer& container) {
+	size_t sum = 0;
+	container.forEach([&](const int& key) { sum += static_cast<unsigned>(key); });
+	return sum;
+}
+
+template <typename TContainer>
+NOINLINE size_t countInRanges(const TContainer& container, const TVector<int>& starts, const int width) {
+	size_t count = 0;
+	for (const int start : starts) {
+		container.forEachInRange(start, start + width, [&](const int&) { ++count; });
+	}
+	return count;
+}
+
+void orderedBenchmark() {
+	constexpr size_t size = 1'000'000;
+	constexpr size_t iterations = 10;
+
+	std::mt19937 random(1);
+	TVector<int> keys;
+	keys.reserve(size);
+	for (size_t i = 0; i < size; ++i) {
+		keys.push(static_cast<int>(random() >> 1));
+	}
+
+	// Half of the lookups miss
+	TVector<int> mixedKeys = keys;
+	for (size_t i = 0; i < size; i += 2) {
+		mixedKeys.get(i) = static_cast<int>(random() >> 1);
+	}
+
+	// Windows of about 100 keys each, starting low enough that start + width cannot overflow
+	TVector<int> starts;
+	for (size_t i = 0; i < 10'000; ++i) {
+		starts.push(static_cast<int>(random() >> 2));
+	}
+	constexpr int width = 214'748;
+
+	TStatic<TPrioritySet<int>> set;
+	TStatic<TBTreeSet<int>> tree;
+	report("TPrioritySet<int>::push", timeMs([&] {
+		for (const int key : keys) set.push(key);
+	}));
+	report("TBTreeSet<int>::push", timeMs([&] {
+		for (const int key : keys) tree.push(key);
+	}));
+	report("TPrioritySet<int>::contains", timeMs([&] {
+		for (size_t i = 0; i < iterations; ++i) g_Sink = g_Sink + countContained(set, mixedKeys);
+	}));
+	report("TBTreeSet<int>::contains", timeMs([&] {
+		for (size_t i = 0; i < iterations; ++i) g_Sink = g_Sink + countContained(tree, mixedKeys);
+	}));
+	report("TPrioritySet<int>::forEach", timeMs([&] {
+		for (size_t i = 0; i < iterations; ++i) g_Sink = g_Sink + sumInOrder(set);
+	}));
+	report("TBTreeSet<int>::forEach", timeMs([&] {
+		for (size_t i = 0; i < iterations; ++i) g_Sink = g_Sink + sumInOrder(tree);
+	}));
+	report("TPrioritySet<int>::forEachInRange", timeMs([&] {
+		for (size_t i = 0; i < iterations; ++i) g_Sink = g_Sink + countInRanges(set, starts, width);
+	}));
+	report("TBTreeSet<int>::forEachInRange", timeMs([&] {
+		for (size_t i = 0; i < iterations; ++i) g_Sink = g_Sink + countInRanges(tree, starts, width);
+	}));
+}
+
+/*
+ * Single Lock vs Sharded Concurrent Map
+ */
+
+// Runs func(thread) on threadCount threads at once and times all of them
+template <typename TFunc>
+double timeThreadsMs(const size_t threadCount, TFunc&& func) {
+	return timeMs([&] {
+		std::vector<std::thread> threads;
+		for (size_t t = 0; t < threadCount; ++t) {
+			threads.emplace_back([&, t] { func(t); });
+		}
+		for (std::thread& thread : threads) {
+			thread.join();
+		}
+	});
+}
+
+void concurrentBenchmark() {
+	constexpr int size = 100'000;
+	constexpr size_t operations = 1'000'000;
+	const size_t threadCount = std::max<size_t>(2, std::thread::hardware_concurrency());
+	std::cout << "  " << threadCount << " threads, " << operations << " operations each, 1 in 10 a push or pop" << std::endl;
+
+	TThreadSafe<TMap<int, int>> safeMap;
+	TConcurrentMap<int, int> concurrentMap;
+	for (int i = 0; i < size; ++i) {
+		safeMap->push(i, i);
+		concurrentMap.push(i, i);
+	}
+
+	report("TThreadSafe<TMap<int, int>>", timeThreadsMs(threadCount, [&](const size_t t) {
+		std::mt19937 random(static_cast<unsigned>(t));
+		size_t count = 0;
+		for (size_t i = 0; i < operations; ++i) {
+			const int key = static_cast<int>(random() % size);
+			if (i % 10 == 0) {
+				if (!safeMap->contains(key)) safeMap->push(key, key);
+				else safeMap->pop(key);
+			} else {
+				count += safeMap->contains(key);
+			}
+		}
+		g_Sink = g_Sink + count;
+	}));
+	report("TConcurrentMap<int, int>", timeThreadsMs(threadCount, [&](const size_t t) {
+		std::mt19937 random(static_cast<unsigned>(t));
+		size_t count = 0;
+		for (size_t i = 0; i < operations; ++i) {
+			const int key = static_cast<int>(random() % size);
+			if (i % 10 == 0) {
+				if (!concurrentMap.push(key, key)) concurrentMap.pop(key);
+			} else {
+				count += concurrentMap.contains(key);
+			}
+		}
+		g_Sink = g_Sink + count;
+	}));
+}
+
+/*
+ * TThreadSafe Lock Modes
+ */
+
+// Readers sum a few elements through the const operator->, writers change one through the non-const one
+template <typename TMutex>
+double lockModeMs(const size_t readers, const size_t writers, const size_t operations) {
+	TThreadSafe<TVector<int>, TMutex> safe;
+	safe->resize(64, [](const size_t index) { return static_cast<int>(index); });
+	const TThreadSafe<TVector<int>, TMutex>& view = safe;
+	return timeThreadsMs(readers + writers, [&](const size_t t) {
+		size_t sum = 0;
+		for (size_t i = 0; i < operations; ++i) {
+			if (t < readers) {
+				sum += view->get(i % 64) + view->get((i + 32) % 64);
+			} else {
+				safe->get(i % 64) += 1;
+			}
+		}
+		g_Sink = g_Sink + sum;
+	});
+}
+
+// Same workload on a trivially copyable payload, so the seq_lock readers can copy it out without locking
+template <typename TMutex>
+double lockModeCopyMs(const size_t readers, const size_t writers, const size_t operations) {
+	TThreadSafe<std::array<int, 64>, TMutex> safe;
+	safe.lockFor([](std::array<int, 64>& obj) { obj.fill(0); });
+	return timeThreadsMs(readers + writers, [&](const size_t t) {
+		size_t sum = 0;
+		for (size_t i = 0; i < operations; ++i) {
+			if (t < readers) {
+				const std::array<int, 64> copy = safe.read();
+				sum += copy[i % 64] + copy[(i + 32) % 64];
+			} else {
+				safe.lockFor([&](std::array<int, 64>& obj) { obj[i % 64] += 1; });
+			}
+		}
+		g_Sink = g_Sink + sum;
+	});
+}
+
+void lockModeBenchmark() {
+	constexpr size_t operations = 200'000;
+	constexpr size_t matrix[][2] = {{1, 0}, {4, 0}, {4, 1}, {1, 1}, {1, 4}};
+
+	for (const auto& [readers, writers] : matrix) {
+		std::cout << "  " << readers << " readers, " << writers << " writers, " << operations << " operations each" << std::endl;
+		report("TThreadSafe<TVector<int>, std::recursive_mutex>", lockModeMs<std::recursive_mutex>(readers, writers, operations));
+		report("TThreadSafe<TVector<int>, std::mutex>", lockModeMs<std::mutex>(readers, writers, operations));
+		report("TThreadSafe<TVector<int>, std::shared_mutex>", lockModeMs<std::shared_mutex>(readers, writers, operations));
+		report("TThreadSafe<TVector<int>, sstl::spin_lock>", lockModeMs<sstl::spin_lock>(readers, writers, operations));
+		report("TThreadSafe<std::array<int, 64>, std::shared_mutex>::read", lockModeCopyMs<std::shared_mutex>(readers, writers, operations));
+		report("TThreadSafe<std::array<int, 64>, sstl::seq_lock>::read", lockModeCopyMs<sstl::seq_lock>(readers, writers, operations));
+	}
+}
+
+/*
+ * Locked vs Lock-Free Queue
+ */
+
+void queueBenchmark() {
+	constexpr size_t operations = 1'000'000;
+	const size_t pairs = std::max<size_t>(1, std::thread::hardware_concurrency() / 2);
+	std::cout << "  " << pairs << " producers and " << pairs << " consumers, " << operations << " elements each" << std::endl;
+
+	// Producers push until they are done, consumers pop until every element has been seen
+	TThreadSafe<TQueue<int>> safeQueue;
+	std::atomic<size_t> safePopped = 0;
+	report("TThreadSafe<TQueue<int>>", timeThreadsMs(pairs * 2, [&](const size_t t) {
+		size_t sum = 0;
+		if (t < pairs) {
+			for (size_t i = 0; i < operations; ++i) safeQueue->push(static_cast<int>(i));
+		} else {
+			while (safePopped < pairs * operations) {
+				bool popped = false;
+				safeQueue.lockFor([&](TQueue<int>& queue) {
+					if (queue.getSize() == 0) return;
+					sum += queue.top();
+					queue.pop();
+					popped = true;
+				});
+				if (popped) ++safePopped;
+				else std::this_thread::yield();
+			}
+		}
+		g_Sink = g_Sink + sum;
+	}));
+
+	TConcurrentQueue<int> concurrentQueue(4096);
+	std::atomic<size_t> concurrentPopped = 0;
+	report("TConcurrentQueue<int>", timeThreadsMs(pairs * 2, [&](const size_t t) {
+		size_t sum = 0;
+		if (t < pairs) {
+			for (size_t i = 0; i < operations; ++i) concurrentQueue.push(static_cast<int>(i));
+		} else {
+			while (concurrentPopped < pairs * operations) {
+				int value = 0;
+				if (concurrentQueue.tryPop(value)) {
+					sum += value;
+					++concurrentPopped;
+				} else {
+					std::this_thread::yield();
+				}
+			}
+		}
+		g_Sink = g_Sink + sum;
+	}));
+
+	// Batches of 32 claim their slots with one compare and swap
+	TConcurrentQueue<int> batchQueue(4096);
+	std::atomic<size_t> batchPopped = 0;
+	report("TConcurrentQueue<int> pushRange/popRange", timeThreadsMs(pairs * 2, [&](const size_t t) {
+		size_t sum = 0;
+		if (t < pairs) {
+			int batch[32];
+			for (size_t i = 0; i < operations;) {
+				const size_t amt = std::min<size_t>(32, operations - i);
+				for (size_t j = 0; j < amt; ++j) batch[j] = static_cast<int>(i + j);
+				const size_t pushed = batchQueue.pushRange(batch, batch + amt);
+				if (pushed == 0) std::this_thread::yield();
+				i += pushed;
+			}
+		} else {
+			while (batchPopped < pairs * operations) {
+				const size_t popped = batchQueue.popRange(32, [&](int&& value) { sum += value; });
+				if (popped == 0) std::this_thread::yield();
+				batchPopped += popped;
+			}
+		}
+		g_Sink = g_Sink + sum;
+	}));
+}
+
+/*
+ * Single Producer Single Consumer Handoff
+ */
+
+void ringBufferBenchmark() {
+	constexpr size_t operations = 2'000'000;
+	std::cout << "  1 producer and 1 consumer, " << operations << " elements" << std::endl;
+
+	// Thread 0 produces and thread 1 consumes, both back off when there is nothing to do
+	TThreadSafe<TDeque<int>> safeDeque;
+	report("TThreadSafe<TDeque<int>>", timeThreadsMs(2, [&](const size_t t) {
+		size_t sum = 0;
+		if (t == 0) {
+			for (size_t i = 0; i < operations; ++i) safeDeque->push(static_cast<int>(i));
+		} else {
+			for (size_t popped = 0; popped < operations;) {
+				safeDeque.lockFor([&](TDeque<int>& deque) {
+					for (; deque.getSize() > 0; ++popped) {
+						sum += deque.top();
+						deque.pop();
+					}
+				});
+				std::this_thread::yield();
+			}
+		}
+		g_Sink = g_Sink + sum;
+	}));
+
+	TConcurrentQueue<int> concurrentQueue(4096);
+	report("TConcurrentQueue<int>", timeThreadsMs(2, [&](const size_t t) {
+		size_t sum = 0;
+		if (t == 0) {
+			for (size_t i = 0; i < operations; ++i) concurrentQueue.push(static_cast<int>(i));
+		} else {
+			for (size_t popped = 0; popped < operations;) {
+				int value = 0;
+				if (concurrentQueue.tryPop(value)) {
+					sum += value;
+					++popped;
+				} else {
+					std::this_thread::yield();
+				}
+			}
+		}
+		g_Sink = g_Sink + sum;
+	}));
+
+	TRingBuffer<int, 4096> ring;
+	report("TRingBuffer<int, 4096>", timeThreadsMs(2, [&](const size_t t) {
+		size_t sum = 0;
+		if (t == 0) {
+			for (size_t i = 0; i < operations;) {
+				if (ring.tryPush(static_cast<int>(i))) ++i;
+				else std::this_thread::yield();
+			}
+		} else {
+			for (size_t popped = 0; popped < operations;) {
+				int value = 0;
+				if (ring.tryPop(value)) {
+					sum += value;
+					++popped;
+				} else {
+					std::this_thread::yield();
+				}
+			}
+		}
+		g_Sink = g_Sink + sum;
+	}));
+
+	// Elements are written and read in place, and each side publishes a whole span with one store
+	TRingBuffer<int, 4096> spanRing;
+	report("TRingBuffer<int, 4096> beginWrite/beginRead", timeThreadsMs(2, [&](const size_t t) {
+		size_t sum = 0;
+		if (t == 0) {
+			for (size_t i = 0; i < operations;) {
+				const sstl::span<int> span = spanRing.beginWrite();
+				const size_t amt = std::min(span.size, operations - i);
+				for (size_t j = 0; j < amt; ++j) span[j] = static_cast<int>(i + j);
+				spanRing.commitWrite(amt);
+				if (amt == 0) std::this_thread::yield();
+				i += amt;
+			}
+		} else {
+			for (size_t popped = 0; popped < operations;) {
+				const sstl::span<int> span = spanRing.beginRead();
+				for (const int value : span) sum += value;
+				spanRing.commitRead(span.size);
+				if (span.size == 0) std::this_thread::yield();
+				popped += span.size;
+			}
+		}
+		g_Sink = g_Sink + sum;
+	}));
+}
+
+/*
+ * Thread Pool Scaling
+ */
+
+// Splits the range in two until it is small, so idle workers have to steal to get any work
+double splitSum(TThreadPool& pool, const size_t start, const size_t end) {
+	if (end - start <= 4096) {
+		double sum = 0;
+		for (size_t i = start; i < end; ++i) sum += std::sqrt(static_cast<double>(i));
+		return sum;
+	}
+	const size_t middle = start + (end - start) / 2;
+	double left = 0;
+	TThreadPool::group group;
+	pool.submit([&] { left = splitSum(pool, start, middle); }, group);
+	const double right = splitSum(pool, middle, end);
+	pool.wait(group);
+	return left + right;
+}
+
+void threadPoolBenchmark() {
+	constexpr size_t size = 1 << 24;
+	const size_t cores = std::max(1u, std::thread::hardware_concurrency());
+	std::cout << "  sqrt sum of " << size << " elements split into tasks of 4096" << std::endl;
+
+	for (size_t threadCount = 1;; threadCount = std::min(threadCount * 2, cores)) {
+		TThreadPool pool(threadCount);
+		const std::string name = "TThreadPool(" + std::to_string(threadCount) + ")";
+		report(name.c_str(), timeMs([&] {
+			double sum = 0;
+			pool.submit([&] { sum = splitSum(pool, 0, size); });
+			pool.wait();
+			g_Sink = g_Sink + static_cast<size_t>(sum);
+		}));
+		if (threadCount == cores) break;
+	}
+}
+
+/*
+ * Serial vs Parallel ForEach
+ */
+
+void parallelForEachBenchmark() {
+	constexpr size_t size = 1 << 22;
+	constexpr size_t iterations = 10;
+	std::cout << "  " << size << " element update pass, " << iterations << " iterations, " << TThreadPool::get().getThreadCount() << " workers" << std::endl;
+
+	TVector<float> container;
+	container.resize(size, [](const size_t index) { return static_cast<float>(index); });
+	const auto update = [](size_t, float& element) { element = std::sqrt(element * element + 1.f); };
+
+	report("TVector<float>::forEach", timeMs([&] {
+		for (size_t i = 0; i < iterations; ++i) container.forEach(update);
+	}));
+	report("sstl::parallelForEach", timeMs([&] {
+		for (size_t i = 0; i < iterations; ++i) sstl::parallelForEach(container, update);
+	}));
+	report("sstl::parallelForEach, grain 1024", timeMs([&] {
+		for (size_t i = 0; i < iterations; ++i) sstl::parallelForEach(container, update, 1024);
+	}));
+	g_Sink = g_Sink + static_cast<size_t>(container.get(size - 1));
+}
+
+/*
+ * One at a Time vs Bulk Build
+ */
+
+void bulkBuildBenchmark() {
+	constexpr size_t size = 2'000'000;
+	std::cout << "  " << size << " random keys, " << TThreadPool::get().getThreadCount() << " workers" << std::endl;
+
+	std::mt19937 random(7);
+	std::vector<int> keys(size);
+	for (int& key : keys) key = static_cast<int>(random());
+	std::vector<std::pair<int, int>> pairs(size);
+	for (size_t i = 0; i < size; ++i) pairs[i] = {keys[i], static_cast<int>(i)};
+
+	report("TSet<int>::push", timeMs([&] {
+		TSet<int> set;
+		for (const int key : keys) set.push(key);
+		g_Sink = g_Sink + set.getSize();
+	}));
+	report("TSet<int>::pushRange", timeMs([&] {
+		TSet<int> set;
+		set.pushRange(keys);
+		g_Sink = g_Sink + set.getSize();
+	}));
+	report("TConcurrentSet<int>::push", timeMs([&] {
+		TConcurrentSet<int> set;
+		for (const int key : keys) set.push(key);
+		g_Sink = g_Sink + set.getSize();
+	}));
+	report("TConcurrentSet<int>::pushRange", timeMs([&] {
+		TConcurrentSet<int> set;
+		set.pushRange(keys);
+		g_Sink = g_Sink + set.getSize();
+	}));
+	report("TConcurrentMap<int, int>::pushRange", timeMs([&] {
+		TConcurrentMap<int, int> map;
+		map.pushRange(pairs);
+		g_Sink = g_Sink + map.getSize();
+	}));
+
+	// Half the keys in each, merged into one
+	TMap<int, int> fstMap, sndMap;
+	fstMap.pushRange(pairs.begin(), pairs.begin() + size / 2);
+	sndMap.pushRange(pairs.begin() + size / 2, pairs.end());
+	report("TMap<int, int>::merge", timeMs([&] {
+		fstMap.merge(sndMap);
+	}));
+	TConcurrentMap<int, int> fstConcurrentMap, sndConcurrentMap;
+	fstConcurrentMap.pushRange(pairs.begin(), pairs.begin() + size / 2);
+	sndConcurrentMap.pushRange(pairs.begin() + size / 2, pairs.end());
+	report("TConcurrentMap<int, int>::merge", timeMs([&] {
+		fstConcurrentMap.merge(sndConcurrentMap);
+	}));
+	g_Sink = g_Sink + fstMap.getSize() + fstConcurrentMap.getSize();
+}
+
+/*
+ * Standard vs Parallel and Radix Sort
+ */
+
+void sortBenchmark() {
+	TThreadPool& pool = TThreadPool::get();
+	std::cout << "  " << pool.getThreadCount() << " workers" << std::endl;
+
+	for (const size_t size : {1'000'000, 10'000'000, 100'000'000}) {
+		std::cout << "  " << size << " random elements" << std::endl;
+		std::mt19937 random(11);
+		TVector<int> ints;
+		ints.resize(size, [&](size_t) { return static_cast<int>(random()); });
+		TVector<int> copy;
+
+		copy = ints;
+		report("std::sort<int>", timeMs([&] { std::sort(copy.begin(), copy.end()); }));
+		copy = ints;
+		report("TVector<int>::sort", timeMs([&] { copy.sort(); }));
+		copy = ints;
+		report("TVector<int>::sort, pool", timeMs([&] { copy.sort(std::less<int>{}, pool); }));
+		copy = ints;
+		report("TVector<int>::sort, std::greater, pool", timeMs([&] { copy.sort(std::greater<int>{}, pool); }));
+		copy = ints;
+		report("std::stable_sort<int>", timeMs([&] { std::stable_sort(copy.begin(), copy.end()); }));
+		copy = ints;
+		report("TVector<int>::stableSort, pool", timeMs([&] { copy.stableSort(std::less<int>{}, pool); }));
+		g_Sink = g_Sink + static_cast<size_t>(copy.get(size / 2));
+	}
+}
+
+/*
+ * Heap vs Inline Small Vectors
+ */
+
+template <typename TContainer>
+NOINLINE size_t fillShortLived(const size_t count) {
+	size_t sum = 0;
+	for (size_t i = 0; i < count; ++i) {
+		TContainer container;
+		for (size_t j = 0; j < 6; ++j) {
+			container.push(static_cast<int>(i + j));
+		}
+		container.forEach([&](size_t, const int element) { sum += element; });
+	}
+	return sum;
+}
+
+void smallVectorBenchmark() {
+	constexpr size_t count = 2'000'000;
+	std::cout << "  " << count << " short lived containers of 6 ints" << std::endl;
+
+	report("TVector<int>", timeMs([&] { g_Sink = g_Sink + fillShortLived<TVector<int>>(count); }));
+	report("TSmallVector<int, 8>", timeMs([&] { g_Sink = g_Sink + fillShortLived<TSmallVector<int, 8>>(count); }));
+	report("TSmallVector<int, 4>, spilling", timeMs([&] { g_Sink = g_Sink + fillShortLived<TSmallVector<int, 4>>(count); }));
+}
+
+// Fills the container, then pops and pushes back every other slot
+template <typename TContainer>
+NOINLINE size_t fillAndRefill(TContainer& container, const size_t size) {
+	size_t sum = 0;
+	for (size_t i = 0; i < size; ++i) {
+		sum += container.push(static_cast<int>(i));
+	}
+	for (size_t i = 0; i < size; i += 2) {
+		container.pop(i);
+	}
+	for (size_t i = 0; i < size; i += 2) {
+		sum += container.push(static_cast<int>(i));
+	}
+	container.clear();
+	return sum;
+}
+
+// Pops from the back and pushes back, which is all a static vector can do in O(1)
+NOINLINE size_t fillAndRefill(TStaticVector<int, 1 << 16>& container, const size_t size) {
+	size_t sum = 0;
+	for (size_t i = 0; i < size; ++i) {
+		sum += container.push(static_cast<int>(i));
+	}
+	for (size_t i = 0; i < size; i += 2) {
+		container.popBack();
+	}
+	for (size_t i = 0; i < size; i += 2) {
+		sum += container.push(static_cast<int>(i));
+	}
+	container.clear();
+	return sum;
+}
+
+// Runs fillAndRefill on the old linear scan, using a copy of TArray::push from before the first free slot was tracked
+struct ScanningArray : TArray<int, 1 << 16> {
+	size_t push(const int obj) {
+		for (size_t i = 0; i < getSize(); ++i) {
+			if (!m_IsPopulated[i]) {
+				m_IsPopulated.set(i);
+				m_Container[i] = obj;
+				return i;
+			}
+		}
+		throw std::runtime_error("Array is full, cannot add any more elements.");
+	}
+
+	void pop(const size_t index) {
+		m_IsPopulated.reset(index);
+	}
+
+	void clear() override {
+		m_IsPopulated.assign(0);
+	}
+};
+
+void staticVectorBenchmark() {
+	constexpr size_t size = 1 << 16;
+	std::cout << "  " << size << " ints pushed, half popped and pushed again" << std::endl;
+
+	// Static so 64k elements do not go on the stack
+	static ScanningArray scanning;
+	static TArray<int, size> array;
+	static TArray<int, size, true> slotMap;
+	static TStaticVector<int, size> vector;
+	report("TArray, scanning from slot 0", timeMs([&] { g_Sink = g_Sink + fillAndRefill(scanning, size); }));
+	report("TArray", timeMs([&] { for (int i = 0; i < 100; ++i) g_Sink = g_Sink + fillAndRefill(array, size); }) / 100);
+	report("TArray, slot map", timeMs([&] { for (int i = 0; i < 100; ++i) g_Sink = g_Sink + fillAndRefill(slotMap, size); }) / 100);
+	report("TStaticVector", timeMs([&] { for (int i = 0; i < 100; ++i) g_Sink = g_Sink + fillAndRefill(vector, size); }) / 100);
+}
+
+void arrayOccupancyBenchmark() {
+	constexpr size_t size = 1 << 16;
+	constexpr size_t stride = 64;
+	std::cout << "  " << size << " slots, every " << stride << "th populated, 100 passes" << std::endl;
+
+	static TArray<int, size> array;
+	for (size_t i = 0; i < size; i += stride) {
+		array.emplaceAt(i, static_cast<int>(i));
+	}
+
+	// Walking every slot one at a time, like TArray did before the slots were packed into words
+	report("count, contains(index) per slot", timeMs([&] {
+		for (int pass = 0; pass < 100; ++pass) {
+			size_t amt = 0;
+			for (size_t i = 0; i < size; ++i) {
+				amt += array.contains(i);
+			}
+			g_Sink = g_Sink + amt;
+		}
+	}));
+	report("count()", timeMs([&] {
+		for (int pass = 0; pass < 100; ++pass) {
+			g_Sink = g_Sink + array.count();
+		}
+	}));
+	report("forEach, skipping free slots", timeMs([&] {
+		for (int pass = 0; pass < 100; ++pass) {
+			array.forEach([&](const size_t index, const int& obj) {
+				if (array.contains(index)) g_Sink = g_Sink + obj;
+			});
+		}
+	}));
+	report("forEachPopulated", timeMs([&] {
+		for (int pass = 0; pass < 100; ++pass) {
+			array.forEachPopulated([](size_t, const int& obj) { g_Sink = g_Sink + obj; });
+		}
+	}));
+	report("pop() until empty", timeMs([&] {
+		for (size_t i = 0; i < size; i += stride) {
+			array.pop();
+		}
+	}));
+}
+
+// Keeps size elements alive and replaces one every step, so every step frees a node and allocates another
+template <typename TContainer>
+NOINLINE size_t churn(TContainer& container, const size_t size, const size_t steps) {
+	for (size_t i = 0; i < size; ++i) {
+		container.push(static_cast<int>(i));
+	}
+	for (size_t i = size; i < size + steps; ++i) {
+		container.pop(static_cast<int>(i - size));
+		container.push(static_cast<int>(i));
+	}
+	const size_t amt = container.getSize();
+	container.clear();
+	return amt;
+}
+
+template <typename TContainer>
+NOINLINE size_t churnMap(TContainer& container, const size_t size, const size_t steps) {
+	for (size_t i = 0; i < size; ++i) {
+		container.push(static_cast<int>(i), static_cast<int>(i));
+	}
+	for (size_t i = size; i < size + steps; ++i) {
+		container.pop(static_cast<int>(i - size));
+		container.push(static_cast<int>(i), static_cast<int>(i));
+	}
+	const size_t amt = container.getSize();
+	container.clear();
+	return amt;
+}
+
+void nodeChurnBenchmark() {
+	constexpr size_t size = 10'000;
+	constexpr size_t steps = 2'000'000;
+	std::cout << "  " << size << " live elements, " << steps << " pops and pushes" << std::endl;
+
+	using TIntAllocator = std::pmr::polymorphic_allocator<int>;
+	using TPairAllocator = std::pmr::polymorphic_allocator<std::pair<const int, int>>;
+	sstl::pool_resource pool(256);
+
+	{
+		TList<int> list;
+		TList<int, TIntAllocator> pooled(&pool);
+		report("TList<int>", timeMs([&] { g_Sink = g_Sink + churn(list, size, steps); }));
+		report("TList<int>, pool", timeMs([&] { g_Sink = g_Sink + churn(pooled, size, steps); }));
+	}
+	{
+		TSet<int> set;
+		TSet<int, TIntAllocator> pooled(&pool);
+		report("TSet<int>", timeMs([&] { g_Sink = g_Sink + churn(set, size, steps); }));
+		report("TSet<int>, pool", timeMs([&] { g_Sink = g_Sink + churn(pooled, size, steps); }));
+	}
+	{
+		TPriorityMap<int, int> map;
+		TPriorityMap<int, int, TPairAllocator> pooled(&pool);
+		report("TPriorityMap<int, int>", timeMs([&] { g_Sink = g_Sink + churnMap(map, size, steps); }));
+		report("TPriorityMap<int, int>, pool", timeMs([&] { g_Sink = g_Sink + churnMap(pooled, size, steps); }));
+	}
+
+	// The arena never reuses memory, so it suits filling and throwing away rather than churn
+	constexpr size_t rounds = 1'000;
+	report("TPriorityMap<int, int>, fill and clear", timeMs([&] {
+		for (size_t round = 0; round < rounds; ++round) {
+			TPriorityMap<int, int> map;
+			g_Sink = g_Sink + churnMap(map, size / 10, 0);
+		}
+	}));
+	report("TPriorityMap<int, int>, fill and clear, arena", timeMs([&] {
+		sstl::arena_resource arena;
+		for (size_t round = 0; round < rounds; ++round) {
+			{
+				TPriorityMap<int, int, TPairAllocator> map(&arena);
+				g_Sink = g_Sink + churnMap(map, size / 10, 0);
+			}
+			arena.release();
+		}
+	}));
+}
+
+// One tick of a game or server loop, building temporary vectors and maps that are all thrown away at the end
+template <typename TVectorType, typename TMapType, typename... TResource>
+NOINLINE size_t tick(TResource*... arena) {
+	size_t sum = 0;
+	for (int i = 0; i < 32; ++i) {
+		TVectorType vector(arena...);
+		for (int j = 0; j < 100; ++j) {
+			vector.push(i + j);
+		}
+		sum += vector.getSize();
+	}
+	for (int i = 0; i < 8; ++i) {
+		TMapType map(arena...);
+		for (int j = 0; j < 50; ++j) {
+			map.push(j, i);
+		}
+		sum += map.getSize();
+	}
+	return sum;
+}
+
+void frameArenaBenchmark() {
+	constexpr size_t ticks = 20'000;
+	std::cout << "  " << ticks << " ticks of 32 vectors of 100 ints and 8 maps of 50 pairs" << std::endl;
+
+	report("TVector and TMap", timeMs([&] {
+		for (size_t i = 0; i < ticks; ++i) {
+			g_Sink = g_Sink + tick<TVector<int>, TMap<int, int>>();
+		}
+	}));
+	report("TVector and TMap, frame arena", timeMs([&] {
+		sstl::arena_resource arena;
+		for (size_t i = 0; i < ticks; ++i) {
+			g_Sink = g_Sink + tick<TVector<int, std::pmr::polymorphic_allocator<int>>, TMap<int, int, std::pmr::polymorphic_allocator<std::pair<const int, int>>>>(&arena);
+			arena.reset();
+		}
+	}));
+}
+
+// Keeps size objects alive and replaces one every step, make builds the replacement
+template <typename TPointer, typename TMake>
+NOINLINE size_t replaceObjects(const size_t size, const size_t steps, TMake&& make) {
+	TVector<TPointer> objects;
+	objects.reserve(size);
+	for (size_t i = 0; i < size; ++i) {
+		objects.push(make(i));
+	}
+	size_t sum = 0;
+	for (size_t i = 0; i < steps; ++i) {
+		TPointer& obj = objects.get(i % size);
+		sum += obj->id;
+		obj = make(i);
+	}
+	return sum;
+}
+
+void objectPoolBenchmark() {
+	constexpr size_t size = 1'000;
+	constexpr size_t steps = 2'000'000;
+	std::cout << "  " << size << " live objects, " << steps << " replaced" << std::endl;
+
+	report("TUnique<SObject>", timeMs([&] {
+		g_Sink = g_Sink + replaceObjects<TUnique<SObject>>(size, steps, [](const size_t i) {
+			return TUnique<SObject>(i, "Object");
+		});
+	}));
+	report("TUnique<SObject>, object pool", timeMs([&] {
+		sstl::object_pool<SObject> pool(size);
+		g_Sink = g_Sink + replaceObjects<TUnique<SObject>>(size, steps, [&](const size_t i) {
+			return TUnique<SObject>::createIn(pool, i, "Object");
+		});
+	}));
+}
+
+void sharedCreationBenchmark() {
+	constexpr size_t size = 1'000;
+	constexpr size_t steps = 2'000'000;
+	std::cout << "  " << size << " live objects, " << steps << " replaced" << std::endl;
+
+	// Taking a raw pointer is the old path, a separate allocation for the object and for the control block
+	report("TShared<SObject>, object and control block", timeMs([&] {
+		g_Sink = g_Sink + replaceObjects<TShared<SObject>>(size, steps, [](const size_t i) {
+			return TShared<SObject>(new SObject(i, "Object"));
+		});
+	}));
+	report("TShared<SObject>, one allocation", timeMs([&] {
+		g_Sink = g_Sink + replaceObjects<TShared<SObject>>(size, steps, [](const size_t i) {
+			return TShared<SObject>(i, "Object");
+		});
+	}));
+}
+
+struct CountedObject : SObject, TRefCounted<> {
+	using SObject::SObject;
+};
+
+struct LocalCountedObject : SObject, TRefCounted<false> {
+	using SObject::SObject;
+};
+
+// Copies every pointer into a second vector and drops the copies, so each step is one count up and one count down
+template <typename TPointer>
+NOINLINE size_t copyPointers(const TVector<TPointer>& objects, TVector<TPointer>& copies, const size_t rounds) {
+	size_t sum = 0;
+	for (size_t round = 0; round < rounds; ++round) {
+		for (size_t i = 0; i < objects.getSize(); ++i) {
+			copies.push(objects.get(i));
+		}
+		sum += copies.get(round % copies.getSize())->id;
+		copies.clear();
+	}
+	return sum;
+}
+
+template <typename TPointer>
+void intrusiveRun(const char* name, const size_t size, const size_t rounds, const size_t steps) {
+	TVector<TPointer> objects;
+	TVector<TPointer> copies;
+	objects.reserve(size);
+	copies.reserve(size);
+	for (size_t i = 0; i < size; ++i) {
+		objects.push(TUnfurled<TPointer>::create(i, "Object"));
+	}
+	const std::string copyName = std::string(name) + ", copy";
+	const std::string replaceName = std::string(name) + ", create";
+	report(copyName.c_str(), timeMs([&] { g_Sink = g_Sink + copyPointers(objects, copies, rounds); }));
+	report(replaceName.c_str(), timeMs([&] {
+		g_Sink = g_Sink + replaceObjects<TPointer>(size, steps, [](const size_t i) {
+			return TUnfurled<TPointer>::create(i, "Object");
+		});
+	}));
+}
+
+void intrusiveBenchmark() {
+	constexpr size_t size = 1'000;
+	constexpr size_t rounds = 5'000;
+	constexpr size_t steps = 2'000'000;
+	std::cout << "  " << size << " objects copied " << rounds << " times, then " << steps << " replaced" << std::endl;
+
+	// libstdc++ counts shared_ptr references without atomics until a second thread has started, start one so TShared is measured as it runs in a threaded program
+	std::thread([] {}).join();
+
+	intrusiveRun<TShared<SObject>>("TShared<SObject>", size, rounds, steps);
+	intrusiveRun<TIntrusive<CountedObject>>("TIntrusive, atomic", size, rounds, steps);
+	intrusiveRun<TIntrusive<LocalCountedObject>>("TIntrusive, not atomic", size, rounds, steps);
+}
+
+struct Benchmark {
+	const char* name;
+	void (*func)();
+};
+
+// Runs every benchmark, or only the one named by the first argument
+int main(const int argc, char** argv) {
+	const Benchmark benchmarks[] = {
+		{"Dispatch", &dispatchBenchmark},
+		{"ForEach", &forEachBenchmark},
+		{"HeapDrain", &heapDrainBenchmark},
+		{"HashLookup", &hashLookupBenchmark},
+		{"Ordered", &orderedBenchmark},
+		{"Concurrent", &concurrentBenchmark},
+		{"LockMode", &lockModeBenchmark},
+		{"Queue", &queueBenchmark},
+		{"RingBuffer", &ringBufferBenchmark},
+		{"ThreadPool", &threadPoolBenchmark},
+		{"ParallelForEach", &parallelForEachBenchmark},
+		{"BulkBuild", &bulkBuildBenchmark},
+		{"Sort", &sortBenchmark},
+		{"SmallVector", &smallVectorBenchmark},
+		{"StaticVector", &staticVectorBenchmark},
+		{"ArrayOccupancy", &arrayOccupancyBenchmark},
+		{"NodeChurn", &nodeChurnBenchmark},
+		{"FrameArena", &frameArenaBenchmark},
+		{"ObjectPool", &objectPoolBenchmark},
+		{"SharedCreation", &sharedCreationBenchmark},
+		{"Intrusive", &intrusiveBenchmark}
+	};
+
+	for (const Benchmark& benchmark : benchmarks) {
+		if (argc > 1 && std::strcmp(argv[1], benchmark.name) != 0) continue;
+		std::cout << benchmark.name << std::endl;
+		benchmark.func();
+	}
+
+	return 0;
+}
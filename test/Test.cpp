@@ -1,6 +1,15 @@
 ﻿#include <iostream>
 #include <random>
+#include <array>
+#include <algorithm>
 #include <cassert>
+#include <atomic>
+#include <thread>
+#include <cstdlib>
+#include <new>
+#if CXX_VERSION >= 20
+#include <ranges>
+#endif
 
 #include "sstl/Array.h"
 #include "sstl/Deque.h"
@@ -8,21 +17,65 @@
 #include "sstl/Vector.h"
 #include "sstl/MaxHeap.h"
 #include "sstl/MinHeap.h"
+#include "sstl/IndexedHeap.h"
 #include "sstl/List.h"
 #include "sstl/MultiSet.h"
 #include "sstl/PriorityMultiSet.h"
 #include "sstl/Queue.h"
 #include "sstl/Set.h"
+#include "sstl/FlatSet.h"
 #include "sstl/PrioritySet.h"
+#include "sstl/BTreeSet.h"
+#include "sstl/BTreeMultiSet.h"
 #include "sstl/Stack.h"
 #include "sstl/Map.h"
+#include "sstl/FlatMap.h"
 #include "sstl/Memory.h"
 #include "sstl/PriorityMap.h"
+#include "sstl/BTreeMap.h"
+#include "sstl/BTreeMultiMap.h"
 #include "sstl/MultiMap.h"
 #include "sstl/PriorityMultiMap.h"
+#include "sstl/ConcurrentSet.h"
+#include "sstl/ConcurrentMap.h"
+#include "sstl/ConcurrentQueue.h"
+#include "sstl/RingBuffer.h"
+#include "sstl/Threading.h"
+#include "sstl/ThreadPool.h"
+#include "sstl/Parallel.h"
+#include "sstl/ParallelSort.h"
+#include "sstl/Allocator.h"
+#include "sstl/SmallVector.h"
+#include "sstl/StaticVector.h"
+#include "sstl/WorkStealingDeque.h"
 
 #include "TestShared.h"
 
+// Counts every allocation made through new and every free through delete, so tests can check when a container touches the heap
+static std::atomic<size_t> g_Allocations = 0;
+static std::atomic<size_t> g_Deallocations = 0;
+
+void* operator new(const size_t size) {
+	++g_Allocations;
+	if (void* ptr = std::malloc(size > 0 ? size : 1)) return ptr;
+	throw std::bad_alloc();
+}
+
+void* operator new(const size_t size, const std::nothrow_t&) noexcept {
+	++g_Allocations;
+	return std::malloc(size > 0 ? size : 1);
+}
+
+void operator delete(void* ptr) noexcept {
+	if (ptr) ++g_Deallocations;
+	std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+	if (ptr) ++g_Deallocations;
+	std::free(ptr);
+}
+
 template <typename TType>
 #if CXX_VERSION >= 20
 requires std::is_base_of_v<Abstract, typename TUnfurled<TType>::Type>
@@ -365,24 +418,1563 @@ void transferTest(const std::string& containerName, TAssociativeContainer<MapEnu
 	{ std::cout << std::endl << "--------------------" << std::endl << #x " Unique Constructor Test" << std::endl; } \
 	{ x container{TPair{MapEnum::NONE, TUnique{0}}, TPair{MapEnum::ONE, TUnique{5}}, TPair{MapEnum::TWO, TUnique{10}}}; container.forEach([](TPair<MapEnum, const TUnique<int>&> pair) { std::cout << *pair.value().get() << std::endl; }); } \
 
+static_assert(sstl::is_sequence_container_v<TVector<int>>, "TVector should satisfy the sequence container interface");
+static_assert(sstl::is_sequence_container_v<TStatic<TVector<int>>>, "TStatic should keep the sequence container interface");
+
+static_assert(std::is_same_v<decltype(std::declval<TMaxHeap<int>&>().begin()), TVector<int>::const_iterator>, "Heaps should only hand out const iterators");
+static_assert(std::is_same_v<decltype(std::declval<TMinHeap<int>&>().end()), TVector<int>::const_iterator>, "Heaps should only hand out const iterators");
+
+#if CXX_VERSION >= 20
+static_assert(std::ranges::contiguous_range<TVector<int>>);
+static_assert(std::ranges::contiguous_range<TArray<int, 10>>);
+static_assert(std::ranges::contiguous_range<TStaticVector<int, 10>>);
+static_assert(std::ranges::random_access_range<TDeque<int>>);
+static_assert(std::ranges::bidirectional_range<TList<int>>);
+static_assert(std::ranges::forward_range<TForwardList<int>>);
+static_assert(std::ranges::random_access_range<TQueue<int>>);
+static_assert(std::ranges::random_access_range<TStack<int>>);
+static_assert(std::ranges::forward_range<TSet<int>>);
+static_assert(std::ranges::forward_range<TMultiSet<int>>);
+static_assert(std::ranges::bidirectional_range<TPrioritySet<int>>);
+static_assert(std::ranges::bidirectional_range<TPriorityMultiSet<int>>);
+static_assert(std::ranges::bidirectional_range<TBTreeSet<int>>);
+static_assert(std::ranges::bidirectional_range<TBTreeMultiSet<int>>);
+static_assert(std::ranges::forward_range<TMap<int, int>>);
+static_assert(std::ranges::forward_range<TMultiMap<int, int>>);
+static_assert(std::ranges::bidirectional_range<TPriorityMap<int, int>>);
+static_assert(std::ranges::bidirectional_range<TPriorityMultiMap<int, int>>);
+static_assert(std::ranges::bidirectional_range<TBTreeMap<int, int>>);
+static_assert(std::ranges::bidirectional_range<TBTreeMultiMap<int, int>>);
+#endif
+
+void heapPopTest() {
+	std::cout << std::endl << "--------------------" << std::endl << "Heap Pop Test" << std::endl;
+
+	// pop_heap moves the top to the back, so removing the front instead would drop the wrong element
+	const int values[] = {3, 1, 4, 1, 5, 9, 2, 6, 5, 3};
+	const int descending[] = {9, 6, 5, 5, 4, 3, 3, 2, 1, 1};
+	TMaxHeap<int> maxHeap;
+	TMinHeap<int> minHeap;
+	for (const int value : values) {
+		maxHeap.push(value);
+		minHeap.push(value);
+	}
+	for (size_t i = 0; i < 10; ++i) {
+		assert(maxHeap.top() == descending[i]);
+		assert(minHeap.top() == descending[9 - i]);
+		maxHeap.pop();
+		minHeap.pop();
+		assert(maxHeap.getSize() == 9 - i && minHeap.getSize() == 9 - i);
+	}
+
+	// popBack removes the last element and leaves the rest in place
+	TVector<int> vector{1, 2, 3};
+	vector.popBack();
+	assert(vector.getSize() == 2 && vector.get(0) == 1 && vector.get(1) == 2);
+	std::cout << "Passed" << std::endl;
+}
+
+void transferRangeTest() {
+	std::cout << std::endl << "--------------------" << std::endl << "TransferRange Test" << std::endl;
+
+	// Derived containers take the moved run through transferIn, so they keep their own ordering
+	TVector<int> source{5, 1, 9, 3, 7};
+	TMaxHeap<int> heap;
+	source.transferRange(heap, 0, 5);
+	assert(source.getSize() == 0 && heap.getSize() == 5);
+	int previous = heap.top();
+	while (heap.getSize() > 0) {
+		assert(previous >= heap.top());
+		previous = heap.top();
+		heap.pop();
+	}
+
+	TDeque<int> deque{1, 2, 3};
+	TStack<int> stack;
+	deque.transferRange(stack, 0, 3);
+	assert(deque.getSize() == 0 && stack.getSize() == 3 && stack.top() == 3);
+
+	TVector<int> other{4, 6, 8};
+	TVector<int> vector{1};
+	other.transferRange(vector, 1, 3);
+	assert(other.getSize() == 1 && vector.getSize() == 3 && vector.get(1) == 6 && vector.get(2) == 8);
+
+	// Transferring into itself leaves the container as it was
+	TSmallVector<int, 2> small{1, 2, 3};
+	small.transferRange(small, 0, 2);
+	vector.transferRange(vector, 0, 3);
+	assert(small.getSize() == 3 && small.get(0) == 1 && vector.getSize() == 3 && vector.get(2) == 8);
+	std::cout << "Passed" << std::endl;
+}
+
+// Takes memory straight from malloc, so anything that reaches the global operator new did not come from here
+struct CountingResource : std::pmr::memory_resource {
+	size_t allocations = 0;
+	size_t outstanding = 0;
+
+	// Allocations past this many throw std::bad_alloc
+	size_t limit = static_cast<size_t>(-1);
+
+protected:
+
+	void* do_allocate(const size_t bytes, const size_t alignment) override {
+		assert(alignment <= alignof(std::max_align_t));
+		if (allocations == limit) throw std::bad_alloc();
+		++allocations;
+		outstanding += bytes;
+		return std::malloc(bytes);
+	}
+
+	void do_deallocate(void* ptr, const size_t bytes, size_t) override {
+		outstanding -= bytes;
+		std::free(ptr);
+	}
+
+	bool do_is_equal(const std::pmr::memory_resource& otr) const noexcept override {
+		return this == &otr;
+	}
+};
+
+void indexedHeapTest() {
+	std::cout << std::endl << "--------------------" << std::endl << "TIndexedMinHeap Handle Test" << std::endl;
+
+	// Elements are read in place, changing them goes through update or modify
+	TIndexedMinHeap<int> heap;
+	std::vector<size_t> handles;
+	for (int i = 0; i < 100; ++i) {
+		handles.push_back(heap.push((i * 37) % 100));
+	}
+	assert(heap.top() == 0);
+
+	// Handle of 37 is at 1, move it to the top, then back down
+	heap.decreaseKey(handles[1], -1);
+	assert(heap.top() == -1);
+	heap.increaseKey(handles[1], 500);
+	assert(heap.top() == 0);
+	assert(heap.fromHandle(handles[1]) == 500);
+
+	heap.remove(handles[0]);
+	assert(!heap.isValid(handles[0]));
+	assert(heap.getSize() == 99);
+
+	// Reading through a heap that is not const never changes it, changing elements in forEach rebuilds it
+	int sum = 0;
+	heap.forEach([&](size_t, const int& obj) { sum += obj; });
+	heap.forEachReverse([&](size_t, const int& obj) { sum -= obj; });
+	assert(sum == 0 && heap.top() == 1 && heap.get(0) == 1);
+	heap.doFor(0, [](int& obj) { obj = 1000; });
+	assert(heap.top() == 2);
+	heap.forEach([](size_t, int& obj) { if (obj == 50) obj = -5; });
+	assert(heap.top() == -5 && heap.fromHandle(handles[50]) == -5);
+
+	// The same through the sequence container interface
+	TSequenceContainer<int>& base = heap;
+	base.forEachReverse([&](size_t, const int& obj) { sum += obj; });
+	assert(sum != 0 && base.top() == -5);
+
+	int previous = heap.top();
+	while (heap.getSize() > 0) {
+		assert(previous <= heap.top());
+		previous = heap.top();
+		heap.pop();
+	}
+	assert(previous == 1000);
+
+	TIndexedMinHeap<TUnique<Parent>> unique;
+	unique.push(TUnfurled<TUnique<Parent>>::create<SObject>((size_t)2, "TIndexedMinHeap"));
+	Parent* obj = unique.top().get();
+	assert(unique.contains(obj));
+	unique.pop(obj);
+	assert(unique.getSize() == 0);
+
+	// The same object can be in the heap more than once, each entry is tracked on its own
+	TIndexedMinHeap<TShared<Parent>> shared;
+	TShared<Parent> first{(size_t)1};
+	TShared<Parent> second{(size_t)2};
+	shared.push(first);
+	shared.push(first);
+	const size_t secondHandle = shared.push(second);
+	shared.pop(first.get());
+	assert(shared.contains(first.get()) && shared.getSize() == 2);
+	assert(shared.get(shared.find(first.get())) == first);
+	shared.pop(first.get());
+	assert(!shared.contains(first.get()) && shared.contains(second.get()) && shared.getSize() == 1);
+
+	// A modify that throws still leaves the element findable by its pointer
+	try {
+		shared.modify(secondHandle, [](TShared<Parent>&) { throw std::runtime_error("Modify failed"); });
+	} catch (const std::runtime_error&) {}
+	assert(shared.contains(second.get()) && shared.getSize() == 1);
+
+	// A push whose bookkeeping cannot allocate leaves the heap as it was
+	CountingResource limited;
+	TIndexedMinHeap<int, 4, std::pmr::polymorphic_allocator<int>> bounded(&limited);
+	bool threw = false;
+	for (int i = 0; i < 100 && !threw; ++i) {
+		limited.limit = limited.allocations + 1;
+		try {
+			bounded.push(100 - i);
+		} catch (const std::bad_alloc&) {
+			threw = true;
+		}
+	}
+	assert(threw && bounded.getSize() == 0);
+	limited.limit = static_cast<size_t>(-1);
+	for (int i = 0; i < 20; ++i) {
+		bounded.push((i * 7) % 20);
+	}
+	for (int i = 0; i < 20; ++i) {
+		assert(bounded.top() == i);
+		bounded.pop();
+	}
+
+	// Elements are taken out of the heap before they are moved, so the rest stays in order
+	TIndexedMinHeap<int> from;
+	for (int i = 0; i < 20; ++i) {
+		from.push((i * 7) % 20);
+	}
+	TVector<int> to;
+	from.transferRange(to, 0, 5);
+	assert(from.getSize() == 15 && to.getSize() == 5 && to.get(0) == 0);
+	previous = from.top();
+	while (from.getSize() > 0) {
+		assert(previous <= from.top());
+		previous = from.top();
+		from.pop();
+	}
+	std::cout << "Passed" << std::endl;
+}
+
+void flatHashTest() {
+	std::cout << std::endl << "--------------------" << std::endl << "TFlatMap Consistency Test" << std::endl;
+
+	// Random pushes and pops, checked against TMap, enough to grow several times and leave deleted slots behind
+	TFlatMap<int, int> flat;
+	TMap<int, int> map;
+	std::mt19937 rng(7);
+	for (int i = 0; i < 200000; ++i) {
+		const int key = static_cast<int>(rng() % 5000);
+		if (rng() % 3 == 0) {
+			flat.pop(key);
+			map.pop(key);
+		} else {
+			flat.push(key, i);
+			map.push(key, i);
+		}
+		assert(flat.getSize() == map.getSize());
+	}
+	map.forEach([&](TPair<int, const int&> pair) {
+		assert(flat.contains(pair.key()));
+		assert(flat.get(pair.key()) == pair.value());
+	});
+
+	size_t count = 0;
+	for (auto& pair : flat) {
+		assert(map.contains(pair.first));
+		count++;
+	}
+	assert(count == map.getSize());
+	static_assert(std::is_same_v<decltype(flat.begin()->first), const int>, "TFlatMap keys should not be changeable through an iterator");
+
+	// Values are still moved when the table grows, only the key is copied
+	TFlatMap<int, std::unique_ptr<int>> owners;
+	for (int i = 0; i < 100; ++i) {
+		owners.emplace(i, std::make_unique<int>(i));
+	}
+	assert(owners.getSize() == 100 && *owners.get(42) == 42);
+
+	TFlatMap<int, int> copy = flat;
+	flat.clear();
+	assert(copy.getSize() == map.getSize() && flat.getSize() == 0);
+	std::cout << "Passed" << std::endl;
+}
+
+void bTreeTest() {
+	std::cout << std::endl << "--------------------" << std::endl << "TBTreeMap Consistency Test" << std::endl;
+
+	// Large values leave room for only a few per node, so the tree gets deep and every split, rotation and merge is exercised
+	TBTreeMap<int, std::array<int, 64>> tree;
+	TPriorityMap<int, std::array<int, 64>> map;
+	std::mt19937 rng(11);
+	for (int i = 0; i < 200000; ++i) {
+		const int key = static_cast<int>(rng() % 5000);
+		if (rng() % 3 == 0) {
+			tree.pop(key);
+			map.pop(key);
+		} else {
+			tree.push(key, {i});
+			map.push(key, {i});
+		}
+		assert(tree.getSize() == map.getSize());
+	}
+
+	// Iteration must be in the same order both ways
+	assert(std::equal(tree.begin(), tree.end(), map.begin(), map.end(), [](const auto& fst, const auto& snd) {
+		return fst.first == snd.first && fst.second[0] == snd.second[0];
+	}));
+	assert(std::equal(tree.rbegin(), tree.rend(), map.rbegin(), map.rend(), [](const auto& fst, const auto& snd) {
+		return fst.first == snd.first;
+	}));
+	assert(tree.top().key() == map.top().key() && tree.bottom().key() == map.bottom().key());
+
+	for (int key = -1; key <= 5001; ++key) {
+		assert(tree.contains(key) == map.contains(key));
+		assert((tree.lowerBound(key) == tree.end()) == (map.lowerBound(key) == map.end()));
+		assert(tree.lowerBound(key) == tree.end() || tree.lowerBound(key)->first == map.lowerBound(key)->first);
+		assert(tree.upperBound(key) == tree.end() || tree.upperBound(key)->first == map.upperBound(key)->first);
+	}
+
+	std::vector<int> treeRange, mapRange;
+	tree.forEachInRange(1000, 2000, [&](TPair<int, const std::array<int, 64>&> pair) { treeRange.push_back(pair.key()); });
+	map.forEachInRange(1000, 2000, [&](TPair<int, const std::array<int, 64>&> pair) { mapRange.push_back(pair.key()); });
+	assert(treeRange == mapRange && !treeRange.empty());
+
+	TBTreeMap<int, std::array<int, 64>> copy = tree;
+	while (tree.getSize() > 0) {
+		tree.pop();
+	}
+	assert(copy.getSize() == map.getSize() && tree.begin() == tree.end());
+
+	TBTreeSet<int> set{5, 1, 9, 3};
+	std::vector<int> setRange;
+	set.forEachInRange(2, 9, [&](const int& i) { setRange.push_back(i); });
+	assert((setRange == std::vector<int>{3, 5}));
+	assert(*set.lowerBound(4) == 5 && *set.upperBound(5) == 9 && set.upperBound(9) == set.end());
+	static_assert(std::is_same_v<decltype(tree.begin()->first), const int>, "TBTreeMap keys should not be changeable through an iterator");
+
+	// Duplicates go after the equal keys already there, and popping a key removes all of them
+	TBTreeMultiMap<int, std::array<int, 64>> multiTree;
+	TPriorityMultiMap<int, std::array<int, 64>> multiMap;
+	for (int i = 0; i < 100000; ++i) {
+		const int key = static_cast<int>(rng() % 2000);
+		if (rng() % 5 == 0) {
+			multiTree.pop(key);
+			multiMap.pop(key);
+		} else {
+			multiTree.push(key, {i});
+			multiMap.push(key, {i});
+		}
+		assert(multiTree.getSize() == multiMap.getSize());
+	}
+	assert(std::equal(multiTree.begin(), multiTree.end(), multiMap.begin(), multiMap.end(), [](const auto& fst, const auto& snd) {
+		return fst.first == snd.first && fst.second[0] == snd.second[0];
+	}));
+
+	TBTreeMultiSet<int> multiSet{5, 1, 5, 9, 5};
+	assert(multiSet.getSize() == 5 && std::count(multiSet.begin(), multiSet.end(), 5) == 3);
+	std::vector<int> multiRange;
+	multiSet.forEachInRange(5, 9, [&](const int& i) { multiRange.push_back(i); });
+	assert((multiRange == std::vector<int>{5, 5, 5}));
+	multiSet.pop(5);
+	assert(multiSet.getSize() == 2 && !multiSet.contains(5));
+	std::cout << "Passed" << std::endl;
+}
+
+void concurrentHashTest() {
+	std::cout << std::endl << "--------------------" << std::endl << "TConcurrentMap Threaded Test" << std::endl;
+
+	constexpr int threadCount = 8;
+	constexpr int perThread = 20000;
+
+	// Every thread pushes its own keys, and they all race to compute the same shared keys
+	TConcurrentMap<int, int> map;
+	TConcurrentSet<int> set;
+	std::atomic<int> computed = 0;
+	std::vector<std::thread> threads;
+	for (int t = 0; t < threadCount; ++t) {
+		threads.emplace_back([&, t] {
+			for (int i = 0; i < perThread; ++i) {
+				const int key = t * perThread + i;
+				const bool pushed = map.push(key, key * 2) && set.push(key);
+				assert(pushed);
+				const int shared = map.computeIfAbsent(-1 - i % 100, [&] { ++computed; return i % 100; });
+				assert(shared == i % 100);
+				if (i % 2 == 0) {
+					const bool popped = map.pop(key) && set.pop(key);
+					assert(popped);
+				}
+			}
+		});
+	}
+	for (std::thread& thread : threads) {
+		thread.join();
+	}
+
+	assert(computed == 100);
+	assert(map.getSize() == threadCount * perThread / 2 + 100);
+	assert(set.getSize() == threadCount * perThread / 2);
+	for (int key = 0; key < threadCount * perThread; ++key) {
+		assert(map.contains(key) == (key % perThread % 2 == 1));
+		assert(set.contains(key) == map.contains(key));
+		int value = 0;
+		assert(map.tryGet(key, value) == map.contains(key) && (!map.contains(key) || value == key * 2));
+	}
+
+	map.replace(1, 5);
+	map.doFor(1, [](int& value) { value += 1; });
+	assert(map.get(1) == 6);
+
+	size_t count = 0;
+	set.forEach([&](const int& key) { assert(map.contains(key)); count++; });
+	assert(count == set.getSize());
+
+	map.clear();
+	set.clear();
+	assert(map.getSize() == 0 && set.getSize() == 0);
+	std::cout << "Passed" << std::endl;
+}
+
+void concurrentQueueTest() {
+	std::cout << std::endl << "--------------------" << std::endl << "TConcurrentQueue Threaded Test" << std::endl;
+
+	constexpr int threadCount = 4;
+	constexpr int perThread = 50000;
+
+	// A small ring keeps it full and empty often, producers push one at a time or in batches and consumers pop the same way
+	TConcurrentQueue<int> queue(64);
+	assert(queue.getCapacity() == 64);
+	std::atomic<long long> sum = 0;
+	std::atomic<int> popped = 0;
+	std::vector<std::thread> threads;
+	for (int t = 0; t < threadCount; ++t) {
+		threads.emplace_back([&, t] {
+			if (t % 2 == 0) {
+				for (int i = 0; i < perThread;) {
+					const int batch[] = {i, i + 1, i + 2, i + 3};
+					i += static_cast<int>(queue.pushRange(batch, batch + std::min(4, perThread - i)));
+					if (i < perThread) queue.push(i++);
+				}
+			} else {
+				long long local = 0;
+				while (popped < threadCount / 2 * perThread) {
+					int value = 0;
+					if (queue.tryPop(value)) {
+						local += value;
+						++popped;
+					} else {
+						std::this_thread::yield();
+					}
+					popped += static_cast<int>(queue.popRange(4, [&](int&& obj) { local += obj; }));
+				}
+				sum += local;
+			}
+		});
+	}
+	for (std::thread& thread : threads) {
+		thread.join();
+	}
+
+	assert(popped == threadCount / 2 * perThread);
+	assert(sum == static_cast<long long>(threadCount / 2) * perThread * (perThread - 1) / 2);
+	assert(queue.getSize() == 0);
+
+	// Order is kept for a single thread, and pushing to a full queue fails
+	TConcurrentQueue<TUnique<int>> unique(4);
+	for (int i = 0; i < 4; ++i) {
+		const bool ok = unique.tryEmplace(i);
+		assert(ok);
+	}
+	const bool full = !unique.tryPush(TUnique<int>{4});
+	assert(full && unique.getSize() == 4);
+	TUnique<int> front;
+	const bool poppedFront = unique.tryPop(front);
+	assert(poppedFront && *front == 0);
+	TVector<TUnique<int>> drained;
+	const size_t transferred = unique.transferRange(drained, 8);
+	assert(transferred == 3);
+	assert(*drained.get(0) == 1 && *drained.get(2) == 3);
+	const bool empty = !unique.tryPop(front);
+	assert(empty && *front == 0);
+
+	// Strings can throw while being copied, so they are built before their slot is claimed
+	TConcurrentQueue<std::string> strings(2);
+	const std::string names[] = {"first", "second", "third"};
+	const size_t pushedStrings = strings.pushRange(names, names + 3);
+	assert(pushedStrings == 2);
+	std::string name;
+	const bool poppedString = strings.tryPop(name);
+	assert(poppedString && name == "first");
+
+	TVector<int> batch{1, 2, 3};
+	TConcurrentQueue<int> small(2);
+	const size_t pushed = small.pushRange(batch);
+	assert(pushed == 2 && small.getSize() == 2);
+	small.clear();
+	assert(small.getSize() == 0);
+	std::cout << "Passed" << std::endl;
+}
+
+// The producer switches between single pushes, ranges and write spans, and the consumer checks every element arrives in order
+template <typename TRing>
+void ringBufferTest(const char* name, TRing& ring) {
+	std::cout << std::endl << "--------------------" << std::endl << name << " Threaded Test" << std::endl;
+
+	constexpr int count = 200000;
+	std::thread producer([&] {
+		for (int i = 0; i < count;) {
+			if (ring.getSize() == ring.getCapacity()) std::this_thread::yield();
+			if (i % 3 == 0) {
+				if (ring.tryPush(i)) ++i;
+			} else if (i % 3 == 1) {
+				const int batch[] = {i, i + 1, i + 2, i + 3, i + 4};
+				i += static_cast<int>(ring.pushRange(batch, batch + std::min(5, count - i)));
+			} else {
+				sstl::span<int> span = ring.beginWrite();
+				const size_t amt = std::min<size_t>(span.size, count - i);
+				for (size_t j = 0; j < amt; ++j) span[j] = i + static_cast<int>(j);
+				ring.commitWrite(amt);
+				i += static_cast<int>(amt);
+			}
+		}
+	});
+
+	int expected = 0;
+	while (expected < count) {
+		if (expected % 2 == 0) {
+			const sstl::span<int> span = ring.beginRead();
+			for (const int value : span) {
+				assert(value == expected);
+				++expected;
+			}
+			ring.commitRead(span.size);
+		} else {
+			int value = 0;
+			if (ring.tryPop(value)) {
+				assert(value == expected);
+				++expected;
+			}
+			ring.popRange(3, [&](int&& obj) {
+				assert(obj == expected);
+				++expected;
+			});
+		}
+		if (ring.getSize() == 0) std::this_thread::yield();
+	}
+	producer.join();
+	assert(ring.getSize() == 0 && ring.peek() == nullptr);
+	std::cout << "Passed" << std::endl;
+}
+
+// Counts how many are alive, so a container can be checked for destroying everything it holds
+struct LiveCounted {
+	static inline int live = 0;
+
+	LiveCounted() { ++live; }
+	LiveCounted(const LiveCounted&) { ++live; }
+	LiveCounted(LiveCounted&&) noexcept { ++live; }
+	LiveCounted& operator=(const LiveCounted&) = default;
+	LiveCounted& operator=(LiveCounted&&) noexcept = default;
+	~LiveCounted() { --live; }
+};
+
+void ringBufferTest() {
+	TRingBuffer<int, 64> fixed;
+	assert(fixed.getCapacity() == 64);
+	ringBufferTest("TRingBuffer<int, 64>", fixed);
+
+	TRingBuffer<int> dynamic(100);
+	assert(dynamic.getCapacity() == 128);
+	ringBufferTest("TRingBuffer<int>", dynamic);
+
+	// Elements that own memory are destroyed when popped or when the ring is destroyed
+	TRingBuffer<TUnique<int>, 4> unique;
+	for (int i = 0; i < 4; ++i) {
+		const bool ok = unique.tryEmplace(i);
+		assert(ok);
+	}
+	const bool full = !unique.tryEmplace(4);
+	assert(full && **unique.peek() == 0);
+	TVector<TUnique<int>> drained;
+	const size_t transferred = unique.transferRange(drained, 2);
+	assert(transferred == 2 && *drained.get(1) == 1);
+	const sstl::span<TUnique<int>> span = unique.beginRead();
+	assert(span.size == 2 && *span[0] == 2);
+	unique.commitRead(1);
+	assert(unique.getSize() == 1);
+
+	// Elements pushed after the consumer cached the tail are still seen by popRange and destroyed with the ring
+	{
+		TRingBuffer<LiveCounted, 8> live;
+		bool ok = live.tryEmplace();
+		assert(ok && live.peek());
+		for (int i = 0; i < 2; ++i) {
+			ok = live.tryEmplace();
+			assert(ok);
+		}
+		assert(LiveCounted::live == 3);
+	}
+	assert(LiveCounted::live == 0);
+
+	TRingBuffer<int, 8> cached;
+	bool ok = cached.tryPush(0);
+	assert(ok && cached.peek());
+	const int batch[] = {1, 2};
+	const size_t pushed = cached.pushRange(batch, batch + 2);
+	const size_t popped = cached.popRange(8, [](int&&) {});
+	assert(pushed == 2 && popped == 3);
+}
+
+void workStealingTest() {
+	std::cout << std::endl << "--------------------" << std::endl << "TWorkStealingDeque Threaded Test" << std::endl;
+
+	// The owner pushes and pops while thieves steal, every element must be taken exactly once
+	constexpr int count = 100000;
+	TWorkStealingDeque<int> deque(4);
+	std::vector<std::atomic<int>> taken(count);
+	std::atomic<bool> done = false;
+	std::vector<std::thread> thieves;
+	for (int t = 0; t < 3; ++t) {
+		thieves.emplace_back([&] {
+			while (!done) {
+				int value = 0;
+				if (deque.steal(value)) ++taken[value];
+				else std::this_thread::yield();
+			}
+		});
+	}
+	for (int i = 0; i < count; ++i) {
+		deque.push(i);
+		int value = 0;
+		if (i % 3 == 0 && deque.pop(value)) ++taken[value];
+	}
+	for (int value = 0; deque.pop(value);) {
+		++taken[value];
+	}
+	done = true;
+	for (std::thread& thread : thieves) {
+		thread.join();
+	}
+	assert(deque.getSize() == 0 && deque.getCapacity() >= 4);
+	assert(std::all_of(taken.begin(), taken.end(), [](const std::atomic<int>& times) { return times == 1; }));
+	std::cout << "Passed" << std::endl;
+
+	std::cout << std::endl << "--------------------" << std::endl << "TThreadPool Threaded Test" << std::endl;
+
+	// Every task splits in two until the range is small, waiting on its own group from inside the pool
+	TThreadPool pool(4);
+	std::atomic<long long> sum = 0;
+	std::function<void(int, int)> split = [&](const int start, const int end) {
+		if (end - start <= 64) {
+			long long local = 0;
+			for (int i = start; i < end; ++i) local += i;
+			sum += local;
+			return;
+		}
+		TThreadPool::group group;
+		const int middle = start + (end - start) / 2;
+		pool.submit([&, start, middle] { split(start, middle); }, group);
+		pool.submit([&, middle, end] { split(middle, end); }, group);
+		pool.wait(group);
+	};
+	pool.submit([&] { split(0, count); });
+	pool.wait();
+	assert(sum == static_cast<long long>(count) * (count - 1) / 2);
+
+	// Exceptions are rethrown by whoever waits on the task
+	TThreadPool::group group;
+	pool.submit([] { throw std::runtime_error("Task failed"); }, group);
+	bool thrown = false;
+	try {
+		pool.wait(group);
+	} catch (const std::runtime_error&) {
+		thrown = true;
+	}
+	assert(thrown && group.isDone());
+	assert(pool.getThreadCount() == 4 && pool.getWorkerIndex() == 4);
+
+	// A pool destroyed with an unseen exception from a task without a group drops it instead of terminating
+	{
+		TThreadPool failing(2);
+		failing.submit([] { throw std::runtime_error("Nobody waits on this"); });
+	}
+	std::cout << "Passed" << std::endl;
+}
+
+void parallelTest() {
+	std::cout << std::endl << "--------------------" << std::endl << "Parallel ForEach Test" << std::endl;
+
+	constexpr size_t size = 100000;
+	TThreadPool pool(4);
+
+	TVector<int> vector;
+	vector.resize(size, [](const size_t index) { return static_cast<int>(index); });
+	sstl::parallelForEach(vector, [](const size_t index, int& element) { element += static_cast<int>(index); }, 0, pool);
+	assert(vector.get(0) == 0 && vector.get(size - 1) == static_cast<int>(2 * (size - 1)));
+
+	TDeque<int> deque;
+	deque.resize(size, [](const size_t) { return 1; });
+	sstl::parallelDoFor(deque, 10, size - 10, [](size_t, int& element) { element = 2; }, 1000, pool);
+	assert(deque.get(9) == 1 && deque.get(10) == 2 && deque.get(size - 11) == 2 && deque.get(size - 10) == 1);
+
+	// Const containers and the shared pool work too
+	const TVector<int>& view = vector;
+	std::atomic<long long> sum = 0;
+	sstl::parallelForEach(view, [&](size_t, const int& element) { sum += element; });
+	assert(sum == static_cast<long long>(size) * (size - 1));
+
+	// The same grain always gives the same chunks
+	std::vector<std::atomic<int>> chunkStarts(size);
+	sstl::parallelChunks(5, size, [&](const size_t start, const size_t end) {
+		assert(end - start <= 333 && ((start - 5) % 333 == 0));
+		++chunkStarts[start];
+	}, 333, pool);
+	assert(std::count_if(chunkStarts.begin(), chunkStarts.end(), [](const std::atomic<int>& count) { return count == 1; }) == (size - 5 + 332) / 333);
+
+	bool thrown = false;
+	try {
+		sstl::parallelFor(0, size, [](const size_t index) { if (index == size / 2) throw std::runtime_error("Index failed"); }, 100, pool);
+	} catch (const std::runtime_error&) {
+		thrown = true;
+	}
+	assert(thrown);
+
+	static_assert(sstl::is_random_access_container_v<TVector<int>> && sstl::is_random_access_container_v<const TArray<int, 4>>);
+	static_assert(!sstl::is_random_access_container_v<TList<int>>);
+	std::cout << "Passed" << std::endl;
+}
+
+void bulkBuildTest() {
+	std::cout << std::endl << "--------------------" << std::endl << "Bulk Build and Merge Test" << std::endl;
+
+	constexpr int size = 200000;
+	std::vector<int> keys(size);
+	std::vector<std::pair<int, int>> pairs(size);
+	for (int i = 0; i < size; ++i) {
+		keys[i] = i;
+		pairs[i] = {i, i * 2};
+	}
+
+	// The standard backed containers grow once and merge by relinking nodes
+	TSet<int> set;
+	set.pushRange(keys.begin(), keys.begin() + size / 2);
+	TSet<int> otherSet;
+	otherSet.pushRange(keys);
+	set.merge(otherSet);
+	assert(set.getSize() == size && otherSet.getSize() == size / 2 && otherSet.contains(0) && !otherSet.contains(size - 1));
+
+	TMap<int, int> map;
+	map.pushRange(pairs);
+	TMap<int, int> otherMap;
+	otherMap.push(-1, 5);
+	otherMap.push(0, 5);
+	map.merge(otherMap);
+	assert(map.getSize() == size + 1 && map.get(-1) == 5 && map.get(0) == 0 && otherMap.getSize() == 1);
+
+	// The sharded containers build and merge every shard on its own task
+	TThreadPool pool(4);
+	TConcurrentSet<int> concurrentSet;
+	concurrentSet.pushRange(keys, pool);
+	concurrentSet.pushRange(keys.begin(), keys.begin() + 10, pool);
+	assert(concurrentSet.getSize() == size);
+	for (int i = 0; i < size; i += 997) {
+		assert(concurrentSet.contains(i));
+	}
+
+	TConcurrentMap<int, int> concurrentMap;
+	concurrentMap.pushRange(std::move(pairs), pool);
+	assert(concurrentMap.getSize() == size && concurrentMap.get(size - 1) == 2 * (size - 1));
+
+	TConcurrentMap<int, int> otherConcurrentMap;
+	for (int i = size - 100; i < size + 100; ++i) {
+		otherConcurrentMap.push(i, -i);
+	}
+	concurrentMap.merge(otherConcurrentMap, pool);
+	assert(concurrentMap.getSize() == size + 100 && otherConcurrentMap.getSize() == 100);
+	assert(concurrentMap.get(size) == -size && concurrentMap.get(size - 1) == 2 * (size - 1) && otherConcurrentMap.get(size - 1) == -(size - 1));
+
+	TConcurrentSet<int> otherConcurrentSet;
+	otherConcurrentSet.push(-1);
+	otherConcurrentSet.push(0);
+	concurrentSet.merge(otherConcurrentSet, pool);
+	assert(concurrentSet.getSize() == size + 1 && otherConcurrentSet.getSize() == 1 && otherConcurrentSet.contains(0));
+	std::cout << "Passed" << std::endl;
+}
+
+// Writers bump every element together, so a reader that ever sees them differ has read a half finished write
+template <typename TMutex>
+void threadSafeTest(const char* name) {
+	std::cout << std::endl << "--------------------" << std::endl << name << " Threaded Test" << std::endl;
+
+	TThreadSafe<std::array<int, 16>, TMutex> safe;
+	safe.lockFor([](std::array<int, 16>& obj) { obj.fill(0); });
+	std::vector<std::thread> threads;
+	for (int t = 0; t < 4; ++t) {
+		threads.emplace_back([&, t] {
+			for (int i = 0; i < 20000; ++i) {
+				if (t % 2 == 0) {
+					safe.lockFor([](std::array<int, 16>& obj) {
+						for (int& element : obj) ++element;
+					});
+				} else {
+					const std::array<int, 16> copy = safe.read();
+					const bool torn = std::any_of(copy.begin(), copy.end(), [&](const int element) { return element != copy[0]; });
+					assert(!torn);
+				}
+			}
+		});
+	}
+	for (std::thread& thread : threads) {
+		thread.join();
+	}
+	assert(safe.read()[15] == 40000);
+
+	// The const operator-> is a read lock, so it must not be taken while this thread holds the write lock
+	const TThreadSafe<std::array<int, 16>, TMutex>& view = safe;
+	assert(view->at(0) == 40000);
+	std::cout << "Passed" << std::endl;
+}
+
+void sortTest() {
+	std::cout << std::endl << "--------------------" << std::endl << "Sort Test" << std::endl;
+
+	// Large enough to take the parallel paths
+	constexpr size_t size = 300000;
+	TThreadPool pool(4);
+	std::mt19937 random(3);
+
+	// Integers and floats go through the radix sort, negatives included
+	TVector<int> ints;
+	ints.resize(size, [&](size_t) { return static_cast<int>(random()); });
+	std::vector<int> expected(ints.begin(), ints.end());
+	std::sort(expected.begin(), expected.end());
+	ints.sort(std::less<int>{}, pool);
+	assert(std::equal(ints.begin(), ints.end(), expected.begin()));
+
+	TDeque<double> doubles;
+	doubles.resize(size, [&](const size_t index) { return (static_cast<double>(random()) - 2147483648.0) / static_cast<double>(index + 1); });
+	doubles.sort(std::less<double>{}, pool);
+	assert(std::is_sorted(doubles.begin(), doubles.end()));
+
+	// Without a pool the same containers sort on the calling thread
+	doubles.resize(size * 2, [&](size_t) { return static_cast<double>(random()); });
+	doubles.sort();
+	assert(std::is_sorted(doubles.begin(), doubles.end()));
+
+	TVector<unsigned short> shorts;
+	shorts.resize(size, [&](size_t) { return static_cast<unsigned short>(random()); });
+	shorts.stableSort(std::less<unsigned short>{}, pool);
+	assert(std::is_sorted(shorts.begin(), shorts.end()));
+
+	// Other comparators and types go through the merge sort
+	TDeque<std::string> strings;
+	strings.resize(size, [&](size_t) { return std::to_string(random() % 100000); });
+	strings.sort(std::greater<std::string>{}, pool);
+	assert(std::is_sorted(strings.begin(), strings.end(), std::greater<std::string>{}));
+
+	// Equal keys keep the order they were pushed in
+	TVector<std::pair<int, size_t>> pairs;
+	pairs.resize(size, [&](const size_t index) { return std::pair<int, size_t>{static_cast<int>(random() % 1000), index}; });
+	pairs.stableSort([](const std::pair<int, size_t>& a, const std::pair<int, size_t>& b) { return a.first < b.first; }, pool);
+	assert(std::is_sorted(pairs.begin(), pairs.end()));
+
+	// Small containers stay on the calling thread
+	TVector<int> small{5, 3, 9, 1, 7};
+	small.sort(std::greater<int>{});
+	assert(small.get(0) == 9 && small.get(4) == 1);
+
+	TVector<int> partial;
+	partial.resize(1000, [](const size_t index) { return static_cast<int>(999 - index); });
+	partial.partialSort(10);
+	for (int i = 0; i < 10; ++i) {
+		assert(partial.get(i) == i);
+	}
+	partial.nthElement(500);
+	assert(partial.get(500) == 500);
+	// Indices past the end are clamped like partialSort's amt, instead of running off the container
+	partial.nthElement(5000);
+	partial.partialSort(5000);
+	assert(partial.getSize() == 1000 && partial.get(999) == 999);
+
+	// Arrays sort their populated elements into the front and leave the free slots after them
+	TArray<int, 8> array;
+	array.emplaceAt(1, 6);
+	array.emplaceAt(3, 2);
+	array.emplaceAt(6, 4);
+	array.emplaceAt(7, 1);
+	array.sort();
+	assert(array.get(0) == 1 && array.get(1) == 2 && array.get(2) == 4 && array.get(3) == 6);
+	assert(array.contains(static_cast<size_t>(3)) && !array.contains(static_cast<size_t>(4)) && !array.contains(static_cast<size_t>(7)));
+	std::cout << "Passed" << std::endl;
+}
+
+// Its move constructor is allowed to throw
+struct ThrowingMove {
+	ThrowingMove() = default;
+	ThrowingMove(const ThrowingMove&) = default;
+	ThrowingMove(ThrowingMove&&) noexcept(false) {}
+	ThrowingMove& operator=(const ThrowingMove&) = default;
+	ThrowingMove& operator=(ThrowingMove&&) noexcept(false) { return *this; }
+};
+
+// Throws from its constructor when given a negative value
+struct ThrowingConstruct {
+	explicit ThrowingConstruct(const int inValue): value(inValue) {
+		if (value < 0) throw std::runtime_error("Negative value");
+	}
+
+	int value;
+};
+
+void smallVectorTest() {
+	std::cout << std::endl << "--------------------" << std::endl << "Small Vector Test" << std::endl;
+
+	// Up to the inline capacity nothing is allocated
+	size_t allocations = g_Allocations;
+	{
+		TSmallVector<int, 4> vector;
+		for (int i = 0; i < 3; ++i) {
+			vector.push(i);
+		}
+		vector.push(1, 10);
+		assert(vector.get(1) == 10 && vector.get(3) == 2);
+		vector.pop(static_cast<size_t>(1));
+		assert(vector.isInline() && vector.getSize() == 3 && vector.get(2) == 2);
+	}
+	assert(g_Allocations == allocations);
+
+	// Growing past it spills to the heap once per doubling, and clear keeps the heap memory
+	TSmallVector<int, 4> vector;
+	vector.resize(4, [](const size_t index) { return static_cast<int>(index); });
+	allocations = g_Allocations;
+	vector.push(4);
+	assert(g_Allocations == allocations + 1 && !vector.isInline() && vector.getCapacity() == 8);
+	for (int i = 5; i < 16; ++i) {
+		vector.push(i);
+	}
+	assert(g_Allocations == allocations + 2 && vector.getCapacity() == 16);
+	for (int i = 0; i < 16; ++i) {
+		assert(vector.get(i) == i && vector.data()[i] == i);
+	}
+	vector.clear();
+	vector.resize(16);
+	assert(g_Allocations == allocations + 2 && vector.getSize() == 16 && vector.get(15) == 0);
+
+	// Pushing an element of the vector itself while it grows
+	TSmallVector<std::string, 2> strings{std::string("a"), std::string("b")};
+	strings.push(strings.get(0));
+	assert(strings.getSize() == 3 && strings.get(2) == "a");
+
+	// Moving steals heap memory, but inline elements have to be moved one by one
+	TSmallVector<std::string, 2> moved(std::move(strings));
+	assert(moved.getSize() == 3 && strings.getSize() == 0 && strings.isInline());
+	TSmallVector<std::string, 2> small{std::string("c")};
+	moved = std::move(small);
+	assert(moved.getSize() == 1 && moved.isInline() && moved.get(0) == "c" && small.getSize() == 0);
+	TSmallVector<std::string, 2> copied = moved;
+	copied.pushRange(TVector<std::string>{std::string("d"), std::string("e")});
+	assert(copied.getSize() == 3 && copied.bottom() == "e" && moved.getSize() == 1);
+
+	copied.popRange(0, 2);
+	assert(copied.getSize() == 1 && copied.top() == "e");
+	assert(copied.find(std::string("e")) == 0 && !copied.contains(std::string("c")));
+
+	// Moving inline elements can throw, so moves are only noexcept if moving an element is
+	static_assert(std::is_nothrow_move_constructible_v<TSmallVector<std::string, 2>>);
+	static_assert(!std::is_nothrow_move_constructible_v<TSmallVector<ThrowingMove, 2>>);
+	static_assert(!std::is_nothrow_move_assignable_v<TSmallVector<ThrowingMove, 2>>);
+
+	// A constructor that throws while growing frees the new buffer and leaves the vector as it was
+	TSmallVector<ThrowingConstruct, 2> throwing;
+	throwing.emplace(1);
+	throwing.emplace(2);
+	const size_t allocated = g_Allocations;
+	const size_t freed = g_Deallocations;
+	bool threw = false;
+	try {
+		throwing.emplace(-1);
+	} catch (const std::runtime_error&) {
+		threw = true;
+	}
+	assert(threw && g_Allocations - allocated == g_Deallocations - freed);
+	assert(throwing.isInline() && throwing.getSize() == 2 && throwing.bottom().value == 2);
+	std::cout << "Passed" << std::endl;
+}
+
+void staticVectorTest() {
+	std::cout << std::endl << "--------------------" << std::endl << "Static Vector Test" << std::endl;
+
+	// Elements are only constructed when pushed and destroyed when popped
+	TStaticVector<std::string, 4> strings{std::string("a"), std::string("b"), std::string("c")};
+	strings.push(0, std::string("d"));
+	assert(strings.isFull() && strings.top() == "d" && strings.bottom() == "c");
+	bool threw = false;
+	try {
+		strings.push(std::string("e"));
+	} catch (const std::runtime_error&) {
+		threw = true;
+	}
+	assert(threw && strings.getSize() == 4);
+	strings.popBack();
+	strings.pop(static_cast<size_t>(0));
+	assert(strings.getSize() == 2 && strings.get(0) == "a" && strings.get(1) == "b");
+
+	// Moving moves the elements one by one, leaving the other static vector empty, and is only noexcept if moving an element is
+	static_assert(std::is_nothrow_move_constructible_v<TStaticVector<std::string, 4>>);
+	static_assert(!std::is_nothrow_move_constructible_v<TStaticVector<ThrowingMove, 4>>);
+	TStaticVector<std::string, 4> moved(std::move(strings));
+	assert(moved.getSize() == 2 && strings.getSize() == 0);
+	strings = moved;
+	moved.clear();
+	assert(strings.getSize() == 2 && strings.find(std::string("b")) == 1);
+
+	TStaticVector<int, 16> ints;
+	ints.resize(16, [](const size_t index) { return static_cast<int>(15 - index); });
+	ints.sort();
+	for (int i = 0; i < 16; ++i) {
+		assert(ints.get(i) == i && ints.data()[i] == i);
+	}
+
+	// Arrays fill the lowest free slot, the slot map mode fills the most recently popped one
+	TArray<int, 8> array;
+	TArray<int, 8, true> slotMap;
+	for (int i = 0; i < 8; ++i) {
+		const size_t arraySlot = array.push(i);
+		const size_t slotMapSlot = slotMap.push(i);
+		assert(arraySlot == static_cast<size_t>(i) && slotMapSlot == static_cast<size_t>(i));
+	}
+	array.pop(static_cast<size_t>(2));
+	array.pop(static_cast<size_t>(5));
+	slotMap.pop(static_cast<size_t>(2));
+	slotMap.pop(static_cast<size_t>(5));
+	const size_t arrayFirst = array.push(10);
+	const size_t arraySecond = array.push(11);
+	assert(arrayFirst == 2 && arraySecond == 5);
+	const size_t slotMapFirst = slotMap.push(10);
+	const size_t slotMapSecond = slotMap.push(11);
+	assert(slotMapFirst == 5 && slotMapSecond == 2);
+	threw = false;
+	try {
+		slotMap.push(12);
+	} catch (const std::runtime_error&) {
+		threw = true;
+	}
+	assert(threw);
+
+	// Taking a free slot out of the middle of the stack
+	slotMap.popRange(1, 4);
+	slotMap.emplaceAt(2, 20);
+	const size_t takenFirst = slotMap.push(21);
+	const size_t takenSecond = slotMap.push(22);
+	assert(takenFirst == 3 && takenSecond == 1);
+	slotMap.clear();
+	const size_t clearedFirst = slotMap.push(0);
+	const size_t clearedSecond = slotMap.push(1);
+	assert(clearedFirst == 0 && clearedSecond == 1);
+
+	// Values passed to the constructor populate the first slots
+	TArray<int, 4, true> constructed(1, 2);
+	assert(constructed.contains(static_cast<size_t>(1)) && !constructed.contains(static_cast<size_t>(2)));
+	const size_t constructedSlot = constructed.push(3);
+	assert(constructedSlot == 2);
+	std::cout << "Passed" << std::endl;
+}
+
+void arrayOccupancyTest() {
+	std::cout << std::endl << "--------------------" << std::endl << "Array Occupancy Test" << std::endl;
+
+	// 200 slots span four words, the last only partly
+	TArray<int, 200> array;
+	assert(array.count() == 0);
+	array.emplaceAt(3, 3);
+	array.emplaceAt(64, 64);
+	array.emplaceAt(130, 130);
+	array.emplaceAt(199, 199);
+	assert(array.count() == 4 && array.contains(static_cast<size_t>(64)) && !array.contains(static_cast<size_t>(65)));
+
+	std::vector<size_t> visited;
+	array.forEachPopulated([&](const size_t index, const int& obj) {
+		assert(static_cast<size_t>(obj) == index);
+		visited.push_back(index);
+	});
+	assert((visited == std::vector<size_t>{3, 64, 130, 199}));
+
+	// pop takes the last populated slot, push the first free one
+	array.pop();
+	assert(!array.contains(static_cast<size_t>(199)) && array.count() == 3);
+	const size_t slot = array.push(1);
+	assert(slot == 0);
+	array.fill();
+	assert(array.count() == 200);
+	bool threw = false;
+	try {
+		array.push(1);
+	} catch (const std::runtime_error&) {
+		threw = true;
+	}
+	assert(threw);
+
+	// Popping by value frees every populated slot holding it, fill gave every free slot a 0
+	array.popRange(0, 150);
+	array.pop(0);
+	assert(array.count() == 0);
+	threw = false;
+	try {
+		array.pop();
+	} catch (const std::runtime_error&) {
+		threw = true;
+	}
+	assert(threw && array.count() == 0);
+	std::cout << "Passed" << std::endl;
+}
+
+void allocatorTest() {
+	std::cout << std::endl << "--------------------" << std::endl << "Allocator Test" << std::endl;
+
+	// Once the pool has enough blocks, churn reuses them instead of allocating
+	sstl::pool_resource pool(16);
+	{
+		TList<int, std::pmr::polymorphic_allocator<int>> list(&pool);
+		for (int i = 0; i < 100; ++i) {
+			list.push(i);
+		}
+		const size_t chunks = pool.getChunkCount();
+		const size_t allocations = g_Allocations;
+		for (int i = 0; i < 1000; ++i) {
+			list.pop(static_cast<size_t>(0));
+			list.push(i);
+		}
+		assert(pool.getChunkCount() == chunks && g_Allocations == allocations);
+		assert(list.getSize() == 100 && list.getAllocator().resource() == &pool);
+
+		// Lists on different resources cannot splice, the elements are moved instead
+		TList<int, std::pmr::polymorphic_allocator<int>> other;
+		list.transferRange(other, 0, 10);
+		assert(list.getSize() == 90 && other.getSize() == 10 && other.get(0) == 900);
+		list.pushRange(std::move(other));
+		assert(list.getSize() == 100 && other.getSize() == 0);
+	}
+
+	{
+		using TAllocator = std::pmr::polymorphic_allocator<std::pair<const int, std::string>>;
+		TMap<int, std::string, TAllocator> map(&pool);
+		TMap<int, std::string, TAllocator> other;
+		for (int i = 0; i < 20; ++i) {
+			map.push(i, std::to_string(i));
+			other.push(i + 10, std::to_string(i + 10));
+		}
+		map.merge(other);
+		assert(map.getSize() == 30 && other.getSize() == 10 && map.get(25) == "25" && other.contains(10));
+
+		TPrioritySet<int, std::pmr::polymorphic_allocator<int>> set(&pool);
+		set.push(5);
+		set.push(3);
+		set.push(9);
+		assert(set.top() == 3 && set.bottom() == 9);
+	}
+
+	// The arena only hands memory back when released
+	sstl::arena_resource arena(256);
+	{
+		TPriorityMultiMap<int, int, std::pmr::polymorphic_allocator<std::pair<const int, int>>> map(&arena);
+		for (int i = 0; i < 100; ++i) {
+			map.push(i % 10, i);
+		}
+		assert(map.getSize() == 100 && arena.getChunkCount() > 1);
+	}
+	arena.release();
+	assert(arena.getChunkCount() == 0);
+
+	std::array<std::byte, 1024> buffer;
+	sstl::arena_resource buffered(buffer.data(), buffer.size());
+	{
+		TForwardList<int, std::pmr::polymorphic_allocator<int>> list(&buffered);
+		for (int i = 0; i < 10; ++i) {
+			list.push(i);
+		}
+		assert(buffered.getChunkCount() == 0);
+	}
+	std::cout << "Passed" << std::endl;
+}
+
+void allocatorCoverageTest() {
+	std::cout << std::endl << "--------------------" << std::endl << "Allocator Coverage Test" << std::endl;
+
+	using TIntAllocator = std::pmr::polymorphic_allocator<int>;
+	using TPairAllocator = std::pmr::polymorphic_allocator<std::pair<const int, int>>;
+
+	// Every container with an allocator parameter takes all of its memory from it
+	CountingResource counting;
+	{
+		TDeque<int, TIntAllocator> deque(&counting);
+		TQueue<int, TIntAllocator> queue(&counting);
+		TStack<int, TIntAllocator> stack(&counting);
+		TMaxHeap<int, TIntAllocator> maxHeap(&counting);
+		TMinHeap<int, TIntAllocator> minHeap(&counting);
+		TIndexedMinHeap<int, 4, TIntAllocator> indexedHeap(&counting);
+		TSmallVector<int, 4, TIntAllocator> smallVector(&counting);
+		TFlatSet<int, TIntAllocator> flatSet(&counting);
+		TFlatMap<int, int, TPairAllocator> flatMap(&counting);
+		TBTreeSet<int, TIntAllocator> bTreeSet(&counting);
+		TBTreeMultiSet<int, TIntAllocator> bTreeMultiSet(&counting);
+		TBTreeMap<int, int, TPairAllocator> bTreeMap(&counting);
+		TBTreeMultiMap<int, int, TPairAllocator> bTreeMultiMap(&counting);
+		TConcurrentSet<int, 4, TIntAllocator> concurrentSet(&counting);
+		TConcurrentMap<int, int, 4, std::pmr::polymorphic_allocator<std::pair<int, int>>> concurrentMap(&counting);
+
+		const size_t allocations = g_Allocations;
+		for (int i = 0; i < 200; ++i) {
+			deque.push(i);
+			queue.push(i);
+			stack.push(i);
+			maxHeap.push(i);
+			minHeap.push(i);
+			indexedHeap.push(i);
+			smallVector.push(i);
+			flatSet.push(i);
+			flatMap.push(i, i);
+			bTreeSet.push(i);
+			bTreeMultiSet.push(i % 10);
+			bTreeMap.push(i, i);
+			bTreeMultiMap.push(i % 10, i);
+			concurrentSet.push(i);
+			concurrentMap.push(i, i);
+		}
+		for (int i = 0; i < 100; ++i) {
+			deque.pop();
+			indexedHeap.pop();
+			flatSet.pop(i);
+			bTreeMap.pop(i);
+		}
+		assert(g_Allocations == allocations && counting.allocations > 0);
+		assert(indexedHeap.top() == 100 && maxHeap.top() == 199 && bTreeMultiSet.getSize() == 200 && concurrentMap.get(150) == 150);
+		assert(smallVector.getAllocator().resource() == &counting && flatMap.getAllocator().resource() == &counting);
+		assert(bTreeMultiMap.getAllocator().resource() == &counting && concurrentSet.getAllocator().resource() == &counting);
+	}
+	assert(counting.outstanding == 0);
+
+	// Storage from another resource cannot be taken over on move assignment, the elements are moved instead
+	CountingResource other;
+	{
+		TSmallVector<int, 4, TIntAllocator> smallVector(&counting);
+		TSmallVector<int, 4, TIntAllocator> otherSmallVector(&other);
+		TFlatMap<int, int, TPairAllocator> flatMap(&counting);
+		TFlatMap<int, int, TPairAllocator> otherFlatMap(&other);
+		TBTreeMap<int, int, TPairAllocator> bTreeMap(&counting);
+		TBTreeMap<int, int, TPairAllocator> otherBTreeMap(&other);
+		for (int i = 0; i < 100; ++i) {
+			smallVector.push(i);
+			flatMap.push(i, i);
+			bTreeMap.push(i, i);
+		}
+		otherSmallVector = std::move(smallVector);
+		otherFlatMap = std::move(flatMap);
+		otherBTreeMap = std::move(bTreeMap);
+		assert(otherSmallVector.getSize() == 100 && otherSmallVector.get(99) == 99 && smallVector.getSize() == 0);
+		assert(otherFlatMap.getSize() == 100 && otherFlatMap.get(99) == 99 && flatMap.getSize() == 0);
+		assert(otherBTreeMap.getSize() == 100 && otherBTreeMap.get(99) == 99 && bTreeMap.getSize() == 0);
+		assert(otherFlatMap.getAllocator().resource() == &other && otherBTreeMap.getAllocator().resource() == &other);
+
+		// The same resource hands its storage over without allocating
+		TFlatMap<int, int, TPairAllocator> sameFlatMap(&other);
+		const size_t allocations = other.allocations;
+		sameFlatMap = std::move(otherFlatMap);
+		assert(other.allocations == allocations && sameFlatMap.getSize() == 100);
+	}
+	assert(counting.outstanding == 0 && other.outstanding == 0);
+	std::cout << "Passed" << std::endl;
+}
+
+void frameArenaTest() {
+	std::cout << std::endl << "--------------------" << std::endl << "Frame Arena Test" << std::endl;
+
+	using TPairAllocator = std::pmr::polymorphic_allocator<std::pair<const int, int>>;
+	sstl::arena_resource arena(1024);
+	size_t capacity = 0;
+	for (int frame = 0; frame < 5; ++frame) {
+		{
+			TVector<int, std::pmr::polymorphic_allocator<int>> vector(&arena);
+			TMap<int, int, TPairAllocator> map(&arena);
+			for (int i = 0; i < 500; ++i) {
+				vector.push(i + frame);
+				map.push(i, i + frame);
+			}
+			assert(vector.get(499) == 499 + frame && map.get(10) == 10 + frame);
+			assert(vector.getAllocator().resource() == &arena);
+		}
+		arena.reset();
+
+		// The first frame spreads over several chunks, reset merges them so every later frame fits in one
+		if (frame == 1) {
+			capacity = arena.getCapacity();
+		} else if (frame > 1) {
+			assert(arena.getCapacity() == capacity);
+		}
+	}
+
+	// Memory handed out before a reset is poisoned
+	unsigned char* raw = static_cast<unsigned char*>(arena.allocate(16));
+	raw[0] = 1;
+	arena.reset();
+#if defined(SIMPLESTL_ASAN)
+	assert(__asan_address_is_poisoned(raw));
+#else
+	assert(raw[0] == 0xDD);
+#endif
+
+	arena.release();
+	assert(arena.getCapacity() == 0 && arena.getChunkCount() == 0);
+	std::cout << "Passed" << std::endl;
+}
+
+struct PooledHooks {
+	PooledHooks(const int id): id(id) {}
+	~PooledHooks() { ++destructed; }
+
+	void init() { ++inits; }
+	void destroy() { ++destroys; }
+
+	int id;
+	static inline int inits = 0;
+	static inline int destroys = 0;
+	static inline int destructed = 0;
+};
+
+void objectPoolTest() {
+	std::cout << std::endl << "--------------------" << std::endl << "Object Pool Test" << std::endl;
+
+	sstl::object_pool<PooledHooks> pool(4);
+	{
+		TVector<TUnique<PooledHooks>> objects;
+		for (int i = 0; i < 6; ++i) {
+			objects.push(TUnique<PooledHooks>::createIn(pool, i));
+		}
+		assert(objects.get(5)->id == 5);
+		assert(pool.getStats().live == 6 && pool.getStats().chunks == 2 && pool.getStats().capacity == 8);
+		if constexpr (sstl::is_initializable_v<PooledHooks>) {
+			assert(PooledHooks::inits == 6);
+		}
+	}
+	assert(PooledHooks::destructed == 6 && pool.getStats().live == 0 && pool.getStats().destroyed == 6);
+	if constexpr (sstl::is_destroyable_v<PooledHooks>) {
+		assert(PooledHooks::destroys == 6);
+	}
+
+	// Slots are reused once the pool is warm, so churn never reaches operator new
+	size_t allocations = g_Allocations;
+	for (int i = 0; i < 100; ++i) {
+		TUnique<PooledHooks> first = TUnique<PooledHooks>::createIn(pool, i);
+		TUnique<PooledHooks> second = TUnique<PooledHooks>::createIn(pool, i + 1);
+		assert(first->id + 1 == second->id && first.get() != second.get());
+	}
+	assert(g_Allocations == allocations);
+	assert(pool.getStats().created == 206 && pool.getStats().peak == 6 && pool.getStats().chunks == 2);
+
+	// A pool of a derived type can back a pointer to its base
+	sstl::object_pool<SObject> objects;
+	{
+		TUnique<Parent> parent = TUnique<Parent>::createIn(objects, 3, "Pooled");
+		assert(parent->id == 3 && parent.staticCast<SObject>()->name == "Pooled");
+		assert(objects.getStats().live == 1);
+	}
+	assert(objects.getStats().live == 0);
+
+	TUnique<PooledHooks> held = TUnique<PooledHooks>::createIn(pool, 0);
+	bool threw = false;
+	try {
+		pool.release();
+	} catch (const std::runtime_error&) {
+		threw = true;
+	}
+	assert(threw);
+	held = nullptr;
+	pool.release();
+	assert(pool.getStats().capacity == 0 && pool.getStats().chunks == 0);
+	std::cout << "Passed" << std::endl;
+}
+
+struct SelfReleasing {
+	void release() { ++released; delete this; }
+
+	static inline int released = 0;
+};
+
+void sharedAllocationTest() {
+	std::cout << std::endl << "--------------------" << std::endl << "Shared Allocation Test" << std::endl;
+
+	// The object and its reference counts come from one allocation
+	size_t allocations = g_Allocations;
+	{
+		TShared<SObject> object(1, "Shared");
+		assert(g_Allocations == allocations + 1);
+		TShared<SObject> copy = object;
+		assert(copy->name == "Shared" && object.count() == 2 && g_Allocations == allocations + 1);
+	}
+
+	const int inits = PooledHooks::inits;
+	const int destroys = PooledHooks::destroys;
+	const int destructed = PooledHooks::destructed;
+	TWeak<PooledHooks> weak;
+	{
+		TShared<PooledHooks> hooked(7);
+		weak = hooked;
+		assert(hooked->id == 7);
+		if constexpr (sstl::is_initializable_v<PooledHooks>) {
+			assert(PooledHooks::inits == inits + 1);
+		}
+	}
+	// The destroy() hook and destructor run when the last owner goes, even though a weak pointer still keeps the allocation
+	assert(!weak && PooledHooks::destructed == destructed + 1);
+	if constexpr (sstl::is_destroyable_v<PooledHooks>) {
+		assert(PooledHooks::destroys == destroys + 1);
+	}
+
+	// Types that release themselves still get their own allocation, so release() can free it
+	allocations = g_Allocations;
+	{
+		TShared<SelfReleasing> releasing{};
+		if constexpr (sstl::is_releasable_v<SelfReleasing>) {
+			assert(g_Allocations == allocations + 2);
+		}
+	}
+	if constexpr (sstl::is_releasable_v<SelfReleasing>) {
+		assert(SelfReleasing::released == 1);
+	}
+	std::cout << "Passed" << std::endl;
+}
+
+struct Counted : TRefCounted<> {
+	Counted(const int id): id(id) {}
+	virtual ~Counted() { ++destructed; }
+
+	int id;
+	static inline int destructed = 0;
+};
+
+struct CountedChild : Counted {
+	using Counted::Counted;
+};
+
+struct LocalCounted : TRefCounted<false> {
+	int id = 0;
+};
+
+void intrusiveTest() {
+	std::cout << std::endl << "--------------------" << std::endl << "Intrusive Test" << std::endl;
+
+	static_assert(sizeof(TIntrusive<Counted>) == sizeof(Counted*), "TIntrusive should be a single pointer");
+	static_assert(sstl::is_managed_v<TIntrusive<Counted>>, "TIntrusive should be managed");
+
+	{
+		TIntrusive<Counted> first(1);
+		assert(first.count() == 1 && first->id == 1);
+		TIntrusive<Counted> copy = first;
+		// A raw pointer joins the count already in the object
+		TIntrusive<Counted> fromRaw(first.get());
+		assert(first.count() == 3 && copy == fromRaw);
+		copy = nullptr;
+		fromRaw.destroy();
+		assert(first.count() == 1 && Counted::destructed == 0);
+
+		TIntrusive<CountedChild> child(2);
+		TIntrusive<Counted> parent = child;
+		assert(parent.count() == 2 && parent.dynamicCast<CountedChild>() == child);
+		first = std::move(parent);
+		assert(child.count() == 2 && Counted::destructed == 1);
+
+		// Converting from a derived type needs a virtual destructor in the base, every converting constructor and move assignment
+		// static_asserts it, so TIntrusive<Base> b; b = TIntrusive<Derived>(...); does not compile when ~Base is not virtual
+		TIntrusive<Counted> moved(4);
+		moved = TIntrusive<CountedChild>(5);
+		assert(moved->id == 5 && moved.count() == 1 && Counted::destructed == 2);
+	}
+	assert(Counted::destructed == 4);
+
+	TIntrusive<Counted> held = nullptr;
+	{
+		TVector<TIntrusive<Counted>> vector;
+		for (int i = 0; i < 5; ++i) {
+			vector.push(TUnfurled<TIntrusive<Counted>>::create<CountedChild>(i));
+		}
+		Counted* third = vector.get(2).get();
+		held = TIntrusive<Counted>(third);
+		assert(vector.contains(third) && vector.find(third) == 2 && sstl::getUnfurled(vector.get(2)) == third);
+		vector.pop(third);
+		assert(!vector.contains(third) && vector.getSize() == 4 && held.count() == 1 && held->id == 2);
+
+		TSet<TIntrusive<Counted>> set;
+		set.push(held);
+		assert(set.contains(third) && held.count() == 2);
+
+		TFrail<Counted> frail = held;
+		assert(frail.get() == third);
+	}
+	assert(Counted::destructed == 8 && held.count() == 1);
+
+	TIntrusive<LocalCounted> local;
+	TIntrusive<LocalCounted> localCopy = local;
+	assert(local && local.count() == 2);
+
+	// Atomic counts stay exact while several threads copy the same object
+	std::vector<std::thread> threads;
+	for (int t = 0; t < 4; ++t) {
+		threads.emplace_back([&held] {
+			for (int i = 0; i < 10000; ++i) {
+				TIntrusive<Counted> copy = held;
+			}
+		});
+	}
+	for (std::thread& thread : threads) {
+		thread.join();
+	}
+	assert(held.count() == 1);
+	held = nullptr;
+	assert(Counted::destructed == 9);
+	std::cout << "Passed" << std::endl;
+}
 
 int main() {
+	heapPopTest();
+	transferRangeTest();
+	indexedHeapTest();
+	flatHashTest();
+	bTreeTest();
+	concurrentHashTest();
+	threadSafeTest<std::recursive_mutex>("TThreadSafe<std::recursive_mutex>");
+	threadSafeTest<std::mutex>("TThreadSafe<std::mutex>");
+	threadSafeTest<std::shared_mutex>("TThreadSafe<std::shared_mutex>");
+	threadSafeTest<sstl::spin_lock>("TThreadSafe<sstl::spin_lock>");
+	threadSafeTest<sstl::seq_lock>("TThreadSafe<sstl::seq_lock>");
+	concurrentQueueTest();
+	ringBufferTest();
+	workStealingTest();
+	parallelTest();
+	bulkBuildTest();
+	sortTest();
+	smallVectorTest();
+	staticVectorTest();
+	arrayOccupancyTest();
+	allocatorTest();
+	allocatorCoverageTest();
+	frameArenaTest();
+	objectPoolTest();
+	sharedAllocationTest();
+	intrusiveTest();
 	DO_TEST(TVector)
+	DO_TEST(TSmallVector)
 	DO_TEST(TMaxHeap)
 	DO_TEST(TMinHeap)
+	DO_TEST(TIndexedMaxHeap)
+	DO_TEST(TIndexedMinHeap)
 	DO_TEST(TDeque)
 	DO_TEST(TList)
 	DO_TEST(TForwardList)
 	DO_ARRAY_TEST(TArray)
+	DO_ARRAY_TEST(TStaticVector)
 	DO_TEST(TStack)
 	DO_TEST(TQueue)
 	DO_ASSOCIATIVE_TEST(TSet)
 	DO_ASSOCIATIVE_TEST(TMultiSet)
+	DO_ASSOCIATIVE_TEST(TFlatSet)
 	DO_ASSOCIATIVE_TEST(TPrioritySet)
 	DO_ASSOCIATIVE_TEST(TPriorityMultiSet)
+	DO_ASSOCIATIVE_TEST(TBTreeSet)
+	DO_ASSOCIATIVE_TEST(TBTreeMultiSet)
 	DO_MAP_TEST(TMap)
 	DO_MAP_TEST(TMultiMap)
+	DO_MAP_TEST(TFlatMap)
 	DO_MAP_TEST(TPriorityMap)
 	DO_MAP_TEST(TPriorityMultiMap)
+	DO_MAP_TEST(TBTreeMap)
+	DO_MAP_TEST(TBTreeMultiMap)
 	return 0;
 }
\ No newline at end of file